@@ -71,6 +71,8 @@ function getSmsCount(value) {
 	return _('%d (%d sms)').format(capacity, parts);
 }
 
+let SMS_PAGE_SIZE = 50;
+
 return view.extend({
 	load() {
 		return usbmodem.api.getInterfaces();
@@ -197,6 +199,31 @@ return view.extend({
 			])
 		]);
 	},
+	renderMoreButton(table, cursor) {
+		return E('div', { 'class': 'controls', 'style': 'margin: 18px 0 0 0' }, [
+			E('button', {
+				'class': 'btn cbi-button-neutral',
+				'click': ui.createHandlerFn(this, 'loadMoreSms', table, cursor)
+			}, [ _('Load more') ])
+		]);
+	},
+	loadMoreSms(table, cursor, event) {
+		let button = event.target.parentNode;
+		
+		return usbmodem.api.call(this.iface, 'readSms', {type: this.dir, limit: SMS_PAGE_SIZE, cursor: cursor}).then((result) => {
+			result.messages.forEach((msg) => {
+				table.appendChild(this.renderSms(msg));
+			});
+			
+			if (result.next) {
+				button.replaceWith(this.renderMoreButton(table, result.next));
+			} else {
+				button.remove();
+			}
+		}).catch((err) => {
+			ui.addNotification(null, E('p', [ err.message ]), 'danger');
+		});
+	},
 	loadSmsList() {
 		let sms_list = document.querySelector(`#usbmodem-sms-${this.iface}`);
 		
@@ -206,7 +233,7 @@ return view.extend({
 			'draft':	_('Drafts (%d)'),
 		};
 		
-		return usbmodem.api.call(this.iface, 'readSms', {type: this.dir}).then((result) => {
+		return usbmodem.api.call(this.iface, 'readSms', {type: this.dir, limit: SMS_PAGE_SIZE}).then((result) => {
 			sms_list.innerHTML = '';
 			
 			// Capacity info
@@ -283,6 +310,9 @@ return view.extend({
 					table.appendChild(this.renderSms(msg));
 				});
 				sms_list.appendChild(table);
+				
+				if (result.next)
+					sms_list.appendChild(this.renderMoreButton(table, result.next));
 			} else {
 				sms_list.appendChild(E('p', {}, _('No messages.')));
 			}
@@ -101,7 +101,7 @@ install_file $DIR/luci-app-usbmodem/root/usr/share/luci/menu.d/luci-app-usbmodem
 
 install_file $DIR/usbmodem/files/usbmodem.sh												/lib/netifd/proto/usbmodem.sh
 install_file $DIR/usbmodem/files/usbmodem.user												/etc/usbmodem.sh
-install_file $DIR/usbmodem/files/usbmodem.usb												/etc/hotplug.d/tty/30-usbmodem
+install_file $DIR/usbmodem/files/usbmodem.init												/etc/init.d/usbmodem
 
 ssh $TEST_ROUTER killall -9 usbmodem
 install_file $TOPDIR/build_dir/$TARGET/usbmodem/ipkg-install/usr/sbin/usbmodem				/usr/sbin/usbmodem
@@ -0,0 +1,79 @@
+#include "Bench.h"
+
+#include <thread>
+#include <atomic>
+
+#include <Core/AtChannel.h>
+#include <Core/Semaphore.h>
+#include <Core/Serial.h>
+
+#include "../sim/Simulator.h"
+
+static constexpr size_t COMMANDS_COUNT = 100;
+static constexpr size_t URC_COUNT = 1000;
+
+void benchAtChannel(Bench *bench) {
+	if (!bench->enabled("AtChannel/"))
+		return;
+	
+	std::vector<std::string> urc_lines(URC_COUNT, "+CREG: 2,1,\"1A2B\",\"0C3D4E5\",7");
+	
+	json scenario = {
+		{"default", {{"status", "OK"}}},
+		{"commands", {
+			{{"match", "AT+CSQ"}, {"response", "+CSQ: 21,99"}},
+			{{"match", "AT+CREG=URC"}, {"urc", {{{"lines", urc_lines}}}}},
+		}},
+	};
+	
+	Simulator sim;
+	if (!sim.loadScenario(scenario) || !sim.open()) {
+		LOGE("Can't start modem simulator\n");
+		return;
+	}
+	
+	std::thread sim_thread([&sim]() {
+		sim.run();
+	});
+	
+	Serial serial;
+	AtChannel at;
+	
+	if (serial.open(sim.getDevice(), 115200) == Serial::ERR_SUCCESS) {
+		at.setSerial(&serial);
+		at.start();
+		
+		// Command -> pty -> simulator -> pty -> response, the same path as with real modem
+		bench->measure("AtChannel/roundtrip", COMMANDS_COUNT, [&]() {
+			for (size_t i = 0; i < COMMANDS_COUNT; i++)
+				doNotOptimize(at.sendCommand("AT+CSQ", "+CSQ").error);
+		});
+		
+		bench->measure("AtChannel/noResponse", COMMANDS_COUNT, [&]() {
+			for (size_t i = 0; i < COMMANDS_COUNT; i++)
+				doNotOptimize(at.sendCommandNoResponse("AT"));
+		});
+		
+		std::atomic<size_t> received = 0;
+		Semaphore done;
+		
+		at.onUnsolicited("+CREG", [&](std::string_view event) {
+			if (++received == URC_COUNT)
+				done.post();
+		});
+		
+		// Burst of URC just after command response
+		bench->measure("AtChannel/urcBurst", URC_COUNT, [&]() {
+			received = 0;
+			at.sendCommandNoResponse("AT+CREG=URC");
+			done.wait(10000);
+		});
+		
+		at.stop();
+	} else {
+		LOGE("Can't open %s\n", sim.getDevice().c_str());
+	}
+	
+	sim.stop();
+	sim_thread.join();
+}
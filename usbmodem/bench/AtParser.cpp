@@ -0,0 +1,82 @@
+#include "Bench.h"
+
+#include <Core/Log.h>
+#include <Core/AtParser.h>
+
+static constexpr size_t LINES_PER_ITERATION = 10000;
+
+static bool parseCreg(const std::string &line) {
+	int stat = 0, tech = 0;
+	uint32_t loc_id = 0, cell_id = 0;
+	
+	if (AtParser::getArgCnt(line) != 4)
+		return false;
+	
+	return AtParser(line)
+		.parseInt(&stat)
+		.parseUInt(&loc_id, 16)
+		.parseUInt(&cell_id, 16)
+		.parseInt(&tech)
+		.success();
+}
+
+static bool parseCesq(const std::string &line) {
+	int rssi, ber, rscp, ecio, rsrq, rsrp;
+	return AtParser(line)
+		.parseInt(&rssi)
+		.parseInt(&ber)
+		.parseInt(&rscp)
+		.parseInt(&ecio)
+		.parseInt(&rsrq)
+		.parseInt(&rsrp)
+		.success();
+}
+
+static bool parseEemLteSvc(const std::string &line) {
+	struct {
+		int32_t rsrp, rsrq, main_rsrp, div_rsrp, main_rsrq, div_rsrq;
+	} f;
+	
+	using F = decltype(f);
+	static constexpr auto fields = AtParser::schema(
+		AtParser::Skip<11>(),
+		&F::rsrp,
+		&F::rsrq,
+		AtParser::Skip<>(),
+		&F::main_rsrp,
+		&F::div_rsrp,
+		&F::main_rsrq,
+		&F::div_rsrq
+	);
+	
+	AtParser parser(line);
+	return parser.parseSchema(&f, fields).success();
+}
+
+template <typename F>
+static void benchLine(Bench *bench, const std::string &name, const std::string &line, F parser) {
+	if (!bench->enabled(name))
+		return;
+	
+	if (!parser(line)) {
+		LOGE("%s: can't parse '%s'\n", name.c_str(), line.c_str());
+		return;
+	}
+	
+	bench->measure(name, LINES_PER_ITERATION, [&]() {
+		for (size_t i = 0; i < LINES_PER_ITERATION; i++)
+			doNotOptimize(parser(line));
+	});
+}
+
+void benchAtParser(Bench *bench) {
+	benchLine(bench, "AtParser/CREG", "+CREG: 1,\"1A2B\",\"0012ABCD\",7", parseCreg);
+	benchLine(bench, "AtParser/CESQ", "+CESQ: 99,99,255,255,20,45", parseCesq);
+	benchLine(bench, "AtParser/EEMLTESVC",
+		"+EEMLTESVC: 250, 2, 1, 1300, 1300, 3, 5, 20252, 1275425, 20, 102, 46, 14, 0, 47, 45, 15, 13, 0, 0, 24, 0, 0, 0, 0, 21, 0, 0, 0, 0, 0, 1",
+		parseEemLteSvc);
+	
+	benchLine(bench, "AtParser/getArgCnt", "+EEMLTESVC: 250, 2, 1, 1300, 1300, 3, 5, 20252, 1275425, 20, 102, 46, 14, 0, 47, 45, 15, 13", [](const std::string &line) {
+		return AtParser::getArgCnt(line) > 0;
+	});
+}
@@ -0,0 +1,67 @@
+#include "Bench.h"
+
+#include <ctime>
+#include <algorithm>
+
+#include <Core/Log.h>
+
+bool Bench::enabled(const std::string &name) const {
+	return !m_filter.size() || name.find(m_filter) != std::string::npos;
+}
+
+void Bench::run(const std::string &name, size_t ops, const Iteration &iteration) {
+	if (!enabled(name))
+		return;
+	
+	// Warmup
+	iteration();
+	
+	std::vector<int64_t> samples;
+	int64_t total = 0;
+	int64_t min_time = static_cast<int64_t>(m_min_time) * 1000000;
+	
+	while (samples.size() < m_max_iterations && (samples.size() < m_min_iterations || total < min_time)) {
+		int64_t elapsed = iteration();
+		samples.push_back(elapsed);
+		total += elapsed;
+	}
+	
+	std::sort(samples.begin(), samples.end());
+	
+	Result result;
+	result.name = name;
+	result.ops = ops;
+	result.iterations = samples.size();
+	result.min_ns = static_cast<double>(samples[0]) / ops;
+	result.median_ns = static_cast<double>(samples[samples.size() / 2]) / ops;
+	result.mean_ns = static_cast<double>(total) / samples.size() / ops;
+	m_results.push_back(result);
+	
+	LOGD("%-40s %12.1f ns/op (min %.1f, %zu iterations)\n", name.c_str(), result.median_ns, result.min_ns, result.iterations);
+}
+
+json Bench::toJson() const {
+	json benchmarks = json::array();
+	for (auto &result: m_results) {
+		benchmarks.push_back({
+			{"name", result.name},
+			{"ops", result.ops},
+			{"iterations", result.iterations},
+			{"ns_per_op", {
+				{"min", result.min_ns},
+				{"median", result.median_ns},
+				{"mean", result.mean_ns},
+			}},
+			{"ops_per_sec", result.median_ns > 0 ? 1000000000.0 / result.median_ns : 0},
+		});
+	}
+	
+	return {
+		{"context", {
+			{"time", time(nullptr)},
+			{"compiler", __VERSION__},
+			{"min_time_ms", m_min_time},
+		}},
+		{"benchmarks", benchmarks}
+	};
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+
+#include <Core/Json.h>
+
+class Bench {
+	public:
+		struct Result {
+			std::string name;
+			size_t ops = 0;				// operations per iteration
+			size_t iterations = 0;
+			double min_ns = 0;			// per operation
+			double median_ns = 0;		// per operation
+			double mean_ns = 0;			// per operation
+		};
+		
+		// Runs one iteration, returns measured time in nanoseconds
+		typedef std::function<int64_t()> Iteration;
+	protected:
+		std::vector<Result> m_results;
+		std::string m_filter;
+		int m_min_time = 500;
+		int m_min_iterations = 5;
+		int m_max_iterations = 1000000;
+	public:
+		inline void setFilter(const std::string &filter) {
+			m_filter = filter;
+		}
+		
+		inline void setMinTime(int min_time) {
+			m_min_time = min_time;
+		}
+		
+		static inline int64_t now() {
+			auto time = std::chrono::steady_clock::now().time_since_epoch();
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(time).count();
+		}
+		
+		bool enabled(const std::string &name) const;
+		
+		// Iteration measures itself, so it can exclude setup
+		void run(const std::string &name, size_t ops, const Iteration &iteration);
+		
+		// Whole iteration is measured
+		template <typename F>
+		inline void measure(const std::string &name, size_t ops, F callback) {
+			run(name, ops, [&callback]() {
+				int64_t start = now();
+				callback();
+				return now() - start;
+			});
+		}
+		
+		json toJson() const;
+};
+
+// Prevent compiler from removing benchmarked code
+template <typename T>
+static inline void doNotOptimize(const T &value) {
+	asm volatile("" : : "r,m"(value) : "memory");
+}
+
+std::vector<std::string> getDefaultPduCorpus();
+
+void benchAtParser(Bench *bench);
+void benchGsmUtils(Bench *bench, const std::vector<std::string> &corpus);
+void benchSmsDb(Bench *bench, const std::vector<std::string> &corpus);
+void benchLoop(Bench *bench);
+void benchAtChannel(Bench *bench);
@@ -0,0 +1,112 @@
+#include "Bench.h"
+
+#include <Core/Log.h>
+#include <Core/Utils.h>
+#include <Core/GsmUtils.h>
+
+static constexpr size_t CORPUS_REPEAT = 100;
+
+std::vector<std::string> getDefaultPduCorpus() {
+	return {
+		// 7bit
+		"07919761989999F8040B919761214365F70000421021815300210CC8F71D14969741F977FD07",
+		"07919761989999F8040B919761214365F70000421021815300218EC8329BFD0E81B2EFBA1C240EB3C3EE7119949E8362B2998B560315AB52"
+		"1788FA8683EA7050980E0ABBF3A039FD2D2F83DE72D0DBCD4EBBCB20FA1BB42E97E1A0FCBB2E07CDCB727B7A5C9E83C2637ADA5E7681A8E8"
+		"B07B0DCABFEB20F35B0E9AD3C3F9B4FB0CBAA7E968507DCE02A1C3F632280C72A7C76510399C0F01",
+		
+		// UCS-2
+		"07919761989999F8040B919761214365F70008421021815300216E0412043004480020043A043E04340020043F043E04340442043204350440"
+		"043604340435043D0438044F003A0020003400380032003900310033002E0020041D0438043A043E043C0443002004350433043E0020043D"
+		"043500200441043E043E043104490430043904420435002E",
+		
+		// 7bit, multipart
+		"07919761989999F8440B919761214365F700004210218153002164050003420201A061391DF47697416F33280C62BFDD6750BB3C9F87CF65"
+		"101D1DA683EEE139680E67A7E920711E44479741EE32FDFE96AF416937FD0D9A97ED6579980D82A7CBE3F21C647ECB41E4323B6D2FCBF320"
+		"FA1B04",
+		"07919761989999F8440B919761214365F700004210218153002140050003420202E8E832081D7693E7653A0B1476934174747A0E4ACF4174"
+		"7419342F8FDF6E3228EC2683CC6977980D8287E574D0DB0C4AD35D",
+		
+		// UCS-2, multipart, with surrogate pair
+		"07919761989999F8440B919761214365F700084210218153002164050003170201041F0440043804320435044200210020042D0442043E00"
+		"20043F0435044004320430044F00200447043004410442044C00200434043B0438043D043D043E0433043E00200441043E043E0431044904"
+		"35043D0438044F0020D83DDE000020",
+		"07919761989999F8440B919761214365F70008421021815300212C05000317020204300020044D0442043E002004320442043E0440043004"
+		"4F00200447043004410442044C002E",
+		
+		// 8bit
+		"07919761989999F8040B919761214365F700044210218153002120000102030405060708090A0B0C0D0E0F101112131415161718191A1B1C"
+		"1D1E1F",
+	};
+}
+
+void benchGsmUtils(Bench *bench, const std::vector<std::string> &corpus) {
+	std::vector<std::string> raw_corpus;
+	std::vector<Pdu> pdus;
+	
+	for (auto &hex: corpus) {
+		Pdu pdu = {};
+		auto raw = hex2bin(hex);
+		if (!decodePdu(raw, &pdu, false)) {
+			LOGE("Invalid PDU in corpus: %s\n", hex.c_str());
+			continue;
+		}
+		raw_corpus.push_back(raw);
+		pdus.push_back(pdu);
+	}
+	
+	if (!pdus.size())
+		return;
+	
+	size_t ops = pdus.size() * CORPUS_REPEAT;
+	
+	bench->measure("Pdu/hex2bin", ops, [&]() {
+		for (size_t i = 0; i < CORPUS_REPEAT; i++) {
+			for (auto &hex: corpus)
+				doNotOptimize(hex2bin(hex));
+		}
+	});
+	
+	bench->measure("Pdu/decodePdu", ops, [&]() {
+		for (size_t i = 0; i < CORPUS_REPEAT; i++) {
+			for (auto &raw: raw_corpus) {
+				Pdu pdu = {};
+				doNotOptimize(decodePdu(raw, &pdu, false));
+			}
+		}
+	});
+	
+	bench->measure("Pdu/decodeSmsDcsData", ops, [&]() {
+		for (size_t i = 0; i < CORPUS_REPEAT; i++) {
+			for (auto &pdu: pdus) {
+				PduUserDataHeader hdr = {};
+				doNotOptimize(decodeSmsDcsData(&pdu, &hdr));
+			}
+		}
+	});
+	
+	// Full path of the incoming SMS: hex -> PDU -> text
+	bench->measure("Pdu/decodeHexToText", ops, [&]() {
+		for (size_t i = 0; i < CORPUS_REPEAT; i++) {
+			for (auto &hex: corpus) {
+				Pdu pdu = {};
+				PduUserDataHeader hdr = {};
+				if (decodePdu(hex2bin(hex), &pdu, false))
+					doNotOptimize(decodeSmsDcsData(&pdu, &hdr));
+			}
+		}
+	});
+	
+	// USSD response in 7bit: hex -> septets -> UTF-8
+	std::string ussd = bin2hex(pack7bit("Your balance is 123.45 USD. Bonus: 50 min, 1024 MB until 31.12. Reply 1 for menu, 2 for tariffs."), true);
+	size_t ussd_ops = CORPUS_REPEAT * 100;
+	
+	bench->measure("Ussd/hex2bin+decodeCbsDcsString", ussd_ops, [&]() {
+		for (size_t i = 0; i < ussd_ops; i++)
+			doNotOptimize(decodeCbsDcsString(hex2bin(ussd), 15));
+	});
+	
+	bench->measure("Ussd/decodeCbsDcsHexString", ussd_ops, [&]() {
+		for (size_t i = 0; i < ussd_ops; i++)
+			doNotOptimize(decodeCbsDcsHexString(ussd, 15));
+	});
+}
@@ -0,0 +1,145 @@
+#include "Bench.h"
+
+#include <thread>
+#include <random>
+
+#include <Core/Loop.h>
+#include <Core/Events.h>
+#include <Core/Semaphore.h>
+
+static const std::vector<size_t> TIMER_COUNTS = {100, 1000, 10000};
+static constexpr size_t TASKS_COUNT = 10000;
+static constexpr size_t EVENTS_COUNT = 10000;
+
+// Loop without poll(), runs timers and tasks until stop
+class BenchLoop: public LoopBase {
+	protected:
+		const char *name() override {
+			return "BenchLoop";
+		}
+		
+		void implInit() override { }
+		void implSetNextTimeout(int64_t time) override { }
+		
+		void implRun() override {
+			while (!m_need_stop)
+				runTimeouts();
+		}
+		
+		void implRequestStop() override { }
+		void implStop() override { }
+		void implDestroy() override { }
+	public:
+		~BenchLoop() {
+			destroy();
+		}
+};
+
+struct BenchEvent {
+	size_t id;
+};
+
+static void benchTimers(Bench *bench) {
+	std::mt19937 rnd(42);
+	
+	for (auto count: TIMER_COUNTS) {
+		std::vector<int> timeouts(count);
+		std::vector<size_t> order(count);
+		for (size_t i = 0; i < count; i++) {
+			timeouts[i] = 1000 + rnd() % 60000;
+			order[i] = i;
+		}
+		std::shuffle(order.begin(), order.end(), rnd);
+		
+		// Typical churn: command timeouts are added and cancelled before firing
+		bench->run("Loop/timerAddRemove/" + std::to_string(count), count, [&]() {
+			BenchLoop loop;
+			loop.init();
+			
+			std::vector<int64_t> ids(count);
+			
+			int64_t start = Bench::now();
+			for (size_t i = 0; i < count; i++)
+				ids[i] = loop.addTimer([]() { }, timeouts[i], false);
+			for (auto i: order)
+				loop.removeTimer(ids[i]);
+			return Bench::now() - start;
+		});
+		
+		bench->run("Loop/timerFire/" + std::to_string(count), count, [&]() {
+			BenchLoop loop;
+			loop.init();
+			
+			size_t fired = 0;
+			
+			int64_t start = Bench::now();
+			for (size_t i = 0; i < count; i++) {
+				loop.addTimer([&]() {
+					if (++fired == count)
+						loop.stop();
+				}, 0, false);
+			}
+			loop.run();
+			return Bench::now() - start;
+		});
+	}
+}
+
+static void benchTasks(Bench *bench) {
+	bench->run("Loop/postTask", TASKS_COUNT, [&]() {
+		BenchLoop loop;
+		loop.init();
+		
+		size_t done = 0;
+		
+		int64_t start = Bench::now();
+		for (size_t i = 0; i < TASKS_COUNT; i++) {
+			loop.postTask([&]() {
+				if (++done == TASKS_COUNT)
+					loop.stop();
+			});
+		}
+		loop.run();
+		return Bench::now() - start;
+	});
+}
+
+// Events are emitted from other thread (like AT channel) and delivered on Loop thread
+static void benchEvents(Bench *bench) {
+	if (!bench->enabled("Events/emit"))
+		return;
+	
+	Loop::instance()->init();
+	
+	Events events;
+	Semaphore done;
+	size_t received = 0;
+	
+	events.on<BenchEvent>([&](const BenchEvent &event) {
+		if (++received == EVENTS_COUNT)
+			done.post();
+	});
+	
+	std::thread loop_thread([]() {
+		Loop::instance()->run();
+	});
+	
+	bench->run("Events/emit", EVENTS_COUNT, [&]() {
+		received = 0;
+		
+		int64_t start = Bench::now();
+		for (size_t i = 0; i < EVENTS_COUNT; i++)
+			events.emit(BenchEvent {i});
+		while (!done.wait(60000));
+		return Bench::now() - start;
+	});
+	
+	Loop::instance()->stop();
+	loop_thread.join();
+}
+
+void benchLoop(Bench *bench) {
+	benchTimers(bench);
+	benchTasks(bench);
+	benchEvents(bench);
+}
@@ -0,0 +1,143 @@
+#include "Bench.h"
+
+#include <cstdlib>
+#include <unistd.h>
+
+#include <Core/Log.h>
+#include <Core/Utils.h>
+#include <Core/SmsDb.h>
+#include <Core/GsmUtils.h>
+
+static const std::vector<size_t> DB_SIZES = {100, 1000, 10000};
+
+// Same as BaseAtModem::decodePduToSms, but without invalid PDU handling
+static bool decodePduToSms(const std::string &hex, SmsDb::RawSms *sms) {
+	Pdu pdu = {};
+	PduUserDataHeader hdr = {};
+	bool success = false;
+	
+	if (decodePdu(hex2bin(hex), &pdu, false))
+		std::tie(success, sms->text) = decodeSmsDcsData(&pdu, &hdr);
+	
+	if (!success || pdu.type != PDU_TYPE_DELIVER)
+		return false;
+	
+	sms->type = SmsDb::SMS_INCOMING;
+	sms->flags = SmsDb::SMS_IS_UNREAD;
+	sms->ref_id = hdr.concatenated ? hdr.concatenated->ref_id : 0;
+	sms->parts = hdr.concatenated ? hdr.concatenated->parts : 1;
+	sms->part = hdr.concatenated ? hdr.concatenated->part : 1;
+	sms->smsc = pdu.smsc.toString();
+	sms->addr = pdu.deliver().src.toString();
+	sms->time = pdu.deliver().dt.timestamp;
+	
+	return true;
+}
+
+// Corpus repeated from different senders, so multipart messages are merged only within one round
+static std::vector<SmsDb::RawSms> generateSmsList(const std::vector<SmsDb::RawSms> &corpus, size_t count) {
+	std::vector<SmsDb::RawSms> list;
+	list.reserve(count);
+	
+	for (size_t i = 0; i < count; i++) {
+		auto sms = corpus[i % corpus.size()];
+		size_t round = i / corpus.size();
+		sms.index = i;
+		sms.addr += std::to_string(round);
+		sms.time += round * 60;
+		list.push_back(sms);
+	}
+	
+	return list;
+}
+
+static void fillDb(SmsDb *db, const std::vector<SmsDb::RawSms> &list) {
+	db->init();
+	for (auto &sms: list)
+		db->add(sms);
+}
+
+void benchSmsDb(Bench *bench, const std::vector<std::string> &corpus) {
+	std::vector<SmsDb::RawSms> raw_corpus;
+	for (auto &hex: corpus) {
+		SmsDb::RawSms sms;
+		if (decodePduToSms(hex, &sms))
+			raw_corpus.push_back(sms);
+	}
+	
+	if (!raw_corpus.size())
+		return;
+	
+	char tmp_dir[] = "/tmp/usbmodem-bench-XXXXXX";
+	if (!mkdtemp(tmp_dir)) {
+		LOGE("Can't create temporary dir, errno = %d\n", errno);
+		return;
+	}
+	
+	std::string db_file = std::string(tmp_dir) + "/sms.dat";
+	std::string tmp_file = std::string(tmp_dir) + "/sms.dat.tmp";
+	
+	auto initDb = [&](SmsDb *db) {
+		db->setDbFile(db_file);
+		db->setTmpFile(tmp_file);
+	};
+	
+	for (auto size: DB_SIZES) {
+		auto list = generateSmsList(raw_corpus, size);
+		
+		bench->run("SmsDb/add/" + std::to_string(size), size, [&]() {
+			SmsDb db;
+			initDb(&db);
+			db.init();
+			
+			int64_t start = Bench::now();
+			for (auto &sms: list)
+				db.add(sms);
+			return Bench::now() - start;
+		});
+		
+		// Full snapshot
+		bench->run("SmsDb/save/" + std::to_string(size), size, [&]() {
+			unlink(db_file.c_str());
+			
+			SmsDb db;
+			initDb(&db);
+			fillDb(&db, list);
+			
+			int64_t start = Bench::now();
+			db.save();
+			return Bench::now() - start;
+		});
+		
+		// Database from the last save
+		bench->run("SmsDb/load/" + std::to_string(size), size, [&]() {
+			SmsDb db;
+			initDb(&db);
+			
+			int64_t start = Bench::now();
+			db.load();
+			return Bench::now() - start;
+		});
+		
+		// One new message appended to journal
+		SmsDb db;
+		initDb(&db);
+		db.init();
+		db.load();
+		
+		size_t index = size;
+		bench->run("SmsDb/append/" + std::to_string(size), 1, [&]() {
+			auto sms = raw_corpus[0];
+			sms.index = index++;
+			
+			int64_t start = Bench::now();
+			db.add(sms);
+			db.save();
+			return Bench::now() - start;
+		});
+	}
+	
+	unlink(db_file.c_str());
+	unlink(tmp_file.c_str());
+	rmdir(tmp_dir);
+}
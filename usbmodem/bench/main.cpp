@@ -0,0 +1,80 @@
+#include <string>
+#include <vector>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#include <Core/Log.h>
+#include <Core/Utils.h>
+
+#include "Bench.h"
+
+static std::vector<std::string> loadCorpus(const std::string &path) {
+	std::vector<std::string> corpus;
+	std::ifstream fp(path);
+	std::string line;
+	
+	while (std::getline(fp, line)) {
+		line = trim(line);
+		if (line.size() && line[0] != '#')
+			corpus.push_back(line);
+	}
+	
+	return corpus;
+}
+
+static void usage() {
+	fprintf(stderr, "usage: usbmodem-bench [options]\n");
+	fprintf(stderr, "  --filter <str>       run only benchmarks which name contains <str>\n");
+	fprintf(stderr, "  --min-time <ms>      minimal time for each benchmark (default: 500)\n");
+	fprintf(stderr, "  --corpus <file>      PDU corpus, one hex PDU per line\n");
+	fprintf(stderr, "  --output <file>      write JSON results to file instead of stdout\n");
+}
+
+int main(int argc, char *argv[]) {
+	Bench bench;
+	std::string output;
+	std::vector<std::string> corpus = getDefaultPduCorpus();
+	
+	for (int i = 1; i < argc; i++) {
+		bool has_value = i + 1 < argc;
+		
+		if (strcmp(argv[i], "--filter") == 0 && has_value) {
+			bench.setFilter(argv[++i]);
+		} else if (strcmp(argv[i], "--min-time") == 0 && has_value) {
+			bench.setMinTime(strToInt(argv[++i], 10, 500));
+		} else if (strcmp(argv[i], "--corpus") == 0 && has_value) {
+			corpus = loadCorpus(argv[++i]);
+			if (!corpus.size()) {
+				LOGE("Empty corpus: %s\n", argv[i]);
+				return 1;
+			}
+		} else if (strcmp(argv[i], "--output") == 0 && has_value) {
+			output = argv[++i];
+		} else {
+			usage();
+			return 1;
+		}
+	}
+	
+	benchAtParser(&bench);
+	benchGsmUtils(&bench, corpus);
+	benchSmsDb(&bench, corpus);
+	benchLoop(&bench);
+	benchAtChannel(&bench);
+	
+	auto result = bench.toJson().dump(1, '\t');
+	
+	if (output.size()) {
+		std::ofstream fp(output);
+		fp << result << "\n";
+		if (!fp.good()) {
+			LOGE("Can't write %s\n", output.c_str());
+			return 1;
+		}
+	} else {
+		std::cout << result << "\n";
+	}
+	
+	return 0;
+}
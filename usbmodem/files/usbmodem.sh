@@ -7,16 +7,30 @@ init_proto "$@"
 proto_usbmodem_init_config() {
 	no_device=1
 	available=1
+	proto_config_add_boolean shared
 	proto_config_add_defaults
 }
 
 proto_usbmodem_setup() {
 	local interface=$1
+	local shared
+	
+	json_get_var shared shared
+	
+	# Hand interface over to the shared daemon (usbmodem multi), own daemon if it's not running
+	if [ "$shared" = "1" ] && ubus -t 10 wait_for usbmodem && ubus call usbmodem attach "{\"iface\": \"$interface\"}"; then
+		return
+	fi
+	
 	proto_run_command "$interface" usbmodem daemon "$interface"
 }
 
 proto_usbmodem_teardown() {
 	local interface=$1
+	local shared
+	
+	json_get_var shared shared
+	[ "$shared" = "1" ] && ubus call usbmodem detach "{\"iface\": \"$interface\"}" 2>/dev/null
 	
 	proto_init_update "*" 0
 	proto_send_update "$interface"
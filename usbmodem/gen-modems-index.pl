@@ -18,9 +18,7 @@ opendir D, $local_path or die "opendir($local_path): $!";
 @files = (@files, grep { -f $_ } map { "$local_path/$_" } readdir D);
 closedir D;
 
-@files = sort { basename($a) cmp basename($b) } @files;
-
-my @rows;
+my %modems;
 for my $file (@files) {
 	my ($vid, $pid) = split(/-/, basename($file));
 	
@@ -46,27 +44,86 @@ for my $file (@files) {
 		$json->{data} = 0 if !exists $json->{data};
 	}
 	
+	# Quirks: custom AT init commands
+	my $init = $json->{init} || "";
+	$init = join("\n", @$init) if ref($init) eq 'ARRAY';
+	
+	# Local files (loaded last) override wwan package
+	$modems{(hex($vid) << 16) | hex($pid)} = {
+		vid			=> hex $vid,
+		pid			=> hex $pid,
+		name		=> $json->{desc},
+		type		=> $type,
+		net			=> $net,
+		control		=> exists $json->{control} ? $json->{control} : 0xFF,
+		data		=> exists $json->{data} ? $json->{data} : 0xFF,
+		baudrate	=> $json->{baudrate} || 0,
+		init		=> $init
+	};
+}
+
+# All strings stored in one pool, offset 0 is empty string
+my @strings = ("");
+my %string_offsets = ("" => 0);
+my $strings_size = 1;
+
+sub addString {
+	my ($str) = @_;
+	if (!exists $string_offsets{$str}) {
+		$string_offsets{$str} = $strings_size;
+		$strings_size += length($str) + 1;
+		push @strings, $str;
+		die "String pool overflow" if $strings_size > 0xFFFF;
+	}
+	return $string_offsets{$str};
+}
+
+my @rows;
+for my $id (sort { $a <=> $b } keys %modems) {
+	my $modem = $modems{$id};
 	push @rows, [
-		sprintf("0x%04x", hex $vid).",",
-		sprintf("0x%04x", hex $pid).",",
-		"\"".$json->{desc}."\",",
-		"UsbDiscover::TYPE_$type,",
-		"UsbDiscover::NET_$net,",
-		(exists $json->{control} ? $json->{control} : 0xFF).",",
-		(exists $json->{data} ? $json->{data} : 0xFF)
+		sprintf("0x%04x", $modem->{vid}).",",
+		sprintf("0x%04x", $modem->{pid}).",",
+		"UsbDiscover::TYPE_".$modem->{type}.",",
+		"UsbDiscover::NET_".$modem->{net}.",",
+		$modem->{control}.",",
+		$modem->{data}.",",
+		$modem->{baudrate}.",",
+		addString($modem->{name}).",",
+		addString($modem->{init})
 	];
 }
 
-push @rows, ["0,", "0,", "\"\",", "UsbDiscover::TYPE_UNKNOWN,", "UsbDiscover::NET_GSM,", "0,", "0"];
-
 open(F, ">".dirname(__FILE__)."/src/UsbDiscoverData.cpp");
 print F "#include \"UsbDiscover.h\"\n\n";
 print F "/* DO NOT EDIT! THIS FILE GENERATED BY gen-modems-index.pl */\n";
-print F "const std::vector<UsbDiscover::ModemDescr> UsbDiscover::m_modem_list = {\n";
+print F "static constexpr char modem_strings[] =\n";
+print F join("\n", map { "\t\"".escapeString($_)."\\0\"" } @strings).";\n\n";
+print F "static constexpr UsbDiscover::ModemDescr modem_list[] = {\n";
 print F printTable(\@rows, "\t{", "},");
-print F "};\n";
+print F "};\n\n";
+print F "template <size_t N>\n";
+print F "static constexpr bool isModemListSorted(const UsbDiscover::ModemDescr (&list)[N]) {\n";
+print F "\tfor (size_t i = 1; i < N; i++) {\n";
+print F "\t\tif (list[i - 1].getId() >= list[i].getId())\n";
+print F "\t\t\treturn false;\n";
+print F "\t}\n";
+print F "\treturn true;\n";
+print F "}\n\n";
+print F "static_assert(isModemListSorted(modem_list), \"modem_list must be sorted by vid:pid\");\n\n";
+print F "const char *const UsbDiscover::m_modem_strings = modem_strings;\n";
+print F "const UsbDiscover::ModemDescr *const UsbDiscover::m_modem_list = modem_list;\n";
+print F "const size_t UsbDiscover::m_modem_list_size = sizeof(modem_list) / sizeof(modem_list[0]);\n";
 close F;
 
+sub escapeString {
+	my ($str) = @_;
+	$str =~ s/\\/\\\\/g;
+	$str =~ s/"/\\"/g;
+	$str =~ s/\n/\\n/g;
+	return $str;
+}
+
 sub printTable {
 	my ($table, $before, $after) = @_;
 	
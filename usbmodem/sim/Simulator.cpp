@@ -0,0 +1,524 @@
+#include "Simulator.h"
+
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <fstream>
+#include <algorithm>
+
+#include <poll.h>
+#include <fcntl.h>
+#include <fnmatch.h>
+#include <unistd.h>
+#include <termios.h>
+
+#include <Core/Log.h>
+#include <Core/Utils.h>
+
+Simulator::Simulator() {
+	m_start = now();
+}
+
+Simulator::~Simulator() {
+	closePty();
+	
+	if (m_wake_fds[0] != -1) {
+		::close(m_wake_fds[0]);
+		::close(m_wake_fds[1]);
+	}
+}
+
+int64_t Simulator::now() {
+	auto time = std::chrono::steady_clock::now().time_since_epoch();
+	return std::chrono::duration_cast<std::chrono::milliseconds>(time).count();
+}
+
+std::vector<std::string> Simulator::parseLines(const json &value) {
+	if (value.is_string())
+		return {value.get<std::string>()};
+	return value.get<std::vector<std::string>>();
+}
+
+bool Simulator::parseRule(const json &value, Rule *rule) {
+	rule->pattern = value.value("match", "*");
+	rule->status = value.value("status", "OK");
+	rule->delay = value.value("delay", 0);
+	rule->chunk = value.value("chunk", 0);
+	rule->chunk_delay = value.value("chunk_delay", 0);
+	rule->times = value.value("times", -1);
+	rule->prompt = value.value("prompt", false);
+	rule->ignore = value.value("ignore", false);
+	rule->disconnect = value.value("disconnect", false);
+	rule->disconnect_after = value.value("disconnect_after", 0);
+	rule->reconnect = value.value("reconnect", 0);
+	
+	if (value.contains("response"))
+		rule->response = parseLines(value["response"]);
+	
+	if (value.contains("urc")) {
+		for (auto &item: value["urc"]) {
+			UrcTrigger trigger;
+			trigger.lines = parseLines(item["lines"]);
+			trigger.delay = item.value("delay", 0);
+			rule->urc.push_back(trigger);
+		}
+	}
+	
+	return true;
+}
+
+bool Simulator::loadScenario(const std::string &path) {
+	std::ifstream fp(path);
+	if (!fp.good()) {
+		LOGE("Can't open scenario: %s\n", path.c_str());
+		return false;
+	}
+	
+	json scenario = json::parse(fp, nullptr, false);
+	if (scenario.is_discarded()) {
+		LOGE("Invalid JSON in scenario: %s\n", path.c_str());
+		return false;
+	}
+	
+	return loadScenario(scenario);
+}
+
+bool Simulator::loadScenario(const json &scenario) {
+	try {
+		m_rules.clear();
+		m_urcs.clear();
+		
+		m_echo = scenario.value("echo", false);
+		
+		if (scenario.contains("default"))
+			parseRule(scenario["default"], &m_default);
+		
+		if (scenario.contains("commands")) {
+			for (auto &item: scenario["commands"]) {
+				Rule rule;
+				parseRule(item, &rule);
+				m_rules.push_back(rule);
+			}
+		}
+		
+		if (scenario.contains("urc")) {
+			for (auto &item: scenario["urc"]) {
+				Urc urc;
+				urc.lines = parseLines(item["lines"]);
+				urc.start = item.value("start", 0);
+				urc.interval = std::max(1, item.value("interval", 1000));
+				urc.burst = std::max(1, item.value("burst", 1));
+				urc.count = item.value("count", 0);
+				m_urcs.push_back(urc);
+			}
+		}
+	} catch (json::exception &e) {
+		LOGE("Invalid scenario: %s\n", e.what());
+		return false;
+	}
+	
+	return true;
+}
+
+bool Simulator::openPty() {
+	m_master = posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+	if (m_master < 0) {
+		LOGE("posix_openpt() failed, error = %d\n", errno);
+		return false;
+	}
+	
+	char slave[PATH_MAX];
+	if (grantpt(m_master) != 0 || unlockpt(m_master) != 0 || ptsname_r(m_master, slave, sizeof(slave)) != 0) {
+		LOGE("Can't unlock pty, error = %d\n", errno);
+		closePty();
+		return false;
+	}
+	
+	m_slave = slave;
+	
+	// Keep own slave fd, otherwise master gets POLLHUP until client is connected
+	m_slave_fd = ::open(slave, O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+	if (m_slave_fd < 0) {
+		LOGE("%s - open error: %d\n", slave, errno);
+		closePty();
+		return false;
+	}
+	
+	// Default line discipline echoes all which we write
+	struct termios config;
+	if (tcgetattr(m_slave_fd, &config) != 0) {
+		LOGE("%s - can't get termios config\n", slave);
+		closePty();
+		return false;
+	}
+	
+	cfmakeraw(&config);
+	
+	if (tcsetattr(m_slave_fd, TCSANOW, &config) != 0) {
+		LOGE("%s - can't set termios config\n", slave);
+		closePty();
+		return false;
+	}
+	
+	if (m_link.size()) {
+		unlink(m_link.c_str());
+		if (symlink(slave, m_link.c_str()) != 0) {
+			LOGE("Can't create symlink %s -> %s, error = %d\n", m_link.c_str(), slave, errno);
+			closePty();
+			return false;
+		}
+	}
+	
+	m_line.clear();
+	m_wait_pdu = false;
+	m_pdu_rule = nullptr;
+	m_busy_until = 0;
+	m_session_start = 0;
+	
+	LOGD("Modem is ready: %s\n", getDevice().c_str());
+	
+	return true;
+}
+
+void Simulator::closePty() {
+	if (m_master != -1) {
+		::close(m_master);
+		m_master = -1;
+	}
+	
+	if (m_slave_fd != -1) {
+		::close(m_slave_fd);
+		m_slave_fd = -1;
+	}
+	
+	if (m_link.size())
+		unlink(m_link.c_str());
+	
+	m_outputs.clear();
+	m_tx.clear();
+}
+
+bool Simulator::open() {
+	if (m_wake_fds[0] == -1 && pipe2(m_wake_fds, O_CLOEXEC | O_NONBLOCK) < 0) {
+		LOGE("pipe2() failed, error = %d\n", errno);
+		return false;
+	}
+	return openPty();
+}
+
+void Simulator::stop() {
+	m_stop = true;
+	if (m_wake_fds[1] != -1)
+		while (::write(m_wake_fds[1], "w", 1) < 0 && errno == EINTR);
+}
+
+void Simulator::requestStatsDump() {
+	m_dump_stats = true;
+	if (m_wake_fds[1] != -1)
+		while (::write(m_wake_fds[1], "w", 1) < 0 && errno == EINTR);
+}
+
+Simulator::Rule *Simulator::findRule(const std::string &cmd) {
+	for (auto &rule: m_rules) {
+		if (rule.times >= 0 && rule.hits >= static_cast<uint64_t>(rule.times))
+			continue;
+		
+		if (fnmatch(rule.pattern.c_str(), cmd.c_str(), 0) == 0)
+			return &rule;
+	}
+	return nullptr;
+}
+
+void Simulator::handleInput(const char *data, size_t size) {
+	m_stats.bytes_in += size;
+	
+	for (size_t i = 0; i < size; i++) {
+		char c = data[i];
+		
+		if (m_wait_pdu) {
+			if (c == 0x1A) {
+				// Ctrl+Z - send PDU
+				if (m_verbose)
+					LOGD("<< PDU: %s\n", m_line.c_str());
+				m_wait_pdu = false;
+				m_line.clear();
+				respond(*m_pdu_rule, true);
+			} else if (c == 0x1B) {
+				// ESC - cancel
+				m_wait_pdu = false;
+				m_line.clear();
+			} else {
+				m_line += c;
+			}
+			continue;
+		}
+		
+		if (c == '\r') {
+			std::string cmd = trim(m_line);
+			m_line.clear();
+			
+			if (cmd.size())
+				handleCommand(cmd);
+		} else if (c != '\n') {
+			m_line += c;
+		}
+	}
+}
+
+void Simulator::handleCommand(const std::string &cmd) {
+	int64_t time = now();
+	
+	if (m_verbose)
+		LOGD("<< %s\n", cmd.c_str());
+	
+	// Periodic URC are started after client connected
+	if (!m_session_start) {
+		m_session_start = time;
+		for (auto &urc: m_urcs) {
+			urc.next = time + urc.start;
+			urc.sent = 0;
+		}
+	}
+	
+	if (m_echo)
+		schedule(std::max(time, m_busy_until), cmd + "\r");
+	
+	if (strcasecmp(cmd.c_str(), "ATE0") == 0) {
+		m_echo = false;
+	} else if (strcasecmp(cmd.c_str(), "ATE1") == 0) {
+		m_echo = true;
+	}
+	
+	m_stats.commands[cmd]++;
+	
+	Rule *rule = findRule(cmd);
+	if (!rule) {
+		m_stats.unmatched[cmd]++;
+		respond(m_default, false);
+		return;
+	}
+	
+	rule->hits++;
+	respond(*rule, false);
+}
+
+void Simulator::respond(const Rule &rule, bool prompted) {
+	if (rule.ignore)
+		return;
+	
+	int64_t time = std::max(now(), m_busy_until) + rule.delay;
+	
+	if (rule.prompt && !prompted) {
+		schedule(time, "\r\n> ");
+		m_busy_until = time;
+		m_wait_pdu = true;
+		m_pdu_rule = &rule;
+		return;
+	}
+	
+	std::string data;
+	if (rule.response.size())
+		data += "\r\n" + strJoin("\r\n", rule.response) + "\r\n";
+	if (rule.status.size())
+		data += "\r\n" + rule.status + "\r\n";
+	
+	if (rule.disconnect)
+		data = data.substr(0, rule.disconnect_after);
+	
+	if (rule.chunk > 0) {
+		for (size_t offset = 0; offset < data.size(); offset += rule.chunk) {
+			schedule(time, data.substr(offset, rule.chunk));
+			if (offset + rule.chunk < data.size())
+				time += rule.chunk_delay;
+		}
+	} else if (data.size()) {
+		schedule(time, data);
+	}
+	
+	m_busy_until = time;
+	
+	if (rule.disconnect) {
+		// Closed master drops unread data, so give client a time to read partial response
+		scheduleHangup(time + HANGUP_DELAY, rule.reconnect);
+		return;
+	}
+	
+	for (auto &trigger: rule.urc)
+		scheduleUrc(time + trigger.delay, trigger.lines);
+}
+
+void Simulator::schedule(int64_t time, const std::string &data, bool urc) {
+	m_outputs.insert({time, {OUTPUT_DATA, data, urc}});
+}
+
+void Simulator::scheduleUrc(int64_t time, const std::vector<std::string> &lines) {
+	schedule(time, "\r\n" + strJoin("\r\n", lines) + "\r\n", true);
+	m_stats.urc++;
+}
+
+void Simulator::scheduleHangup(int64_t time, int reconnect) {
+	m_outputs.insert({time, {OUTPUT_HANGUP, "", false, reconnect}});
+}
+
+void Simulator::processUrcs(int64_t time) {
+	if (!m_session_start)
+		return;
+	
+	// Don't break response in the middle
+	if (time < m_busy_until || m_wait_pdu)
+		return;
+	
+	for (auto &urc: m_urcs) {
+		while (urc.next <= time && (!urc.count || urc.sent < urc.count)) {
+			for (int i = 0; i < urc.burst; i++)
+				scheduleUrc(time, urc.lines);
+			urc.next += urc.interval;
+			urc.sent++;
+		}
+	}
+}
+
+void Simulator::processOutputs(int64_t time) {
+	while (m_outputs.size() && m_outputs.begin()->first <= time) {
+		Output output = m_outputs.begin()->second;
+		m_outputs.erase(m_outputs.begin());
+		
+		if (output.type == OUTPUT_HANGUP) {
+			flush();
+			
+			LOGD("Hangup %s\n", getDevice().c_str());
+			m_stats.disconnects++;
+			closePty();
+			
+			if (output.reconnect > 0) {
+				m_reconnect_at = time + output.reconnect;
+			} else {
+				m_stop = true;
+			}
+			return;
+		}
+		
+		// Client doesn't read, real modem also loses events in this case
+		if (output.urc && m_tx.size() + output.data.size() > MAX_TX_BUFFER) {
+			m_stats.dropped++;
+			continue;
+		}
+		
+		if (m_verbose)
+			LOGD(">> %s\n", strJoin(" | ", strSplit("\r\n", trim(output.data))).c_str());
+		
+		m_tx += output.data;
+	}
+	
+	flush();
+}
+
+bool Simulator::flush() {
+	while (m_tx.size()) {
+		int ret = ::write(m_master, m_tx.c_str(), m_tx.size());
+		if (ret > 0) {
+			m_stats.bytes_out += ret;
+			m_tx.erase(0, ret);
+		} else if (ret < 0 && errno == EINTR) {
+			continue;
+		} else if (ret < 0 && errno == EAGAIN) {
+			return true;
+		} else {
+			LOGE("write() failed, error = %d\n", errno);
+			return false;
+		}
+	}
+	return true;
+}
+
+int Simulator::getPollTimeout(int64_t time) const {
+	int64_t next = INT64_MAX;
+	
+	if (m_master == -1)
+		next = m_reconnect_at;
+	
+	if (m_outputs.size())
+		next = std::min(next, m_outputs.begin()->first);
+	
+	if (m_session_start && time >= m_busy_until && !m_wait_pdu) {
+		for (auto &urc: m_urcs) {
+			if (!urc.count || urc.sent < urc.count)
+				next = std::min(next, urc.next);
+		}
+	} else if (m_session_start) {
+		next = std::min(next, m_busy_until);
+	}
+	
+	if (next == INT64_MAX)
+		return -1;
+	
+	return static_cast<int>(std::max<int64_t>(0, next - time));
+}
+
+json Simulator::getStatsJson() const {
+	return {
+		{"uptime", now() - m_start},
+		{"commands", m_stats.commands},
+		{"unmatched", m_stats.unmatched},
+		{"urc", m_stats.urc},
+		{"bytes_in", m_stats.bytes_in},
+		{"bytes_out", m_stats.bytes_out},
+		{"dropped", m_stats.dropped},
+		{"disconnects", m_stats.disconnects},
+	};
+}
+
+int Simulator::run() {
+	char buffer[4096];
+	
+	while (!m_stop) {
+		int64_t time = now();
+		
+		if (m_master == -1 && time >= m_reconnect_at) {
+			if (!openPty())
+				return 1;
+		}
+		
+		if (m_master != -1) {
+			processUrcs(time);
+			processOutputs(time);
+		}
+		
+		if (m_stop)
+			break;
+		
+		struct pollfd fds[2] = {
+			{m_wake_fds[0], POLLIN, 0},
+			{m_master, static_cast<short>(m_tx.size() ? POLLIN | POLLOUT : POLLIN), 0},
+		};
+		
+		int ret = poll(fds, m_master != -1 ? 2 : 1, getPollTimeout(now()));
+		if (ret < 0) {
+			if (errno == EINTR)
+				continue;
+			LOGE("poll() failed, error = %d\n", errno);
+			return 1;
+		}
+		
+		if ((fds[0].revents & POLLIN)) {
+			while (::read(m_wake_fds[0], buffer, sizeof(buffer)) > 0);
+			
+			if (m_dump_stats) {
+				m_dump_stats = false;
+				LOGD("%s\n", getStatsJson().dump(1, '\t').c_str());
+			}
+		}
+		
+		if (m_master != -1 && (fds[1].revents & POLLOUT))
+			flush();
+		
+		if (m_master != -1 && (fds[1].revents & POLLIN)) {
+			int readed = ::read(m_master, buffer, sizeof(buffer));
+			if (readed > 0)
+				handleInput(buffer, readed);
+		}
+	}
+	
+	return 0;
+}
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include <Core/Json.h>
+
+/*
+ * Scriptable AT modem on the pseudo-terminal.
+ * Answers commands from the scenario and generates unsolicited events,
+ * so drivers can be tested without real hardware.
+ * */
+class Simulator {
+	public:
+		struct UrcTrigger {
+			std::vector<std::string> lines;
+			int delay = 0;
+		};
+		
+		struct Rule {
+			std::string pattern;					// fnmatch() pattern of the command
+			std::vector<std::string> response;
+			std::string status = "OK";				// empty - no final status
+			int delay = 0;							// before first byte of the response
+			int chunk = 0;							// split response to chunks of N bytes
+			int chunk_delay = 0;					// delay between chunks
+			int times = -1;							// rule is disabled after N hits
+			bool prompt = false;					// "> " and wait PDU until Ctrl+Z
+			bool ignore = false;					// never respond
+			bool disconnect = false;				// hangup pty while responding
+			int disconnect_after = 0;				// bytes of the response sent before hangup
+			int reconnect = 0;						// reopen pty after N ms, 0 - exit
+			std::vector<UrcTrigger> urc;
+			uint64_t hits = 0;
+		};
+		
+		struct Urc {
+			std::vector<std::string> lines;
+			int start = 0;
+			int interval = 1000;
+			int burst = 1;							// events in the one interval
+			int count = 0;							// total bursts, 0 - infinite
+			int64_t next = 0;
+			int sent = 0;
+		};
+		
+		struct Stats {
+			std::map<std::string, uint64_t> commands;
+			std::map<std::string, uint64_t> unmatched;
+			uint64_t urc = 0;
+			uint64_t bytes_in = 0;
+			uint64_t bytes_out = 0;
+			uint64_t dropped = 0;
+			uint64_t disconnects = 0;
+		};
+	protected:
+		enum OutputType {
+			OUTPUT_DATA,
+			OUTPUT_HANGUP,
+		};
+		
+		struct Output {
+			OutputType type;
+			std::string data;
+			bool urc = false;
+			int reconnect = 0;
+		};
+		
+		// Pty buffer is small, so pending output is kept here until client reads it
+		static constexpr size_t MAX_TX_BUFFER = 64 * 1024;
+		static constexpr int HANGUP_DELAY = 100;
+		
+		std::vector<Rule> m_rules;
+		std::vector<Urc> m_urcs;
+		Rule m_default;
+		bool m_echo = false;
+		
+		int m_master = -1;
+		int m_slave_fd = -1;
+		int m_wake_fds[2] = {-1, -1};
+		std::string m_link;
+		std::string m_slave;
+		
+		// Key is a time of output, equal keys keep insertion order
+		std::multimap<int64_t, Output> m_outputs;
+		int64_t m_busy_until = 0;
+		int64_t m_reconnect_at = 0;
+		int64_t m_start = 0;
+		int64_t m_session_start = 0;				// first command after (re)connect
+		std::string m_tx;
+		
+		std::string m_line;
+		bool m_wait_pdu = false;
+		const Rule *m_pdu_rule = nullptr;
+		
+		Stats m_stats;
+		bool m_verbose = false;
+		volatile bool m_stop = false;
+		volatile bool m_dump_stats = false;
+		
+		static int64_t now();
+		static std::vector<std::string> parseLines(const json &value);
+		static bool parseRule(const json &value, Rule *rule);
+		
+		bool openPty();
+		void closePty();
+		
+		void handleInput(const char *data, size_t size);
+		void handleCommand(const std::string &cmd);
+		void respond(const Rule &rule, bool prompted);
+		Rule *findRule(const std::string &cmd);
+		
+		void schedule(int64_t time, const std::string &data, bool urc = false);
+		void scheduleUrc(int64_t time, const std::vector<std::string> &lines);
+		void scheduleHangup(int64_t time, int reconnect);
+		
+		void processUrcs(int64_t time);
+		void processOutputs(int64_t time);
+		int getPollTimeout(int64_t time) const;
+		bool flush();
+	public:
+		Simulator();
+		~Simulator();
+		
+		bool loadScenario(const std::string &path);
+		bool loadScenario(const json &scenario);
+		
+		inline void setLink(const std::string &link) {
+			m_link = link;
+		}
+		
+		inline void setVerbose(bool verbose) {
+			m_verbose = verbose;
+		}
+		
+		// Path of the slave side (or link, if set)
+		inline std::string getDevice() const {
+			return m_link.size() ? m_link : m_slave;
+		}
+		
+		inline const Stats &getStats() const {
+			return m_stats;
+		}
+		
+		json getStatsJson() const;
+		
+		bool open();
+		int run();
+		
+		// Can be called from other thread or signal handler
+		void stop();
+		void requestStatsDump();
+};
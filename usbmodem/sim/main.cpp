@@ -0,0 +1,83 @@
+#include <string>
+#include <cstring>
+#include <fstream>
+#include <csignal>
+
+#include <Core/Log.h>
+
+#include "Simulator.h"
+
+static Simulator *simulator = nullptr;
+
+static void usage() {
+	fprintf(stderr, "usage: usbmodem-sim [options] <scenario.json>\n");
+	fprintf(stderr, "  --link <path>        create symlink to the pty, recreated after reconnect\n");
+	fprintf(stderr, "  --stats <file>       write JSON stats to file on exit\n");
+	fprintf(stderr, "  --verbose            log all commands and responses\n");
+	fprintf(stderr, "SIGUSR1 prints current stats to stderr.\n");
+}
+
+static void signalHandler(int sig) {
+	if (sig == SIGUSR1) {
+		simulator->requestStatsDump();
+	} else {
+		simulator->stop();
+	}
+}
+
+int main(int argc, char *argv[]) {
+	Simulator sim;
+	std::string scenario;
+	std::string stats;
+	
+	for (int i = 1; i < argc; i++) {
+		bool has_value = i + 1 < argc;
+		
+		if (strcmp(argv[i], "--link") == 0 && has_value) {
+			sim.setLink(argv[++i]);
+		} else if (strcmp(argv[i], "--stats") == 0 && has_value) {
+			stats = argv[++i];
+		} else if (strcmp(argv[i], "--verbose") == 0) {
+			sim.setVerbose(true);
+		} else if (argv[i][0] != '-' && !scenario.size()) {
+			scenario = argv[i];
+		} else {
+			usage();
+			return 1;
+		}
+	}
+	
+	if (!scenario.size()) {
+		usage();
+		return 1;
+	}
+	
+	if (!sim.loadScenario(scenario))
+		return 1;
+	
+	if (!sim.open())
+		return 1;
+	
+	simulator = &sim;
+	signal(SIGINT, signalHandler);
+	signal(SIGTERM, signalHandler);
+	signal(SIGUSR1, signalHandler);
+	signal(SIGPIPE, SIG_IGN);
+	
+	int ret = sim.run();
+	
+	auto result = sim.getStatsJson().dump(1, '\t');
+	
+	if (stats.size()) {
+		std::ofstream fp(stats);
+		fp << result << "\n";
+		if (!fp.good()) {
+			LOGE("Can't write %s\n", stats.c_str());
+			return 1;
+		}
+	} else {
+		LOGD("%s\n", result.c_str());
+	}
+	
+	return ret;
+}
@@ -1,8 +1,13 @@
+#define LOG_CATEGORY LOG_CAT_AT
+
 #include "AtChannel.h"
 #include "AtParser.h"
+#include "Loop.h"
 
 #include <signal.h>
 #include <unistd.h>
+#include <cstring>
+#include <algorithm>
 #include <stdexcept>
 
 const std::string AtChannel::empty_line;
@@ -26,7 +31,8 @@ const int AtChannel::Response::getCmsError() const {
 }
 
 AtChannel::AtChannel() {
-	
+	static std::atomic<uint8_t> last_trace_id = 0;
+	m_trace_id = last_trace_id++;
 }
 
 AtChannel::~AtChannel() {
@@ -41,13 +47,19 @@ bool AtChannel::start() {
 		m_thread = std::thread([this]() {
 			readerLoop();
 		});
+		
+		m_writer_thread = std::thread([this]() {
+			writerLoop();
+		});
 	}
 	return true;
 }
 
 void AtChannel::stop() {
 	if (m_started) {
+		m_queue_mutex.lock();
 		m_stop = true;
+		m_queue_mutex.unlock();
 		
 		// Break current serial transfer
 		m_serial->breakTransfer();
@@ -55,35 +67,115 @@ void AtChannel::stop() {
 		// Wait for reader loop done
 		m_thread.join();
 		
+		// Abort current command
+		abortResponse();
+		
+		// Wait for writer loop done
+		m_queue_cond.notify_all();
+		m_writer_thread.join();
+		
+		cancelPendingRequests();
+		
 		m_started = false;
 	}
 }
 
-void AtChannel::onUnsolicited(const std::string &prefix, const std::function<void(const std::string &)> &handler) {
-	m_unsol_handlers.push_back({.prefix = prefix + ":", .handler = handler});
+void AtChannel::onUnsolicited(const std::string &prefix, const UnsolCallback &handler) {
+	auto it = m_unsol_handlers.find(prefix);
+	if (it == m_unsol_handlers.end()) {
+		auto entry = std::make_unique<UnsolHandler>();
+		entry->prefix = prefix;
+		
+		std::string_view key = entry->prefix;
+		it = m_unsol_handlers.emplace(key, std::move(entry)).first;
+	}
+	it->second->callbacks.push_back(handler);
 }
 
 void AtChannel::resetUnsolicitedHandlers() {
 	m_unsol_handlers.clear();
+	m_unsol_unhandled = 0;
+}
+
+std::vector<std::pair<std::string, uint64_t>> AtChannel::getUnsolicitedHits() {
+	std::vector<std::pair<std::string, uint64_t>> result;
+	result.reserve(m_unsol_handlers.size());
+	for (auto &it: m_unsol_handlers)
+		result.push_back({it.second->prefix, it.second->hits});
+	return result;
+}
+
+/*
+ * Statistics
+ * */
+std::string AtChannel::getCommandName(const std::string &cmd) {
+	// Dial string contains phone number
+	if (strStartsWith(cmd, "ATD"))
+		return "ATD";
+	return cmd.substr(0, cmd.find_first_of("=?;"));
+}
+
+AtChannel::CommandStats *AtChannel::getCommandStats(const std::string &name) {
+	auto it = m_cmd_stats.find(name);
+	if (it != m_cmd_stats.end())
+		return &it->second;
+	
+	if (m_cmd_stats.size() >= MAX_STATS_COMMANDS)
+		return &m_cmd_stats["OTHER"];
+	
+	return &m_cmd_stats[name];
+}
+
+void AtChannel::updateCommandStats(const std::string &name, Errors error, int64_t latency) {
+	std::lock_guard<std::mutex> lock(m_stats_mutex);
+	auto *stats = getCommandStats(name);
+	stats->count++;
+	stats->latency.add(latency);
+	
+	if (error) {
+		stats->errors++;
+		if (error == AT_TIMEOUT)
+			stats->timeouts++;
+	}
+}
+
+void AtChannel::updateQueueStats(const Request *request, int64_t delay) {
+	std::lock_guard<std::mutex> lock(m_stats_mutex);
+	getCommandStats(request->batch.size() > 0 ? "BATCH" : getCommandName(request->cmd))->queue.add(delay);
+}
+
+AtChannel::Stats AtChannel::getStats() {
+	Stats stats;
+	
+	m_stats_mutex.lock();
+	stats.commands = m_cmd_stats;
+	m_stats_mutex.unlock();
+	
+	stats.urc = getUnsolicitedHits();
+	stats.urc_unhandled = m_unsol_unhandled;
+	stats.bytes_read = m_bytes_read;
+	stats.bytes_written = m_bytes_written;
+	stats.reader_wakeups = m_reader_wakeups;
+	
+	return stats;
 }
 
 void AtChannel::readerLoop() {
-	char tmp[256];
+	m_buffer_size = 0;
+	m_buffer_overflow = false;
 	
 	while (!m_stop) {
-		int readed = m_serial->readChunk(tmp, sizeof(tmp), 30000);
+		int readed = m_serial->readChunk(m_buffer + m_buffer_size, sizeof(m_buffer) - m_buffer_size, 30000);
 		if (m_stop)
 			break;
 		
+		m_reader_wakeups++;
+		
 		// Serial device lost
 		if (readed == Serial::ERR_BROKEN) {
 			m_stop = true;
 			
-			if (m_curr_response) {
-				m_curr_response->error = AT_IO_BROKEN;
-				m_curr_response = nullptr;
-				m_cmd_sem.post();
-			}
+			abortResponse();
 			
 			if (m_broken_io_handler)
 				m_broken_io_handler();
@@ -94,24 +186,74 @@ void AtChannel::readerLoop() {
 			continue;
 		}
 		
-		for (int i = 0; i < readed; i++) {
-			m_buffer += tmp[i];
-			if (strHasEol(m_buffer)) {
-				// Trim \r\n at end
-				m_buffer.erase(m_buffer.size() - 2);
-				
-				// Hande line if not empty after trim
-				if (m_buffer.size() > 0)
-					handleLine();
-				
-				// Reset buffer
-				m_buffer = "";
-			}
+		m_bytes_read += readed;
+		
+		if (Log::isTraceEnabled())
+			Log::trace(m_trace_id, LOG_TRACE_RX, m_buffer + m_buffer_size, readed);
+		
+		handleChunk(readed);
+	}
+}
+
+void AtChannel::handleChunk(size_t size) {
+	size_t line_start = 0;
+	size_t offset = m_buffer_size;
+	size_t end = m_buffer_size + size;
+	
+	while (offset < end) {
+		auto *eol = static_cast<char *>(memchr(m_buffer + offset, '\n', end - offset));
+		if (!eol)
+			break;
+		
+		size_t eol_offset = eol - m_buffer;
+		offset = eol_offset + 1;
+		
+		// Only \r\n is line terminator
+		if (eol_offset == line_start || m_buffer[eol_offset - 1] != '\r')
+			continue;
+		
+		// Tail of the too long line, skip it
+		if (m_buffer_overflow) {
+			m_buffer_overflow = false;
+			line_start = offset;
+			continue;
 		}
+		
+		// Hande line if not empty after trim
+		size_t line_size = eol_offset - 1 - line_start;
+		if (line_size > 0)
+			handleLine(std::string_view(m_buffer + line_start, line_size));
+		
+		line_start = offset;
+	}
+	
+	// PDU prompt "> " doesn't have \r\n
+	if (line_start < end && m_buffer[line_start] == '>' && m_wait_prompt.exchange(false)) {
+		line_start = end;
+		m_cmd_sem.post();
+	}
+	
+	m_buffer_size = end - line_start;
+	
+	if (m_buffer_size == sizeof(m_buffer)) {
+		// Line doesn't fit into buffer, drop it until next \r\n
+		LOGE("AT line is too long (> %d bytes), skipping...\n", MAX_AT_RESPONSE);
+		m_buffer_overflow = true;
+		
+		// Keep \r, if \r\n is split between chunks
+		if (m_buffer[sizeof(m_buffer) - 1] == '\r') {
+			m_buffer[0] = '\r';
+			m_buffer_size = 1;
+		} else {
+			m_buffer_size = 0;
+		}
+	} else if (line_start > 0 && m_buffer_size > 0) {
+		// Move incomplete line to the beginning
+		memmove(m_buffer, m_buffer + line_start, m_buffer_size);
 	}
 }
 
-bool AtChannel::isErrorResponse(const std::string &line, bool dial) {
+bool AtChannel::isErrorResponse(std::string_view line, bool dial) {
 	if (strStartsWith(line, "ERROR") || strStartsWith(line, "+CMS ERROR") || strStartsWith(line, "+CME ERROR"))
 		return true;
 	
@@ -123,7 +265,7 @@ bool AtChannel::isErrorResponse(const std::string &line, bool dial) {
 	return false;
 }
 
-bool AtChannel::isSuccessResponse(const std::string &line, bool dial) {
+bool AtChannel::isSuccessResponse(std::string_view line, bool dial) {
 	if (strStartsWith(line, "OK"))
 		return true;
 	
@@ -135,69 +277,95 @@ bool AtChannel::isSuccessResponse(const std::string &line, bool dial) {
 	return false;
 }
 
-void AtChannel::handleUnsolicitedLine() {
-	if (m_verbose)
-		LOGD("AT -- %s\n", m_buffer.c_str());
+void AtChannel::handleUnsolicitedLine(std::string_view line) {
+	LOGD("AT -- %.*s\n", (int) line.size(), line.data());
+	
+	// URC prefix is the text before ':'
+	size_t prefix_len = line.find(':');
+	if (prefix_len == std::string_view::npos) {
+		m_unsol_unhandled++;
+		return;
+	}
 	
-	for (auto &h: m_unsol_handlers) {
-		if (strStartsWith(m_buffer, h.prefix))
-			h.handler(m_buffer);
+	auto it = m_unsol_handlers.find(line.substr(0, prefix_len));
+	if (it == m_unsol_handlers.end()) {
+		m_unsol_unhandled++;
+		return;
 	}
+	
+	auto &entry = it->second;
+	entry->hits++;
+	
+	for (auto &callback: entry->callbacks)
+		callback(line);
 }
 
-void AtChannel::handleLine() {
-	if (m_curr_response) {
-		if (isSuccessResponse(m_buffer, m_curr_type == DIAL)) {
-			m_curr_response->error = AT_SUCCESS;
-			m_curr_response->status = m_buffer;
-			
-			m_curr_response = nullptr;
-			m_cmd_sem.post();
-		} else if (isErrorResponse(m_buffer, m_curr_type == DIAL)) {
-			m_curr_response->error = AT_ERROR;
-			m_curr_response->status = m_buffer;
-			
-			m_curr_response = nullptr;
-			m_cmd_sem.post();
-			m_curr_response = nullptr;
+void AtChannel::finishResponse(Response *response, Errors error, std::string_view status) {
+	// Writer took response back on timeout
+	if (!m_curr_response.compare_exchange_strong(response, nullptr))
+		return;
+	
+	response->error = error;
+	response->status = status;
+	m_cmd_sem.post();
+}
+
+void AtChannel::abortResponse() {
+	Response *response = m_curr_response.exchange(nullptr);
+	if (response) {
+		response->error = AT_IO_BROKEN;
+		m_cmd_sem.post();
+	}
+}
+
+void AtChannel::handleLine(std::string_view line) {
+	Response *response = m_curr_response;
+	if (response) {
+		if (isSuccessResponse(line, m_curr_type == DIAL)) {
+			finishResponse(response, AT_SUCCESS, line);
+		} else if (isErrorResponse(line, m_curr_type == DIAL)) {
+			finishResponse(response, AT_ERROR, line);
 		} else if (m_curr_type == DEFAULT) {
-			if (strStartsWith(m_buffer, m_curr_prefix)) {
-				m_curr_response->lines.push_back(m_buffer);
+			if (strStartsWith(line, m_curr_prefix)) {
+				response->lines.emplace_back(line);
 			} else {
-				handleUnsolicitedLine();
+				handleUnsolicitedLine(line);
 			}
 		} else if (m_curr_type == NO_PREFIX_ALL) {
-			m_curr_response->lines.push_back(m_buffer);
-			handleUnsolicitedLine();
+			response->lines.emplace_back(line);
+			handleUnsolicitedLine(line);
 		} else if (m_curr_type == NO_PREFIX) {
-			if (m_buffer[0] == '+' || m_buffer[0] == '*' || m_buffer[0] == '^' || m_buffer[0] == '!') {
-				handleUnsolicitedLine();
+			if (line[0] == '+' || line[0] == '*' || line[0] == '^' || line[0] == '!') {
+				handleUnsolicitedLine(line);
 			} else {
-				m_curr_response->lines.push_back(m_buffer);
+				response->lines.emplace_back(line);
 			}
 		} else if (m_curr_type == NUMERIC) {
-			if (m_curr_prefix.size() > 0 && strStartsWith(m_buffer, m_curr_prefix)) {
-				m_curr_response->lines.push_back(m_buffer);
-			} else if (isdigit(m_buffer[0])) {
-				m_curr_response->lines.push_back(m_buffer);
+			if (m_curr_prefix.size() > 0 && strStartsWith(line, m_curr_prefix)) {
+				response->lines.emplace_back(line);
+			} else if (isdigit(line[0])) {
+				response->lines.emplace_back(line);
 			} else {
-				handleUnsolicitedLine();
+				handleUnsolicitedLine(line);
 			}
 		} else if (m_curr_type == MULTILINE) {
-			if (strStartsWith(m_buffer, m_curr_prefix)) {
-				m_curr_response->lines.push_back(m_buffer);
-			} else if (m_curr_response->lines.size() > 0) {
-				if (m_buffer[0] == '+' || m_buffer[0] == '*' || m_buffer[0] == '^' || m_buffer[0] == '!') {
-					handleUnsolicitedLine();
+			if (strStartsWith(line, m_curr_prefix)) {
+				response->lines.emplace_back(line);
+			} else if (response->lines.size() > 0) {
+				if (line[0] == '+' || line[0] == '*' || line[0] == '^' || line[0] == '!') {
+					handleUnsolicitedLine(line);
 				} else {
-					m_curr_response->lines.back() += "\r\n" + m_buffer;
+					response->lines.back().append("\r\n").append(line);
 				}
 			}
+		} else if (m_curr_type == BATCH) {
+			if (!m_curr_batch || !handleBatchLine(line))
+				handleUnsolicitedLine(line);
 		} else {
-			handleUnsolicitedLine();
+			handleUnsolicitedLine(line);
 		}
 	} else {
-		handleUnsolicitedLine();
+		handleUnsolicitedLine(line);
 	}
 }
 
@@ -214,15 +382,10 @@ bool AtChannel::checkCommandExists(const std::string &cmd, int timeout) {
 	return false;
 }
 
-int AtChannel::sendCommand(ResultType type, const std::string &cmd, const std::string &prefix, Response *response, int timeout) {
+std::shared_ptr<AtChannel::Request> AtChannel::createRequest(ResultType type, const std::string &cmd, const std::string &prefix, int timeout) {
 	if ((type == DEFAULT || type == MULTILINE) && prefix == "")
 		type = NO_RESPONSE;
 	
-	if (m_stop) {
-		LOGE("[ %s ] error, AT channel already closed...\n", cmd.c_str());
-		return AT_IO_BROKEN;
-	}
-	
 	if (!timeout) {
 		timeout = m_timeout_callback ? m_timeout_callback(cmd) : 0;
 		
@@ -230,46 +393,320 @@ int AtChannel::sendCommand(ResultType type, const std::string &cmd, const std::s
 			timeout = m_default_at_timeout;
 	}
 	
-	at_cmd_mutex.lock();
+	auto request = std::make_shared<Request>();
+	request->type = type;
+	request->cmd = cmd;
+	request->prefix = prefix;
+	request->timeout = timeout;
+	request->priority = m_priority_callback ? m_priority_callback(cmd) : PRIO_NORMAL;
+	request->response.error = AT_IO_ERROR;
+	
+	if (request->priority < 0 || request->priority >= PRIO__MAX)
+		request->priority = PRIO_NORMAL;
+	
+	return request;
+}
+
+bool AtChannel::enqueueRequest(const std::shared_ptr<Request> &request) {
+	m_queue_mutex.lock();
+	if (m_stop || !m_started) {
+		m_queue_mutex.unlock();
+		LOGE("[ %s ] error, AT channel already closed...\n", request->cmd.c_str());
+		return false;
+	}
+	request->queued = getMonotonicTimestampUs();
+	m_queue[request->priority].push_back(request);
+	
+	// Don't wait minutes for the background command
+	if (request->priority < PRIO_BACKGROUND)
+		abortCurrent();
+	m_queue_mutex.unlock();
+	
+	m_queue_cond.notify_one();
+	
+	return true;
+}
+
+void AtChannel::completeRequest(const std::shared_ptr<Request> &request) {
+	if (!request->callback && !request->batch_callback) {
+		// Synchronous request, sendCommand() waits for it
+		request->done.post();
+		return;
+	}
+	
+	Loop::post([this, request]() {
+		if (request->response.error && m_global_error_handler)
+			m_global_error_handler(request->response.error, request->start);
+		
+		if (request->batch_callback) {
+			request->batch_callback(request->batch_responses);
+		} else {
+			request->callback(request->response);
+		}
+	});
+}
+
+void AtChannel::cancelPendingRequests() {
+	std::vector<std::shared_ptr<Request>> canceled;
+	
+	m_queue_mutex.lock();
+	for (auto &queue: m_queue) {
+		canceled.insert(canceled.end(), queue.begin(), queue.end());
+		queue.clear();
+	}
+	m_queue_mutex.unlock();
+	
+	for (auto &request: canceled) {
+		request->response.error = AT_IO_BROKEN;
+		for (auto &response: request->batch_responses)
+			response.error = AT_IO_BROKEN;
+		completeRequest(request);
+	}
+}
+
+void AtChannel::writerLoop() {
+	while (true) {
+		std::shared_ptr<Request> request;
+		
+		{
+			std::unique_lock<std::mutex> lock(m_queue_mutex);
+			m_queue_cond.wait(lock, [this]() {
+				if (m_stop)
+					return true;
+				for (auto &queue: m_queue) {
+					if (queue.size() > 0)
+						return true;
+				}
+				return false;
+			});
+			
+			if (m_stop)
+				break;
+			
+			// Take the oldest command with the highest priority
+			for (auto &queue: m_queue) {
+				if (queue.size() > 0) {
+					request = queue.front();
+					queue.pop_front();
+					break;
+				}
+			}
+		}
+		
+		execRequest(request.get());
+		
+		// Pre-empted, run again after more important requests
+		if (request->response.error == AT_ABORTED) {
+			std::lock_guard<std::mutex> lock(m_queue_mutex);
+			m_queue[request->priority].push_front(request);
+			continue;
+		}
+		
+		completeRequest(request);
+	}
+	
+	// Fail all commands, which will never be sent
+	cancelPendingRequests();
+}
+
+bool AtChannel::submit(const std::string &cmd, ResultType type, const std::string &prefix, const ResponseCallback &callback, int timeout) {
+	auto request = createRequest(type, cmd, prefix, timeout);
+	request->callback = callback;
+	return enqueueRequest(request);
+}
+
+bool AtChannel::submitPdu(const std::string &cmd, const std::string &pdu, const std::string &prefix, const ResponseCallback &callback, int timeout) {
+	auto request = createRequest(DEFAULT, cmd, prefix, timeout);
+	request->pdu = pdu;
+	request->callback = callback;
+	return enqueueRequest(request);
+}
+
+int AtChannel::sendCommand(ResultType type, const std::string &cmd, const std::string &prefix, Response *response, int timeout) {
+	auto request = createRequest(type, cmd, prefix, timeout);
+	
+	if (!enqueueRequest(request)) {
+		response->error = AT_IO_BROKEN;
+		response->lines.clear();
+		response->status.clear();
+		return AT_IO_BROKEN;
+	}
+	
+	// Wait while command is queued and executed
+	while (!request->done.wait(request->timeout));
+	
+	*response = std::move(request->response);
+	
+	if (response->error && m_global_error_handler)
+		m_global_error_handler(response->error, request->start);
+	
+	return response->error;
+}
+
+void AtChannel::execRequest(Request *request) {
+	updateQueueStats(request, getMonotonicTimestampUs() - request->queued);
+	
+	if (request->batch.size() > 0) {
+		execBatch(request);
+	} else {
+		bool abortable = request->priority == PRIO_BACKGROUND && request->aborts < MAX_ABORTS && !request->pdu.size();
+		bool aborted = false;
+		
+		request->start = execCommand(request->type, request->cmd, request->prefix, request->timeout, &request->response, request->pdu, abortable ? &aborted : nullptr);
+		
+		// Modem may return error or OK without data, when command is aborted
+		if (aborted) {
+			auto &response = request->response;
+			request->aborts++;
+			if (response.error == AT_ERROR || (response.error == AT_SUCCESS && !response.lines.size())) {
+				LOGD("[ %s ] aborted, will be run again\n", request->cmd.c_str());
+				response.error = AT_ABORTED;
+			}
+		}
+	}
+}
+
+void AtChannel::abortCurrent() {
+	if (!m_abortable || m_abort_sent)
+		return;
+	
+	// Modems without abort support ignore the line without "AT"
+	LOGD("AT >> <abort>\n");
+	m_abort_sent = true;
+	
+	int ret = m_serial->write("\r", 1, CANCEL_TIMEOUT);
+	if (ret > 0) {
+		m_bytes_written += ret;
+		if (Log::isTraceEnabled())
+			Log::trace(m_trace_id, LOG_TRACE_TX, "\r", ret);
+	}
+}
+
+int64_t AtChannel::execCommand(ResultType type, const std::string &cmd, const std::string &prefix, int timeout, Response *response, const std::string &pdu, bool *aborted) {
 	m_busy = true;
 	
 	int64_t start = getCurrentTimestamp();
+	int64_t start_us = getMonotonicTimestampUs();
 	
 	// Make sure response is clean
 	response->error = AT_IO_ERROR;
 	response->lines.clear();
 	response->status.clear();
 	
-	m_curr_response = response;
+	// Response is published last, reader reads type and prefix after it
 	m_curr_prefix = prefix;
 	m_curr_type = type;
+	m_curr_response = response;
 	
-	if (m_verbose)
-		LOGD("AT >> %s\n", cmd.c_str());
+	LOGD("AT >> %s\n", cmd.c_str());
 	
 	if (m_any_cmd_callback)
 		m_any_cmd_callback(cmd);
 	
 	// Write AT command to modem
 	std::string complete_cmd = cmd + "\r";
+	m_wait_prompt = pdu.size() > 0;
 	int ret = m_serial->write(complete_cmd.c_str(), complete_cmd.size(), getNewTimeout(start, timeout));
+	bool written = (ret == complete_cmd.size());
+	
+	if (ret > 0) {
+		m_bytes_written += ret;
+		if (Log::isTraceEnabled())
+			Log::trace(m_trace_id, LOG_TRACE_TX, complete_cmd.c_str(), ret);
+	}
+	
+	// Background command can be aborted from now, also by requests queued while it was sent
+	if (aborted && written) {
+		std::lock_guard<std::mutex> lock(m_queue_mutex);
+		m_abortable = true;
+		m_abort_sent = false;
+		for (int i = 0; i < PRIO_BACKGROUND; i++) {
+			if (m_queue[i].size() > 0) {
+				abortCurrent();
+				break;
+			}
+		}
+	}
 	
-	if (ret < 0 || ret != complete_cmd.size()) {
+	// Write PDU after "> " prompt
+	bool finished = false;
+	bool canceled = false;
+	if (written && pdu.size() > 0) {
+		bool in_time = m_cmd_sem.wait(getNewTimeout(start, timeout));
+		bool posted = in_time;
+		bool prompt = !m_wait_prompt.exchange(false);
+		
+		// Prompt or final response received right after timeout, consume its post
+		if (!posted && (prompt || !m_curr_response))
+			posted = m_cmd_sem.wait(LATE_RESPONSE_TIMEOUT);
+		
+		if (posted && !prompt) {
+			// Command failed before prompt, response is already complete
+			finished = true;
+		} else if (in_time) {
+			LOGD("AT >> %s\n", pdu.c_str());
+			
+			std::string complete_pdu = pdu + "\x1A";
+			ret = m_serial->write(complete_pdu.c_str(), complete_pdu.size(), getNewTimeout(start, timeout));
+			written = (ret == complete_pdu.size());
+			
+			if (ret > 0) {
+				m_bytes_written += ret;
+				if (Log::isTraceEnabled())
+					Log::trace(m_trace_id, LOG_TRACE_TX, complete_pdu.c_str(), ret);
+			}
+		} else {
+			LOGE("[ %s ] PDU prompt timeout\n", cmd.c_str());
+			
+			// Cancel PDU input
+			canceled = true;
+			ret = m_serial->write("\x1B", 1, CANCEL_TIMEOUT);
+			written = (ret == 1);
+			
+			if (ret > 0) {
+				m_bytes_written += ret;
+				if (Log::isTraceEnabled())
+					Log::trace(m_trace_id, LOG_TRACE_TX, "\x1B", ret);
+			}
+		}
+	}
+	
+	if (written && !finished) {
+		// Wait for command finish, canceled command has own timeout
+		finished = m_cmd_sem.wait(canceled ? CANCEL_TIMEOUT : getNewTimeout(start, timeout));
+	}
+	
+	// Take response back from reader, unless it was finished right after timeout
+	if (!finished && !m_curr_response.exchange(nullptr)) {
+		m_cmd_sem.wait(LATE_RESPONSE_TIMEOUT);
+		finished = true;
+	}
+	
+	if (aborted) {
+		std::lock_guard<std::mutex> lock(m_queue_mutex);
+		*aborted = m_abort_sent;
+		m_abortable = false;
+		m_abort_sent = false;
+	}
+	
+	if (!written) {
 		response->error = AT_IO_ERROR;
 		LOGE("[ %s ] serial io error\n", cmd.c_str());
-	} else {
-		// Wait for command finish
-		if (!m_cmd_sem.wait(getNewTimeout(start, timeout))) {
-			response->error = AT_TIMEOUT;
-			uint32_t elapsed = getCurrentTimestamp() - start;
-			LOGE("[ %s ] command timeout, elapsed = %u\n", cmd.c_str(), elapsed);
-		}
+	} else if (canceled) {
+		// PDU was not sent
+		response->error = AT_TIMEOUT;
+	} else if (!finished) {
+		response->error = AT_TIMEOUT;
+		uint32_t elapsed = getCurrentTimestamp() - start;
+		LOGE("[ %s ] command timeout, elapsed = %u\n", cmd.c_str(), elapsed);
 	}
 	
+	updateCommandStats(type == BATCH ? "BATCH" : getCommandName(cmd), response->error, getMonotonicTimestampUs() - start_us);
+	
 	if (response->error)
 		LOGE("[ %s ] error = %d, status = %s\n", cmd.c_str(), response->error, response->status.c_str());
 	
-	if (m_verbose) {
+	if (Log::isEnabled(LOG_CATEGORY, LOG_LEVEL_DEBUG)) {
 		if (type != NO_PREFIX_ALL) {
 			for (auto i = 0; i < response->lines.size(); i++)
 				LOGD("AT << %s\n", response->lines[i].c_str());
@@ -280,12 +717,193 @@ int AtChannel::sendCommand(ResultType type, const std::string &cmd, const std::s
 	}
 	
 	m_busy = false;
-	m_curr_response = nullptr;
 	
-	at_cmd_mutex.unlock();
+	return start;
+}
+
+/*
+ * Batch
+ * */
+bool AtChannel::isBatchCombinable(const std::vector<BatchCommand> &commands) {
+	if (commands.size() < 2)
+		return false;
 	
-	if (response->error && m_global_error_handler)
-		m_global_error_handler(response->error, start);
+	int numeric_cnt = 0;
+	for (auto &c: commands) {
+		// All commands must be extended (AT+XXX), responses without prefix can't be demultiplexed
+		if (!strStartsWith(c.cmd, "AT+") && !strStartsWith(c.cmd, "AT^") && !strStartsWith(c.cmd, "AT*"))
+			return false;
+		
+		switch (c.type) {
+			case DEFAULT:
+			case MULTILINE:
+			case NO_RESPONSE:
+				// OK
+			break;
+			
+			case NUMERIC:
+				// Only one numeric response can be identified
+				if (++numeric_cnt > 1)
+					return false;
+			break;
+			
+			default:
+				return false;
+			break;
+		}
+		
+		if (c.type == MULTILINE) {
+			for (auto &other: commands) {
+				if (&other != &c && other.prefix == c.prefix)
+					return false;
+			}
+		}
+	}
+	return true;
+}
+
+std::shared_ptr<AtChannel::Request> AtChannel::createBatchRequest(const std::vector<BatchCommand> &commands) {
+	auto request = createRequest(BATCH, "", "", 1);
 	
-	return response->error;
+	request->timeout = 0;
+	request->priority = PRIO__MAX - 1;
+	
+	for (auto &c: commands) {
+		auto item = createRequest(c.type, c.cmd, c.prefix, 0);
+		request->batch.push_back({item->type, item->cmd, item->prefix});
+		request->batch_timeouts.push_back(item->timeout);
+		request->timeout += item->timeout;
+		request->priority = std::min(request->priority, item->priority);
+		request->cmd += (request->cmd.size() ? ";" + c.cmd.substr(2) : c.cmd);
+	}
+	
+	request->batch_responses.resize(commands.size());
+	for (auto &response: request->batch_responses)
+		response.error = AT_IO_ERROR;
+	
+	return request;
+}
+
+void AtChannel::execBatch(Request *request) {
+	auto &commands = request->batch;
+	auto &responses = request->batch_responses;
+	auto mode_it = m_batch_modes.find(request->cmd);
+	BatchMode mode = mode_it != m_batch_modes.end() ? mode_it->second : BATCH_AUTO;
+	bool combine = mode != BATCH_UNSUPPORTED && isBatchCombinable(commands);
+	
+	if (combine) {
+		m_curr_batch = request;
+		m_batch_cursor = 0;
+		
+		for (auto &response: responses) {
+			response.lines.clear();
+			response.status.clear();
+		}
+		
+		request->start = execCommand(BATCH, request->cmd, "", request->timeout, &request->response);
+		m_curr_batch = nullptr;
+		
+		if (request->response.error == AT_SUCCESS) {
+			for (auto &response: responses) {
+				response.error = AT_SUCCESS;
+				response.status = request->response.status;
+				
+				if (Log::isEnabled(LOG_CATEGORY, LOG_LEVEL_DEBUG)) {
+					for (auto &line: response.lines)
+						LOGD("AT << %s\n", line.c_str());
+				}
+			}
+			m_batch_modes[request->cmd] = BATCH_SUPPORTED;
+			return;
+		}
+		
+		// Broken channel, don't try other commands
+		if (request->response.error == AT_IO_BROKEN || m_stop) {
+			for (auto &response: responses)
+				response.error = request->response.error;
+			return;
+		}
+	}
+	
+	// Back-to-back commands without thread switching
+	request->response.error = AT_SUCCESS;
+	for (size_t i = 0; i < commands.size(); i++) {
+		auto &c = commands[i];
+		int64_t start = execCommand(c.type, c.cmd, c.prefix, request->batch_timeouts[i], &responses[i]);
+		if (i == 0)
+			request->start = start;
+		if (responses[i].error && !request->response.error)
+			request->response.error = responses[i].error;
+	}
+	
+	/*
+	 * Concatenation never worked for this batch: modem doesn't support it or one of the commands fails,
+	 * which breaks the whole line anyway. Don't waste a round trip on it next time.
+	 * */
+	if (combine && mode == BATCH_AUTO) {
+		LOGI("[ %s ] batch failed, fallback to the sequential mode.\n", request->cmd.c_str());
+		m_batch_modes[request->cmd] = BATCH_UNSUPPORTED;
+	}
+}
+
+bool AtChannel::handleBatchLine(std::string_view line) {
+	auto &commands = m_curr_batch->batch;
+	auto &responses = m_curr_batch->batch_responses;
+	
+	for (size_t i = m_batch_cursor; i < commands.size(); i++) {
+		auto &c = commands[i];
+		
+		bool match = false;
+		if (c.prefix.size() > 0 && strStartsWith(line, c.prefix)) {
+			match = true;
+		} else if (c.type == NUMERIC && isdigit(line[0])) {
+			match = true;
+		}
+		
+		if (!match)
+			continue;
+		
+		// Already answered, probably this line for the next command with same prefix
+		if (c.type != MULTILINE && responses[i].lines.size() > 0)
+			continue;
+		
+		responses[i].lines.emplace_back(line);
+		m_batch_cursor = i;
+		
+		return true;
+	}
+	
+	// Continuation of multiline response
+	if (m_batch_cursor < commands.size() && commands[m_batch_cursor].type == MULTILINE && responses[m_batch_cursor].lines.size() > 0) {
+		if (line[0] != '+' && line[0] != '*' && line[0] != '^' && line[0] != '!') {
+			responses[m_batch_cursor].lines.back().append("\r\n").append(line);
+			return true;
+		}
+	}
+	
+	return false;
+}
+
+std::vector<AtChannel::Response> AtChannel::sendBatch(const std::vector<BatchCommand> &commands) {
+	auto request = createBatchRequest(commands);
+	
+	if (!enqueueRequest(request)) {
+		for (auto &response: request->batch_responses)
+			response.error = AT_IO_BROKEN;
+		return request->batch_responses;
+	}
+	
+	// Wait while batch is queued and executed
+	while (!request->done.wait(request->timeout));
+	
+	if (request->response.error && m_global_error_handler)
+		m_global_error_handler(request->response.error, request->start);
+	
+	return std::move(request->batch_responses);
+}
+
+bool AtChannel::submitBatch(const std::vector<BatchCommand> &commands, const BatchCallback &callback) {
+	auto request = createBatchRequest(commands);
+	request->batch_callback = callback;
+	return enqueueRequest(request);
 }
@@ -2,12 +2,20 @@
 
 #include <cstdio>
 #include <string>
+#include <string_view>
 #include <vector>
+#include <deque>
+#include <map>
+#include <memory>
+#include <atomic>
+#include <unordered_map>
 #include <functional>
 #include <mutex>
 #include <thread>
+#include <condition_variable>
 
 #include "Semaphore.h"
+#include "Histogram.h"
 #include "Serial.h"
 #include "Log.h"
 
@@ -17,13 +25,16 @@ class AtChannel {
 		
 		typedef std::function<int(const std::string &cmd)> TimeoutSetCallback;
 		typedef std::function<void(const std::string &cmd)> AnyCmdCallback;
+		typedef std::function<void(std::string_view line)> UnsolCallback;
+		typedef std::function<int(const std::string &cmd)> PrioritySetCallback;
 		
 		enum Errors {
 			AT_SUCCESS		= 0,
 			AT_TIMEOUT		= -1,
 			AT_ERROR		= -2,
 			AT_IO_ERROR		= -3,
-			AT_IO_BROKEN	= -4
+			AT_IO_BROKEN	= -4,
+			AT_ABORTED		= -5	// internal, background command is pre-empted and will be run again
 		};
 		
 		struct Response {
@@ -58,34 +69,141 @@ class AtChannel {
 			NO_RESPONSE,
 			DIAL,
 			NO_PREFIX,
-			NO_PREFIX_ALL
+			NO_PREFIX_ALL,
+			BATCH			// internal, used for ';'-concatenated batch
 		};
+		
+		enum Priority {
+			PRIO_HIGH		= 0,
+			PRIO_NORMAL		= 1,
+			PRIO_LOW		= 2,
+			PRIO_BACKGROUND	= 3,	// long abortable commands (AT+COPS=?), pre-empted by any other request
+			PRIO__MAX
+		};
+		
+		struct BatchCommand {
+			ResultType type;
+			std::string cmd;
+			std::string prefix;
+		};
+		
+		enum BatchMode {
+			BATCH_AUTO,
+			BATCH_SUPPORTED,
+			BATCH_UNSUPPORTED
+		};
+		
+		struct CommandStats {
+			uint64_t count = 0;
+			uint64_t errors = 0;
+			uint64_t timeouts = 0;
+			Histogram latency;		// from sending command to final response, us
+			Histogram queue;		// waiting in the queue before sending, us
+		};
+		
+		struct Stats {
+			// Key is a command name without arguments: AT+CREG=2 -> AT+CREG
+			std::map<std::string, CommandStats> commands;
+			std::vector<std::pair<std::string, uint64_t>> urc;
+			uint64_t urc_unhandled = 0;
+			uint64_t bytes_read = 0;
+			uint64_t bytes_written = 0;
+			uint64_t reader_wakeups = 0;
+		};
+		
+		// Protection from unlimited growth with custom commands
+		static constexpr size_t MAX_STATS_COMMANDS = 64;
+		
+		typedef std::function<void(const Response &response)> ResponseCallback;
+		typedef std::function<void(const std::vector<Response> &responses)> BatchCallback;
 	protected:
+		struct Request {
+			ResultType type;
+			std::string cmd;
+			std::string prefix;
+			int timeout;
+			int priority;
+			int64_t start = 0;
+			int64_t queued = 0;		// monotonic, us
+			int aborts = 0;
+			std::string pdu;
+			Response response;
+			ResponseCallback callback;
+			Semaphore done;
+			
+			// Batch
+			std::vector<BatchCommand> batch;
+			std::vector<int> batch_timeouts;
+			std::vector<Response> batch_responses;
+			BatchCallback batch_callback;
+		};
+		
+		// Pending commands, one queue per priority
+		std::deque<std::shared_ptr<Request>> m_queue[PRIO__MAX];
+		std::mutex m_queue_mutex;
+		std::condition_variable m_queue_cond;
+		std::thread m_writer_thread;
+		
+		// Background command on the wire can be aborted by any character (V.250), guarded by m_queue_mutex
+		static constexpr int MAX_ABORTS = 3;
+		bool m_abortable = false;
+		bool m_abort_sent = false;
+		
 		struct UnsolHandler {
 			std::string prefix;
-			std::function<void(std::string)> handler;
+			std::vector<UnsolCallback> callbacks;
+			std::atomic<uint64_t> hits = 0;
 		};
 		
-		std::vector<UnsolHandler> m_unsol_handlers;
+		// Key is a view of UnsolHandler::prefix (text before ':')
+		std::unordered_map<std::string_view, std::unique_ptr<UnsolHandler>> m_unsol_handlers;
+		std::atomic<uint64_t> m_unsol_unhandled = 0;
 		std::vector<std::string> m_unsol_queue;
 		
+		// Statistics
+		std::mutex m_stats_mutex;
+		std::map<std::string, CommandStats> m_cmd_stats;
+		std::atomic<uint64_t> m_bytes_read = 0;
+		std::atomic<uint64_t> m_bytes_written = 0;
+		std::atomic<uint64_t> m_reader_wakeups = 0;
+		
+		// Channel id in the AT trace
+		uint8_t m_trace_id = 0;
+		
 		int m_fd = -1;
 		Serial *m_serial = nullptr;
-		bool m_verbose = false;
 		bool m_stop = false;
 		
 		static constexpr int MAX_AT_RESPONSE = 8 * 1024;
 		
-		std::string m_buffer = "";
-		Response *m_curr_response = nullptr;
+		// Reader posts semaphore right after it takes the response, ms
+		static constexpr int LATE_RESPONSE_TIMEOUT = 1000;
+		
+		// Final response after PDU input is canceled with ESC, ms
+		static constexpr int CANCEL_TIMEOUT = 1000;
+		
+		// Line framer buffer
+		char m_buffer[MAX_AT_RESPONSE];
+		size_t m_buffer_size = 0;
+		bool m_buffer_overflow = false;
+		
+		// Set by writer, taken by reader when final response is received
+		std::atomic<Response *> m_curr_response = nullptr;
 		std::string m_curr_prefix = "";
 		ResultType m_curr_type = DEFAULT;
+		Request *m_curr_batch = nullptr;
+		size_t m_batch_cursor = 0;
+		
+		// Key is a concatenated batch command, used only by writer thread
+		std::unordered_map<std::string, BatchMode> m_batch_modes;
+		
 		Semaphore m_cmd_sem;
-		std::mutex at_cmd_mutex;
 		TimeoutSetCallback m_timeout_callback;
+		PrioritySetCallback m_priority_callback;
 		AnyCmdCallback m_any_cmd_callback;
 		int m_default_at_timeout = 10 * 1000;
 		bool m_busy = false;
+		std::atomic<bool> m_wait_prompt = false;		// set by writer, cleared by reader on "> "
 		
 		std::function<void()> m_broken_io_handler;
 		std::function<void(Errors error, int64_t start)> m_global_error_handler;
@@ -94,11 +212,33 @@ class AtChannel {
 		std::thread m_thread;
 		bool m_started = false;
 		
-		static bool isErrorResponse(const std::string &line, bool dial = false);
-		static bool isSuccessResponse(const std::string &line, bool dial = false);
-		
-		void handleLine();
-		void handleUnsolicitedLine();
+		static bool isErrorResponse(std::string_view line, bool dial = false);
+		static bool isSuccessResponse(std::string_view line, bool dial = false);
+		
+		std::shared_ptr<Request> createRequest(ResultType type, const std::string &cmd, const std::string &prefix, int timeout);
+		bool enqueueRequest(const std::shared_ptr<Request> &request);
+		void completeRequest(const std::shared_ptr<Request> &request);
+		void execRequest(Request *request);
+		void execBatch(Request *request);
+		int64_t execCommand(ResultType type, const std::string &cmd, const std::string &prefix, int timeout, Response *response, const std::string &pdu = empty_line, bool *aborted = nullptr);
+		void abortCurrent();
+		bool handleBatchLine(std::string_view line);
+		void finishResponse(Response *response, Errors error, std::string_view status);
+		void abortResponse();
+		
+		static bool isBatchCombinable(const std::vector<BatchCommand> &commands);
+		std::shared_ptr<Request> createBatchRequest(const std::vector<BatchCommand> &commands);
+		void cancelPendingRequests();
+		void writerLoop();
+		
+		static std::string getCommandName(const std::string &cmd);
+		CommandStats *getCommandStats(const std::string &name);
+		void updateCommandStats(const std::string &name, Errors error, int64_t latency);
+		void updateQueueStats(const Request *request, int64_t delay);
+		
+		void handleChunk(size_t size);
+		void handleLine(std::string_view line);
+		void handleUnsolicitedLine(std::string_view line);
 	public:
 		AtChannel();
 		~AtChannel();
@@ -107,10 +247,6 @@ class AtChannel {
 			m_serial = serial;
 		}
 
-		inline void setVerbose(bool verbose) {
-			m_verbose = verbose;
-		}
-		
 		inline void setDefaultTimeout(int timeout) {
 			m_default_at_timeout = timeout;
 		}
@@ -119,6 +255,10 @@ class AtChannel {
 			m_timeout_callback = callback;
 		}
 		
+		inline void setDefaultPriorityCallback(const PrioritySetCallback &callback) {
+			m_priority_callback = callback;
+		}
+		
 		inline void setAnyCommandCallback(const AnyCmdCallback &callback) {
 			m_any_cmd_callback = callback;
 		}
@@ -127,7 +267,28 @@ class AtChannel {
 		
 		int sendCommand(ResultType type, const std::string &cmd, const std::string &prefix, Response *response, int timeout = 0);
 		
-		void onUnsolicited(const std::string &prefix, const std::function<void(const std::string &)> &handler);
+		// Queue command and return immediately, callback is called on the Loop thread
+		bool submit(const std::string &cmd, ResultType type, const std::string &prefix, const ResponseCallback &callback, int timeout = 0);
+		
+		// Command with PDU, which is sent after "> " prompt (AT+CMGS, AT+CMGW)
+		bool submitPdu(const std::string &cmd, const std::string &pdu, const std::string &prefix, const ResponseCallback &callback, int timeout = 0);
+		
+		/*
+		 * Batch of commands in one transaction: AT+CMD1;+CMD2;+CMD3
+		 * Falls back to back-to-back commands, when the combined line fails. This is remembered per batch.
+		 * */
+		std::vector<Response> sendBatch(const std::vector<BatchCommand> &commands);
+		bool submitBatch(const std::vector<BatchCommand> &commands, const BatchCallback &callback);
+		
+		void onUnsolicited(const std::string &prefix, const UnsolCallback &handler);
+		
+		std::vector<std::pair<std::string, uint64_t>> getUnsolicitedHits();
+		
+		inline uint64_t getUnsolicitedUnhandled() {
+			return m_unsol_unhandled;
+		}
+		
+		Stats getStats();
 		
 		inline void onIoBroken(const std::function<void()> &handler) {
 			m_broken_io_handler = handler;
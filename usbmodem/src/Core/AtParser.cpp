@@ -1,16 +1,32 @@
+#define LOG_CATEGORY LOG_CAT_AT
+
 #include "AtParser.h"
 
+#include <charconv>
+
+void AtParser::logError(const char *func, int n) {
+	LOGE("AtParser:%s: can't parse #%d argument in '%.*s'\n", func, n, static_cast<int>(m_end - m_str), m_str);
+}
+
 bool AtParser::parseNextString(std::string *value) {
+	std::string_view view;
+	if (!parseNextString(&view))
+		return false;
+	value->assign(view.data(), view.size());
+	return true;
+}
+
+bool AtParser::parseNextString(std::string_view *value) {
 	const char *start, *end;
-	m_cursor = parseNextArg(m_cursor, &start, &end);
+	m_cursor = parseNextArg(m_cursor, m_end, &start, &end);
 	arg_cnt++;
 	
 	if (m_cursor) {
-		value->assign(start, end - start);
+		*value = std::string_view(start, end - start);
 		return true;
 	}
 	
-	LOGE("AtParser:%s: can't parse #%d argument in '%s'\n", __FUNCTION__, arg_cnt, m_str);
+	logError(__FUNCTION__, arg_cnt);
 	
 	m_success = false;
 	return false;
@@ -18,13 +34,13 @@ bool AtParser::parseNextString(std::string *value) {
 
 bool AtParser::parseNextInt(int32_t *value, int base) {
 	const char *start, *end;
-	m_cursor = parseNextArg(m_cursor, &start, &end);
+	m_cursor = parseNextArg(m_cursor, m_end, &start, &end);
 	arg_cnt++;
 	
 	if (parseNumeric(start, end, base, false, false, value))
 		return true;
 	
-	LOGE("AtParser:%s: can't parse #%d argument in '%s'\n", __FUNCTION__, arg_cnt, m_str);
+	logError(__FUNCTION__, arg_cnt);
 	
 	m_success = false;
 	return false;
@@ -32,13 +48,13 @@ bool AtParser::parseNextInt(int32_t *value, int base) {
 
 bool AtParser::parseNextUInt(uint32_t *value, int base) {
 	const char *start, *end;
-	m_cursor = parseNextArg(m_cursor, &start, &end);
+	m_cursor = parseNextArg(m_cursor, m_end, &start, &end);
 	arg_cnt++;
 	
 	if (parseNumeric(start, end, base, true, false, value))
 		return true;
 	
-	LOGE("AtParser:%s: can't parse #%d argument in '%s'\n", __FUNCTION__, arg_cnt, m_str);
+	logError(__FUNCTION__, arg_cnt);
 	
 	m_success = false;
 	return false;
@@ -46,13 +62,13 @@ bool AtParser::parseNextUInt(uint32_t *value, int base) {
 
 bool AtParser::parseNextInt64(int64_t *value, int base) {
 	const char *start, *end;
-	m_cursor = parseNextArg(m_cursor, &start, &end);
+	m_cursor = parseNextArg(m_cursor, m_end, &start, &end);
 	arg_cnt++;
 	
 	if (parseNumeric(start, end, base, false, true, value))
 		return true;
 	
-	LOGE("AtParser:%s: can't parse #%d argument in '%s'\n", __FUNCTION__, arg_cnt, m_str);
+	logError(__FUNCTION__, arg_cnt);
 	
 	m_success = false;
 	return false;
@@ -60,13 +76,13 @@ bool AtParser::parseNextInt64(int64_t *value, int base) {
 
 bool AtParser::parseNextUInt64(uint64_t *value, int base) {
 	const char *start, *end;
-	m_cursor = parseNextArg(m_cursor, &start, &end);
+	m_cursor = parseNextArg(m_cursor, m_end, &start, &end);
 	arg_cnt++;
 	
 	if (parseNumeric(start, end, base, true, true, value))
 		return true;
 	
-	LOGE("AtParser:%s: can't parse #%d argument in '%s'\n", __FUNCTION__, arg_cnt, m_str);
+	logError(__FUNCTION__, arg_cnt);
 	
 	m_success = false;
 	return false;
@@ -80,46 +96,61 @@ bool AtParser::parseNextBool(bool *value) {
 			return true;
 		} else {
 			m_success = false;
-			LOGE("AtParser:%s: can't parse #%d argument in '%s'\n", __FUNCTION__, arg_cnt, m_str);
+			logError(__FUNCTION__, arg_cnt);
 		}
 	}
 	return false;
 }
 
 bool AtParser::parseNumeric(const char *start, const char *end, int base, bool is_unsigned, bool is64, void *out) {
-	char *number_end = nullptr;
-	
 	if (!start)
 		return false;
 	
+	const char *cursor = skipSpaces(start, end);
+	
+	bool negative = false;
+	if (cursor < end && (*cursor == '-' || *cursor == '+')) {
+		negative = (*cursor == '-');
+		cursor++;
+	}
+	
+	if (base == 16 && end - cursor > 2 && cursor[0] == '0' && (cursor[1] == 'x' || cursor[1] == 'X'))
+		cursor += 2;
+	
+	// Locale independent and without re-scan
+	uint64_t value;
+	auto [number_end, ec] = std::from_chars(cursor, end, value, base);
+	if (ec != std::errc() || number_end == cursor)
+		return false;
+	
+	// Same overflow behavior as strtoul()
+	if (negative)
+		value = -value;
+	
 	if (is64) {
 		if (is_unsigned) {
-			uint64_t *ptr = static_cast<uint64_t*>(out);
-			*ptr = strtoull(start, &number_end, base);
+			*static_cast<uint64_t *>(out) = value;
 		} else {
-			int64_t *ptr = static_cast<int64_t*>(out);
-			*ptr = strtoull(start, &number_end, base);
+			*static_cast<int64_t *>(out) = static_cast<int64_t>(value);
 		}
 	} else {
 		if (is_unsigned) {
-			uint32_t *ptr = static_cast<uint32_t*>(out);
-			*ptr = strtoul(start, &number_end, base);
+			*static_cast<uint32_t *>(out) = static_cast<uint32_t>(value);
 		} else {
-			int32_t *ptr = static_cast<int32_t*>(out);
-			*ptr = strtoul(start, &number_end, base);
+			*static_cast<int32_t *>(out) = static_cast<int32_t>(value);
 		}
 	}
-	return number_end != start && number_end <= end;
+	return true;
 }
 
 bool AtParser::parseNextNewLine() {
 	arg_cnt++;
 	
-	while (isspace(*m_cursor) && *m_cursor != '\n')
-		m_cursor++;
+	if (m_cursor)
+		m_cursor = skipSpaces(m_cursor, m_end);
 	
-	if (*m_cursor != '\n') {
-		LOGE("AtParser:%s: can't parse #%d argument (new line) in '%s'\n", __FUNCTION__, arg_cnt, m_str);
+	if (!m_cursor || m_cursor == m_end || *m_cursor != '\n') {
+		LOGE("AtParser:%s: can't parse #%d argument (new line) in '%.*s'\n", __FUNCTION__, arg_cnt, static_cast<int>(m_end - m_str), m_str);
 		m_success = false;
 		return false;
 	}
@@ -129,70 +160,88 @@ bool AtParser::parseNextNewLine() {
 	return true;
 }
 
-bool AtParser::parseNextList(std::vector<std::string> *values) {
+bool AtParser::parseNextList(std::vector<std::string_view> *values) {
 	const char *start, *end;
 	int count = 0;
 	const char *orig = m_cursor;
 	do {
 		count++;
 		
-		m_cursor = parseNextArg(m_cursor, &start, &end);
+		m_cursor = parseNextArg(m_cursor, m_end, &start, &end);
 		if (!m_cursor) {
-			LOGE("AtParser:%s: can't parse #%d argument in '%s'\n", __FUNCTION__, count, orig);
+			LOGE("AtParser:%s: can't parse #%d argument in '%.*s'\n", __FUNCTION__, count, orig ? static_cast<int>(m_end - orig) : 0, orig);
 			m_success = false;
 			return false;
 		}
 		
-		values->push_back(std::string(start, end - start));
-	} while (m_cursor && *m_cursor);
+		values->emplace_back(start, end - start);
+	} while (m_cursor && m_cursor < m_end && *m_cursor != '\n');
 	return true;
 }
 
-bool AtParser::parseNextArray(std::vector<std::string> *values) {
-	std::string list_raw;
+bool AtParser::parseNextList(std::vector<std::string> *values) {
+	std::vector<std::string_view> views;
+	if (!parseNextList(&views))
+		return false;
+	values->insert(values->end(), views.begin(), views.end());
+	return true;
+}
+
+bool AtParser::parseNextArray(std::vector<std::string_view> *values) {
+	std::string_view list_raw;
 	if (!parseNextString(&list_raw))
 		return false;
 	
-	const char *start, *end, *cursor = list_raw.c_str();
+	const char *start, *end, *cursor = list_raw.data();
+	const char *list_end = list_raw.data() + list_raw.size();
 	int count = 0;
 	do {
 		count++;
 		
-		cursor = parseNextArg(cursor, &start, &end);
+		cursor = parseNextArg(cursor, list_end, &start, &end);
 		if (!cursor) {
-			LOGE("AtParser:%s: can't parse #%d argument in '%s'\n", __FUNCTION__, count, list_raw.c_str());
+			LOGE("AtParser:%s: can't parse #%d argument in '%.*s'\n", __FUNCTION__, count, static_cast<int>(list_raw.size()), list_raw.data());
 			m_success = false;
 			return false;
 		}
 		
-		values->push_back(std::string(start, end - start));
-	} while (cursor && *cursor);
+		values->emplace_back(start, end - start);
+	} while (cursor && cursor < list_end && *cursor != '\n');
 	
 	return true;
 }
 
+bool AtParser::parseNextArray(std::vector<std::string> *values) {
+	std::vector<std::string_view> views;
+	if (!parseNextArray(&views))
+		return false;
+	values->insert(values->end(), views.begin(), views.end());
+	return true;
+}
+
 bool AtParser::parseNextSkip() {
 	const char *start, *end;
-	m_cursor = parseNextArg(m_cursor, &start, &end);
+	m_cursor = parseNextArg(m_cursor, m_end, &start, &end);
 	arg_cnt++;
 	
 	if (m_cursor)
 		return true;
 	
-	LOGE("AtParser:%s: can't parse #%d argument in '%s'\n", __FUNCTION__, arg_cnt, m_str);
+	logError(__FUNCTION__, arg_cnt);
 	
 	m_success = false;
 	return false;
 }
 
-int AtParser::getArgCnt(const std::string &value) {
-	const char *start, *end, *cursor = value.c_str();
+int AtParser::getArgCnt(std::string_view value) {
+	const char *start, *end, *cursor = value.data();
+	const char *value_end = value.data() + value.size();
 	int count = 0;
 	do {
-		cursor = parseNextArg(cursor, &start, &end);
+		cursor = parseNextArg(cursor, value_end, &start, &end);
 		if (cursor)
 			count++;
-	} while (cursor && *cursor);
+	} while (cursor && cursor < value_end && *cursor != '\n');
 	return count;
 }
 
@@ -213,13 +262,13 @@ std::string AtParser::stripPrefix(const std::string &value) {
 	return value;
 }
 
-const char *AtParser::skipSpaces(const char *cursor) {
-	while (isspace(*cursor) && *cursor != '\n')
+const char *AtParser::skipSpaces(const char *cursor, const char *end) {
+	while (cursor < end && isspace(*cursor) && *cursor != '\n')
 		cursor++;
 	return cursor;
 }
 
-const char *AtParser::parseNextArg(const char *str, const char **start, const char **end) {
+const char *AtParser::parseNextArg(const char *str, const char *str_end, const char **start, const char **end) {
 	const char *cursor = str;
 	
 	if (!cursor)
@@ -227,10 +276,10 @@ const char *AtParser::parseNextArg(const char *str, const char **start, const ch
 	
 	*start = *end = nullptr;
 	
-	cursor = skipSpaces(cursor);
+	cursor = skipSpaces(cursor, str_end);
 	
 	// Is list
-	if (*cursor == '(') {
+	if (cursor < str_end && *cursor == '(') {
 		int level = 1;
 		char wait_char = 0;
 		
@@ -238,7 +287,7 @@ const char *AtParser::parseNextArg(const char *str, const char **start, const ch
 		
 		*start = cursor;
 		
-		while (*cursor) {
+		while (cursor < str_end) {
 			if (wait_char) {
 				if (*cursor == wait_char)
 					wait_char = 0;
@@ -251,10 +300,10 @@ const char *AtParser::parseNextArg(const char *str, const char **start, const ch
 						
 						cursor++;
 						
-						cursor = skipSpaces(cursor);
+						cursor = skipSpaces(cursor, str_end);
 						
-						if (!*cursor || *cursor == ',' || *cursor == '\n')
-							return *cursor == ',' ? cursor + 1 : cursor;
+						if (cursor == str_end || *cursor == ',' || *cursor == '\n')
+							return cursor < str_end && *cursor == ',' ? cursor + 1 : cursor;
 						return nullptr;
 					}
 				} else if (*cursor == '(') {
@@ -269,39 +318,39 @@ const char *AtParser::parseNextArg(const char *str, const char **start, const ch
 		return nullptr;
 	}
 	// Is quoted value
-	if (*cursor == '"') {
+	if (cursor < str_end && *cursor == '"') {
 		cursor++;
 		
 		*start = cursor;
 		
 		// Wait for next "
-		while (*cursor && *cursor != '"')
-			cursor++;
+		auto *quote = static_cast<const char *>(memchr(cursor, '"', str_end - cursor));
+		cursor = quote ? quote : str_end;
 		
 		*end = cursor;
 		
-		if (*cursor != '"')
+		if (cursor == str_end)
 			return nullptr;
 		
 		cursor++;
 		
-		cursor = skipSpaces(cursor);
+		cursor = skipSpaces(cursor, str_end);
 		
 		// Success, if next char is arg separator or string ended
-		if (!*cursor || *cursor == ',' || *cursor == '\n')
-			return *cursor == ',' ? cursor + 1 : cursor;
+		if (cursor == str_end || *cursor == ',' || *cursor == '\n')
+			return cursor < str_end && *cursor == ',' ? cursor + 1 : cursor;
 	}
 	// Is raw value
 	else {
 		*start = cursor;
 		
 		// Wait for next argument or EOF
-		while (*cursor && (*cursor != ',' && *cursor != '\n'))
+		while (cursor < str_end && (*cursor != ',' && *cursor != '\n'))
 			cursor++;
 		
 		*end = cursor;
 		
-		return *cursor == ',' ? cursor + 1 : cursor;
+		return cursor < str_end && *cursor == ',' ? cursor + 1 : cursor;
 	}
 	
 	return nullptr;
@@ -1,24 +1,56 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
+#include <tuple>
+#include <cstring>
+#include <cstdint>
 
 #include "Log.h"
 
 class AtParser {
 	protected:
 		const char *m_str = nullptr;
+		const char *m_end = nullptr;
 		const char *m_cursor = nullptr;
 		int arg_cnt = 0;
 		bool m_success = false;
 		
-		static const char *parseNextArg(const char *str, const char **start, const char **end);
+		static const char *parseNextArg(const char *str, const char *str_end, const char **start, const char **end);
 		static bool parseNumeric(const char *start, const char *end, int base, bool is_unsigned, bool is64, void *out);
 		
-		static const char *skipSpaces(const char *cursor);
+		static const char *skipSpaces(const char *cursor, const char *end);
+		
+		void logError(const char *func, int n);
+	public:
+		/*
+		 * Compile-time schema of the URC fields
+		 * */
+		template <size_t N = 1>
+		struct Skip { };
+		
+		template <typename M>
+		struct Hex {
+			M member;
+		};
+		
+		template <typename M>
+		static constexpr Hex<M> hex(M member) {
+			return {member};
+		}
+		
+		template <typename... Fields>
+		static constexpr std::tuple<Fields...> schema(Fields... fields) {
+			return {fields...};
+		}
 	public:
 		explicit AtParser(const std::string &s) {
-			parse(s.c_str());
+			parse(std::string_view(s));
+		}
+		
+		explicit AtParser(std::string_view s) {
+			parse(s);
 		}
 		
 		explicit AtParser(const char *s) {
@@ -27,7 +59,7 @@ class AtParser {
 		
 		AtParser() { }
 		
-		static int getArgCnt(const std::string &value);
+		static int getArgCnt(std::string_view value);
 		static std::string stripPrefix(const std::string &value);
 		
 		inline AtParser &reset() {
@@ -37,19 +69,15 @@ class AtParser {
 			return *this;
 		}
 		
-		inline AtParser &parse(const char *s) {
-			m_str = s;
-			m_cursor = s;
+		inline AtParser &parse(std::string_view s) {
+			m_str = s.data();
+			m_end = s.data() + s.size();
+			m_cursor = m_str;
 			
 			// Skip prefix
-			while (*m_cursor && *m_cursor != ':')
-				m_cursor++;
-			
-			if (*m_cursor) {
-				m_cursor++;
-			} else {
-				m_cursor = s;
-			}
+			auto *prefix_end = static_cast<const char *>(memchr(m_str, ':', s.size()));
+			if (prefix_end)
+				m_cursor = prefix_end + 1;
 			
 			m_success = true;
 			arg_cnt = 0;
@@ -61,8 +89,12 @@ class AtParser {
 			return m_success;
 		}
 		
+		inline AtParser &parse(const char *s) {
+			return parse(std::string_view(s));
+		}
+		
 		inline AtParser &parse(const std::string &s) {
-			return parse(s.c_str());
+			return parse(std::string_view(s));
 		}
 		
 		inline AtParser &parseString(std::string *value) {
@@ -70,6 +102,11 @@ class AtParser {
 			return *this;
 		}
 		
+		inline AtParser &parseString(std::string_view *value) {
+			parseNextString(value);
+			return *this;
+		}
+		
 		inline AtParser &parseInt(int32_t *value, int base = 10) {
 			parseNextInt(value, base);
 			return *this;
@@ -100,11 +137,21 @@ class AtParser {
 			return *this;
 		}
 		
+		inline AtParser &parseArray(std::vector<std::string_view> *values) {
+			parseNextArray(values);
+			return *this;
+		}
+		
 		inline AtParser &parseList(std::vector<std::string> *values) {
 			parseNextList(values);
 			return *this;
 		}
 		
+		inline AtParser &parseList(std::vector<std::string_view> *values) {
+			parseNextList(values);
+			return *this;
+		}
+		
 		inline AtParser &parseNewLine() {
 			parseNextNewLine();
 			return *this;
@@ -115,14 +162,73 @@ class AtParser {
 			return *this;
 		}
 		
+		// Parse all fields described by schema() into struct
+		template <typename T, typename... Fields>
+		inline AtParser &parseSchema(T *out, const std::tuple<Fields...> &fields) {
+			std::apply([this, out](const auto &... field) {
+				(parseSchemaField(out, field) && ...);
+			}, fields);
+			return *this;
+		}
+		
 		bool parseNextString(std::string *value);
+		bool parseNextString(std::string_view *value);
 		bool parseNextInt(int32_t *value, int base = 10);
 		bool parseNextUInt(uint32_t *value, int base = 10);
 		bool parseNextInt64(int64_t *value, int base = 10);
 		bool parseNextUInt64(uint64_t *value, int base = 10);
 		bool parseNextBool(bool *value);
 		bool parseNextArray(std::vector<std::string> *values);
+		bool parseNextArray(std::vector<std::string_view> *values);
 		bool parseNextList(std::vector<std::string> *values);
+		bool parseNextList(std::vector<std::string_view> *values);
 		bool parseNextNewLine();
 		bool parseNextSkip();
+	protected:
+		template <typename T, size_t N>
+		inline bool parseSchemaField(T *out, const Skip<N> &) {
+			for (size_t i = 0; i < N; i++) {
+				if (!parseNextSkip())
+					return false;
+			}
+			return true;
+		}
+		
+		template <typename T, typename M>
+		inline bool parseSchemaField(T *out, const Hex<M> &field) {
+			return parseSchemaValue(&(out->*field.member), 16);
+		}
+		
+		template <typename T, typename V>
+		inline bool parseSchemaField(T *out, V T::*member) {
+			return parseSchemaValue(&(out->*member), 10);
+		}
+		
+		inline bool parseSchemaValue(int32_t *value, int base) {
+			return parseNextInt(value, base);
+		}
+		
+		inline bool parseSchemaValue(uint32_t *value, int base) {
+			return parseNextUInt(value, base);
+		}
+		
+		inline bool parseSchemaValue(int64_t *value, int base) {
+			return parseNextInt64(value, base);
+		}
+		
+		inline bool parseSchemaValue(uint64_t *value, int base) {
+			return parseNextUInt64(value, base);
+		}
+		
+		inline bool parseSchemaValue(bool *value, int base) {
+			return parseNextBool(value);
+		}
+		
+		inline bool parseSchemaValue(std::string *value, int base) {
+			return parseNextString(value);
+		}
+		
+		inline bool parseSchemaValue(std::string_view *value, int base) {
+			return parseNextString(value);
+		}
 };
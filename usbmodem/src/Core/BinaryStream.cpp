@@ -4,6 +4,7 @@
 
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
 #include <unistd.h>
 
 /*
@@ -324,6 +325,7 @@ size_t BinaryBufferWriter::offset() {
 bool BinaryBufferWriter::write(const void *data, size_t len) {
 	const uint8_t *data8 = reinterpret_cast<const uint8_t *>(data);
 	m_buffer.insert(m_buffer.end(), data8, data8 + len);
+	m_offset += len;
 	return true;
 }
 
@@ -394,3 +396,47 @@ bool BinaryFileWriter::write(const void *data, size_t len) {
 	
 	return true;
 }
+
+/*
+ * BinaryMappedFile
+ * */
+BinaryMappedFile::~BinaryMappedFile() {
+	unmap();
+}
+
+bool BinaryMappedFile::map(int fd) {
+	struct stat st;
+	int ret;
+	
+	unmap();
+	
+	do {
+		ret = fstat(fd, &st);
+	} while (ret < 0 && errno == EINTR);
+	
+	if (ret != 0)
+		return false;
+	
+	// Empty file can't be mapped
+	if (!st.st_size)
+		return true;
+	
+	void *addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	if (addr == MAP_FAILED) {
+		LOGE("[BinaryMappedFile] mmap error = %d\n", errno);
+		return false;
+	}
+	
+	m_addr = addr;
+	m_size = st.st_size;
+	
+	return true;
+}
+
+void BinaryMappedFile::unmap() {
+	if (m_addr) {
+		munmap(m_addr, m_size);
+		m_addr = nullptr;
+		m_size = 0;
+	}
+}
@@ -2,6 +2,9 @@
 
 #include <string>
 #include <vector>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
 
 class BinaryReaderBase {
 	public:
@@ -175,7 +178,12 @@ class BinaryBufferWriter: public BinaryWriterBase {
 		size_t m_offset = 0;
 	public:
 		const uint8_t *buffer() const {
-			return &m_buffer[0];
+			return m_buffer.data();
+		}
+		
+		inline void clear() {
+			m_buffer.clear();
+			m_offset = 0;
 		}
 		
 		size_t size() override;
@@ -196,3 +204,140 @@ class BinaryFileWriter: public BinaryWriterBase {
 		size_t offset() override;
 		bool write(const void *data, size_t len) override;
 };
+
+/*
+ * Non-virtual reader over memory block (e.g. mmaped file).
+ * Strings are returned as views into this block, so block must outlive them.
+ * */
+class BinaryViewReader {
+	protected:
+		const uint8_t *m_data = nullptr;
+		size_t m_size = 0;
+		size_t m_offset = 0;
+		
+		template <typename T>
+		static constexpr T fromLE(T value) {
+			if constexpr (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__ || sizeof(T) == 1) {
+				return value;
+			} else if constexpr (sizeof(T) == 2) {
+				return __builtin_bswap16(value);
+			} else if constexpr (sizeof(T) == 4) {
+				return __builtin_bswap32(value);
+			} else {
+				return __builtin_bswap64(value);
+			}
+		}
+	public:
+		BinaryViewReader() { }
+		
+		BinaryViewReader(const uint8_t *data, size_t size) : m_data(data), m_size(size) { }
+		
+		inline const uint8_t *data() const {
+			return m_data;
+		}
+		
+		inline size_t size() const {
+			return m_size;
+		}
+		
+		inline size_t offset() const {
+			return m_offset;
+		}
+		
+		inline bool eof() const {
+			return m_offset >= m_size;
+		}
+		
+		inline bool avail(size_t len) const {
+			return len <= m_size - m_offset;
+		}
+		
+		inline bool skip(size_t len) {
+			if (!avail(len))
+				return false;
+			m_offset += len;
+			return true;
+		}
+		
+		inline bool read(void *data, size_t len) {
+			if (!avail(len))
+				return false;
+			memcpy(data, m_data + m_offset, len);
+			m_offset += len;
+			return true;
+		}
+		
+		// Little endian integer of any size
+		template <typename T>
+		inline bool readUInt(T *value) {
+			if (!read(value, sizeof(T)))
+				return false;
+			*value = fromLE(*value);
+			return true;
+		}
+		
+		inline bool readUInt8(uint8_t *value) {
+			return readUInt(value);
+		}
+		
+		inline bool readUInt16(uint16_t *value) {
+			return readUInt(value);
+		}
+		
+		inline bool readUInt32(uint32_t *value) {
+			return readUInt(value);
+		}
+		
+		inline bool readUInt64(uint64_t *value) {
+			return readUInt(value);
+		}
+		
+		inline bool readString(std::string_view *str, size_t len) {
+			if (!avail(len))
+				return false;
+			*str = std::string_view(reinterpret_cast<const char *>(m_data + m_offset), len);
+			m_offset += len;
+			return true;
+		}
+		
+		template <typename T>
+		inline bool readPackedString(std::string_view *str) {
+			T len;
+			return readUInt(&len) && readString(str, len);
+		}
+		
+		// Sub-reader over next len bytes
+		inline bool readBlock(BinaryViewReader *block, size_t len) {
+			if (!avail(len))
+				return false;
+			*block = BinaryViewReader(m_data + m_offset, len);
+			m_offset += len;
+			return true;
+		}
+};
+
+/*
+ * Read-only private mapping of the whole file
+ * */
+class BinaryMappedFile {
+	protected:
+		void *m_addr = nullptr;
+		size_t m_size = 0;
+	public:
+		BinaryMappedFile() { }
+		~BinaryMappedFile();
+		
+		BinaryMappedFile(const BinaryMappedFile &) = delete;
+		BinaryMappedFile &operator=(const BinaryMappedFile &) = delete;
+		
+		bool map(int fd);
+		void unmap();
+		
+		inline BinaryViewReader reader() const {
+			return BinaryViewReader(reinterpret_cast<const uint8_t *>(m_addr), m_size);
+		}
+		
+		inline size_t size() const {
+			return m_size;
+		}
+};
@@ -1,5 +1,6 @@
 #include "Blobmsg.h"
 #include "Log.h"
+#include "Utils.h"
 
 void blobmsgElementToJson(blob_attr *src, json &dst) {
 	if (!blobmsg_check_attr(src, false)) {
@@ -157,3 +158,88 @@ void blobmsgElementFromJson(blob_buf *dst, const char *key, const json &value) {
 		break;
 	}
 }
+
+/*
+ * BlobReader
+ * */
+blob_attr *BlobReader::find(const char *key) const {
+	blob_attr *pos;
+	size_t rem = m_len;
+	__blob_for_each_attr(pos, m_data, rem) {
+		if (blobmsg_check_attr(pos, true) && strcmp(blobmsg_name(pos), key) == 0)
+			return pos;
+	}
+	return nullptr;
+}
+
+std::string BlobReader::getStr(const char *key, const std::string &default_value) const {
+	std::string_view value;
+	if (!toStr(find(key), &value))
+		return default_value;
+	return std::string(value);
+}
+
+int64_t BlobReader::getInt(const char *key, int64_t default_value) const {
+	int64_t value;
+	if (!toInt(find(key), &value))
+		return default_value;
+	return value;
+}
+
+bool BlobReader::getBool(const char *key, bool default_value) const {
+	bool value;
+	if (!toBool(find(key), &value))
+		return default_value;
+	return value;
+}
+
+BlobReader BlobReader::getList(const char *key) const {
+	blob_attr *attr = find(key);
+	if (!attr || (blobmsg_type(attr) != BLOBMSG_TYPE_TABLE && blobmsg_type(attr) != BLOBMSG_TYPE_ARRAY))
+		return BlobReader();
+	return BlobReader(attr);
+}
+
+bool BlobReader::toStr(blob_attr *attr, std::string_view *value) {
+	if (!attr || blobmsg_type(attr) != BLOBMSG_TYPE_STRING)
+		return false;
+	*value = std::string_view(static_cast<const char *>(blobmsg_data(attr)), blobmsg_data_len(attr) - 1);
+	return true;
+}
+
+bool BlobReader::toInt(blob_attr *attr, int64_t *value) {
+	if (!attr)
+		return false;
+	
+	switch (blobmsg_type(attr)) {
+		case BLOBMSG_TYPE_INT16:
+			*value = static_cast<int16_t>(blobmsg_get_u16(attr));
+		return true;
+		
+		case BLOBMSG_TYPE_INT32:
+			*value = static_cast<int32_t>(blobmsg_get_u32(attr));
+		return true;
+		
+		case BLOBMSG_TYPE_INT64:
+			*value = static_cast<int64_t>(blobmsg_get_u64(attr));
+		return true;
+		
+		case BLOBMSG_TYPE_DOUBLE:
+			*value = static_cast<int64_t>(blobmsg_get_double(attr));
+		return true;
+		
+		// Numbers from shell scripts often are strings
+		case BLOBMSG_TYPE_STRING:
+			*value = strToInt(blobmsg_get_string(attr), 10, 0);
+		return true;
+	}
+	
+	return false;
+}
+
+bool BlobReader::toBool(blob_attr *attr, bool *value) {
+	if (!attr || blobmsg_type(attr) != BLOBMSG_TYPE_BOOL)
+		return false;
+	*value = blobmsg_get_bool(attr);
+	return true;
+}
@@ -2,10 +2,177 @@
 
 #include "Json.h"
 
+#include <cmath>
+#include <string>
+#include <cstring>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
 extern "C" {
 #include <libubox/blobmsg.h>
 };
 
+/*
+ * Streaming blobmsg writer which owns buffer.
+ * Can be filled outside of ubus thread and then sent as is.
+ * */
+class BlobWriter {
+	protected:
+		blob_buf m_buf = {};
+	public:
+		BlobWriter() {
+			blob_buf_init(&m_buf, 0);
+		}
+		
+		~BlobWriter() {
+			blob_buf_free(&m_buf);
+		}
+		
+		BlobWriter(const BlobWriter &) = delete;
+		BlobWriter &operator=(const BlobWriter &) = delete;
+		
+		inline blob_buf *buf() {
+			return &m_buf;
+		}
+		
+		inline blob_attr *head() const {
+			return m_buf.head;
+		}
+		
+		inline void *openTable(const char *key) {
+			return blobmsg_open_table(&m_buf, key);
+		}
+		
+		inline void closeTable(void *cookie) {
+			blobmsg_close_table(&m_buf, cookie);
+		}
+		
+		inline void *openArray(const char *key) {
+			return blobmsg_open_array(&m_buf, key);
+		}
+		
+		inline void closeArray(void *cookie) {
+			blobmsg_close_array(&m_buf, cookie);
+		}
+		
+		template <typename F>
+		inline void table(const char *key, F callback) {
+			void *cookie = openTable(key);
+			callback();
+			closeTable(cookie);
+		}
+		
+		template <typename F>
+		inline void array(const char *key, F callback) {
+			void *cookie = openArray(key);
+			callback();
+			closeArray(cookie);
+		}
+		
+		inline void addNull(const char *key) {
+			blobmsg_add_field(&m_buf, BLOBMSG_TYPE_UNSPEC, key, nullptr, 0);
+		}
+		
+		inline void add(const char *key, bool value) {
+			blobmsg_add_u8(&m_buf, key, value ? 1 : 0);
+		}
+		
+		inline void add(const char *key, std::string_view value) {
+			char *str = static_cast<char *>(blobmsg_alloc_string_buffer(&m_buf, key, value.size() + 1));
+			memcpy(str, value.data(), value.size());
+			str[value.size()] = 0;
+			blobmsg_add_string_buffer(&m_buf);
+		}
+		
+		inline void add(const char *key, const std::string &value) {
+			blobmsg_add_field(&m_buf, BLOBMSG_TYPE_STRING, key, value.c_str(), value.size() + 1);
+		}
+		
+		inline void add(const char *key, const char *value) {
+			blobmsg_add_string(&m_buf, key, value);
+		}
+		
+		// NaN is null
+		inline void add(const char *key, double value) {
+			if (std::isnan(value)) {
+				addNull(key);
+			} else {
+				blobmsg_add_double(&m_buf, key, value);
+			}
+		}
+		
+		inline void add(const char *key, float value) {
+			add(key, static_cast<double>(value));
+		}
+		
+		// Integers and enums: int32 when value fits, otherwise int64
+		template <typename T, typename std::enable_if_t<std::is_integral_v<T> || std::is_enum_v<T>, int> = 0>
+		inline void add(const char *key, T value) {
+			if constexpr (std::is_enum_v<T>) {
+				add(key, static_cast<std::underlying_type_t<T>>(value));
+			} else if constexpr (std::is_signed_v<T>) {
+				if (value >= INT32_MIN && value <= INT32_MAX) {
+					blobmsg_add_u32(&m_buf, key, static_cast<uint32_t>(value));
+				} else {
+					blobmsg_add_u64(&m_buf, key, static_cast<uint64_t>(value));
+				}
+			} else {
+				if (value <= INT32_MAX) {
+					blobmsg_add_u32(&m_buf, key, static_cast<uint32_t>(value));
+				} else {
+					blobmsg_add_u64(&m_buf, key, static_cast<uint64_t>(value));
+				}
+			}
+		}
+};
+
+/*
+ * Reader for blobmsg table or array without converting it to json
+ * */
+class BlobReader {
+	protected:
+		blob_attr *m_data = nullptr;
+		size_t m_len = 0;
+	public:
+		BlobReader() { }
+		
+		// Message or table/array attribute
+		explicit BlobReader(blob_attr *attr) {
+			if (attr) {
+				m_data = static_cast<blob_attr *>(blobmsg_data(attr));
+				m_len = blobmsg_data_len(attr);
+			}
+		}
+		
+		blob_attr *find(const char *key) const;
+		
+		inline bool has(const char *key) const {
+			return find(key) != nullptr;
+		}
+		
+		std::string getStr(const char *key, const std::string &default_value = "") const;
+		int64_t getInt(const char *key, int64_t default_value = 0) const;
+		bool getBool(const char *key, bool default_value = false) const;
+		
+		// Nested table or array, empty when not found
+		BlobReader getList(const char *key) const;
+		
+		template <typename F>
+		inline void each(F callback) const {
+			blob_attr *pos;
+			size_t rem = m_len;
+			__blob_for_each_attr(pos, m_data, rem) {
+				if (blobmsg_check_attr(pos, false))
+					callback(pos);
+			}
+		}
+		
+		static bool toStr(blob_attr *attr, std::string_view *value);
+		static bool toInt(blob_attr *attr, int64_t *value);
+		static bool toBool(blob_attr *attr, bool *value);
+};
+
 void blobmsgToJson(blob_attr *src, json &dst, bool list = true);
 inline void blobmsgToJson(blob_buf *src, json &dst, bool list = true) {
 	blobmsgToJson(src->head, dst, list);
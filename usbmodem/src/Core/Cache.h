@@ -0,0 +1,84 @@
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <optional>
+
+#include "Utils.h"
+
+/*
+ * Cached value with TTL and invalidating events (e.g. URC prefixes).
+ * Value is read and written on one thread, invalidate() can be called from any thread.
+ * */
+class CacheBase {
+	public:
+		enum State {
+			CACHE_EMPTY,		// no value or invalidated, must be fetched
+			CACHE_FRESH,
+			CACHE_STALE,		// TTL expired, can be served while refreshing
+		};
+	protected:
+		int m_ttl;
+		std::vector<std::string> m_events;
+		std::atomic<uint32_t> m_generation = 0;
+		uint32_t m_value_generation = 0;
+		int64_t m_time = 0;
+		bool m_has_value = false;
+		bool m_refreshing = false;
+	public:
+		// ttl in ms, 0 - until invalidated
+		CacheBase(int ttl, const std::vector<std::string> &events) : m_ttl(ttl), m_events(events) { }
+		
+		CacheBase(const CacheBase &) = delete;
+		CacheBase &operator=(const CacheBase &) = delete;
+		
+		inline const std::vector<std::string> &events() const {
+			return m_events;
+		}
+		
+		inline void invalidate() {
+			m_generation++;
+		}
+		
+		// Taken before fetch, so value fetched during invalidation is not marked as valid
+		inline uint32_t generation() const {
+			return m_generation;
+		}
+		
+		inline State state() const {
+			if (!m_has_value || m_value_generation != m_generation)
+				return CACHE_EMPTY;
+			if (m_ttl > 0 && getCurrentTimestamp() - m_time >= m_ttl)
+				return CACHE_STALE;
+			return CACHE_FRESH;
+		}
+		
+		inline bool isRefreshing() const {
+			return m_refreshing;
+		}
+		
+		inline void setRefreshing(bool refreshing) {
+			m_refreshing = refreshing;
+		}
+};
+
+template <typename T>
+class Cache: public CacheBase {
+	protected:
+		T m_value = {};
+	public:
+		Cache(int ttl, const std::vector<std::string> &events = {}) : CacheBase(ttl, events) { }
+		
+		inline const T &value() const {
+			return m_value;
+		}
+		
+		inline void set(const T &value, uint32_t generation) {
+			m_value = value;
+			m_value_generation = generation;
+			m_time = getCurrentTimestamp();
+			m_has_value = true;
+		}
+};
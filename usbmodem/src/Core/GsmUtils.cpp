@@ -2,6 +2,10 @@
 #include "Log.h"
 #include "Utils.h"
 #include <map>
+#include <array>
+#include <vector>
+#include <cstring>
+#include <unordered_map>
 
 // Default GSM 7bit charset
 static const uint16_t GSM7_TO_UNICODE[] = {
@@ -16,16 +20,117 @@ static const uint16_t GSM7_TO_UNICODE[] = {
 };
 
 // Default GSM 7bit charset (extended)
-static const std::map<uint8_t, uint16_t> GSM7_TO_UNICODE_EXT = {
+static const std::pair<uint8_t, uint16_t> GSM7_TO_UNICODE_EXT[] = {
 	{0x0A, 0x000C}, {0x14, 0x005E}, {0x1B, 0x0020}, {0x28, 0x007B},
 	{0x29, 0x007D}, {0x2F, 0x005C}, {0x3C, 0x005B}, {0x3D, 0x007E},
 	{0x3E, 0x005D}, {0x40, 0x007C}, {0x65, 0x20AC}
 };
 
+// Precomputed UTF-8 for each GSM 7bit char, len=0 means no char in table
+struct Utf8Char {
+	uint8_t len;
+	char bytes[3];
+};
+
+static constexpr Utf8Char makeUtf8Char(uint16_t value) {
+	if (value < 0x80)
+		return {1, {static_cast<char>(value), 0, 0}};
+	if (value < 0x800)
+		return {2, {static_cast<char>((value >> 6) | 0xC0), static_cast<char>((value & 0x3F) | 0x80), 0}};
+	return {3, {static_cast<char>((value >> 12) | 0xE0), static_cast<char>(((value >> 6) & 0x3F) | 0x80), static_cast<char>((value & 0x3F) | 0x80)}};
+}
+
+static const auto GSM7_TO_UTF8 = []() {
+	std::array<Utf8Char, 128> table = {};
+	for (size_t i = 0; i < table.size(); i++)
+		table[i] = makeUtf8Char(GSM7_TO_UNICODE[i]);
+	return table;
+}();
+
+static const auto GSM7_TO_UTF8_EXT = []() {
+	std::array<Utf8Char, 128> table = {};
+	for (auto &it: GSM7_TO_UNICODE_EXT)
+		table[it.first] = makeUtf8Char(it.second);
+	return table;
+}();
+
+static inline char *writeUtf8Char(char *out, const Utf8Char &c) {
+	// Always copy 3 bytes, output buffer has enough space
+	memcpy(out, c.bytes, 3);
+	return out + c.len;
+}
+
+// Reads bytes from hex string, invalid chars are accumulated in the high nibble of `invalid`
+struct HexBytes {
+	const uint8_t *hex;
+	mutable uint8_t invalid = 0;
+	
+	inline uint8_t operator[](size_t i) const {
+		uint8_t upper = HEX_TO_NIBBLE[hex[i * 2]];
+		uint8_t lower = HEX_TO_NIBBLE[hex[i * 2 + 1]];
+		invalid |= upper | lower;
+		return (upper << 4) | lower;
+	}
+};
+
+/*
+ * Unpack GSM 7bit chars and call callback for each char.
+ * Fast path decodes 8 septets from each 7 bytes.
+ * `data` is a raw byte pointer or HexBytes.
+ * */
+template <typename Bytes, typename T>
+static inline void forEachSeptet(const Bytes &data, size_t len, size_t max_chars, T callback) {
+	size_t total_chars = std::min(max_chars, len * 8 / 7);
+	size_t i = 0;
+	
+	for (size_t off = 0; total_chars - i >= 8; off += 7, i += 8) {
+		uint64_t v = static_cast<uint64_t>(data[off]) | static_cast<uint64_t>(data[off + 1]) << 8 |
+			static_cast<uint64_t>(data[off + 2]) << 16 | static_cast<uint64_t>(data[off + 3]) << 24 |
+			static_cast<uint64_t>(data[off + 4]) << 32 | static_cast<uint64_t>(data[off + 5]) << 40 |
+			static_cast<uint64_t>(data[off + 6]) << 48;
+		
+		for (int j = 0; j < 8; j++)
+			callback(static_cast<uint8_t>((v >> (j * 7)) & 0x7F));
+	}
+	
+	for (; i < total_chars; i++) {
+		size_t bit_off = i * 7;
+		size_t byte_off = bit_off / 8;
+		
+		uint8_t shift = bit_off % 8;
+		uint8_t size = std::min(7, 8 - shift);
+		
+		uint8_t value = (data[byte_off] >> shift) & ((1 << size) - 1);
+		
+		if (size < 7 && byte_off + 1 < len)
+			value |= (data[byte_off + 1] & ((1 << (7 - size)) - 1)) << size;
+		
+		callback(value);
+	}
+}
+
+// Unicode to GSM 7bit char, extended chars are 0x1B00 | char
+static const auto UNICODE_TO_GSM7 = []() {
+	std::unordered_map<uint32_t, uint16_t> table;
+	for (auto &it: GSM7_TO_UNICODE_EXT) {
+		if (it.first != 0x1B)
+			table[it.second] = 0x1B00 | it.first;
+	}
+	for (size_t i = 0; i < COUNT_OF(GSM7_TO_UNICODE); i++) {
+		if (i != 0x1B)
+			table[GSM7_TO_UNICODE[i]] = i;
+	}
+	return table;
+}();
+
 static constexpr uint8_t decodeDateField(uint8_t value) {
 	return ((value & 0xF) * 10) + (value >> 4);
 }
 
+static constexpr uint8_t encodeDateField(uint8_t value) {
+	return ((value % 10) << 4) | (value / 10);
+}
+
 bool decodePduAddr(BinaryBufferReader *parser, PduAddr *addr, bool is_smsc) {
 	uint8_t addr_len;
 	if (!parser->readUInt8(&addr_len))
@@ -55,7 +160,7 @@ bool decodePduAddr(BinaryBufferReader *parser, PduAddr *addr, bool is_smsc) {
 	
 	if (addr->type == PDU_ADDR_ALPHANUMERIC) {
 		uint8_t chars_n = is_smsc ? byte_len * 8 / 7 : addr_len * 4 / 7;
-		addr->number = convertGsmToUtf8(unpack7bit(raw_number, chars_n));
+		addr->number = decodeGsm7ToUtf8(raw_number, chars_n);
 	} else {
 		addr->number = decodeBcd(raw_number);
 	}
@@ -385,6 +490,285 @@ int decodeUserDataHeader(const std::string &data, PduUserDataHeader *header) {
 	return parser.offset();
 }
 
+bool encodePduAddr(BinaryBufferWriter *writer, const PduAddr &addr, bool is_smsc) {
+	if (!addr.number.size())
+		return writer->writeUInt8(0);
+	
+	uint8_t addr_type = 0x80 | ((addr.type & 0x7) << 4) | (addr.plan & 0xF);
+	
+	std::string raw_number;
+	size_t digits;
+	
+	if (addr.type == PDU_ADDR_ALPHANUMERIC) {
+		auto [success, septets] = convertUtf8ToGsm(addr.number);
+		if (!success)
+			return false;
+		raw_number = pack7bit(septets);
+		digits = (septets.size() * 7 + 3) / 4;
+	} else {
+		bool success;
+		std::tie(success, raw_number) = encodeBcd(addr.number);
+		if (!success)
+			return false;
+		digits = addr.number.size();
+	}
+	
+	// When is_smsc=true mean total bytes for address + one type byte
+	// When is_smsc=false mean total semi-octets (4 bit) in address
+	size_t addr_len = is_smsc ? raw_number.size() + 1 : digits;
+	if (addr_len > 0xFF)
+		return false;
+	
+	if (!writer->writeUInt8(addr_len))
+		return false;
+	if (!writer->writeUInt8(addr_type))
+		return false;
+	if (!writer->writeString(raw_number))
+		return false;
+	
+	return true;
+}
+
+bool encodePduDateTime(BinaryBufferWriter *writer, const PduDateTime *dt) {
+	time_t local_time = dt->timestamp + dt->tz;
+	
+	struct tm sms_time = {};
+	if (!gmtime_r(&local_time, &sms_time))
+		return false;
+	
+	uint8_t tz_quarters = std::abs(dt->tz) / (15 * 60);
+	uint8_t raw_tz = encodeDateField(tz_quarters) | (dt->tz < 0 ? (1 << 3) : 0);
+	
+	return writer->writeUInt8(encodeDateField(sms_time.tm_year % 100)) &&
+		writer->writeUInt8(encodeDateField(sms_time.tm_mon + 1)) &&
+		writer->writeUInt8(encodeDateField(sms_time.tm_mday)) &&
+		writer->writeUInt8(encodeDateField(sms_time.tm_hour)) &&
+		writer->writeUInt8(encodeDateField(sms_time.tm_min)) &&
+		writer->writeUInt8(encodeDateField(sms_time.tm_sec)) &&
+		writer->writeUInt8(raw_tz);
+}
+
+bool encodePduValidityPeriodFormat(BinaryBufferWriter *writer, PduValidityPeriodFormat vpf, const PduValidityPeriod *vp) {
+	switch (vpf) {
+		case PDU_VPF_ABSENT:
+			// None
+			return true;
+		break;
+		
+		case PDU_VPF_ENHANCED:
+			return writer->write(vp->enhanced, sizeof(vp->enhanced));
+		break;
+		
+		case PDU_VPF_RELATIVE:
+			return writer->writeUInt8(vp->relative);
+		break;
+		
+		case PDU_VPF_ABSOLUTE:
+			return encodePduDateTime(writer, &vp->absolute);
+		break;
+	}
+	return false;
+}
+
+bool encodePduSubmit(BinaryBufferWriter *writer, const Pdu *pdu) {
+	auto &submit = pdu->submit();
+	
+	uint8_t flags = (PDU_TYPE_SUBMIT & 0x3);
+	if (submit.rd)
+		flags |= (1 << 2);
+	flags |= (submit.vpf & 0x3) << 3;
+	if (submit.srr)
+		flags |= (1 << 5);
+	if (submit.udhi)
+		flags |= (1 << 6);
+	if (submit.rp)
+		flags |= (1 << 7);
+	
+	if (submit.data.size() > getPduMaxDataSize(pdu->type))
+		return false;
+	
+	// PDU type
+	if (!writer->writeUInt8(flags))
+		return false;
+	
+	// Message Reference
+	if (!writer->writeUInt8(submit.mr))
+		return false;
+	
+	// Receiver address
+	if (!encodePduAddr(writer, submit.dst, false))
+		return false;
+	
+	// Protocol ID
+	if (!writer->writeUInt8(submit.pid))
+		return false;
+	
+	// Data Coding Scheme
+	if (!writer->writeUInt8(submit.dcs))
+		return false;
+	
+	// Validity Period
+	if (!encodePduValidityPeriodFormat(writer, submit.vpf, &submit.vp))
+		return false;
+	
+	// User data length
+	if (!writer->writeUInt8(submit.udl))
+		return false;
+	
+	// User Data
+	if (!writer->writeString(submit.data))
+		return false;
+	
+	return true;
+}
+
+bool encodePdu(BinaryBufferWriter *writer, const Pdu *pdu) {
+	// SMSC
+	if (!encodePduAddr(writer, pdu->smsc, true))
+		return false;
+	
+	switch (pdu->type) {
+		case PDU_TYPE_SUBMIT:
+			return encodePduSubmit(writer, pdu);
+		break;
+	}
+	
+	return false;
+}
+
+std::string encodeUserDataHeader(const PduUserDataHeader *header) {
+	std::string out(1, '\0');
+	
+	if (header->concatenated) {
+		auto &c = *header->concatenated;
+		if (c.ref_id > 0xFF) {
+			// Concatenated short messages, 16-bit reference number
+			out += {0x08, 0x04, static_cast<char>(c.ref_id >> 8), static_cast<char>(c.ref_id & 0xFF)};
+		} else {
+			// Concatenated short messages, 8-bit reference number
+			out += {0x00, 0x03, static_cast<char>(c.ref_id)};
+		}
+		out += {static_cast<char>(c.parts), static_cast<char>(c.part)};
+	}
+	
+	if (header->app_port) {
+		auto &p = *header->app_port;
+		// Application port addressing scheme, 16 bit address
+		out += {0x05, 0x04, static_cast<char>(p.dst >> 8), static_cast<char>(p.dst & 0xFF), static_cast<char>(p.src >> 8), static_cast<char>(p.src & 0xFF)};
+	}
+	
+	out[0] = static_cast<char>(out.size() - 1);
+	return out;
+}
+
+PduAddr parsePduAddr(const std::string &number) {
+	PduAddr addr;
+	if (number.size() > 0 && number[0] == '+') {
+		addr.number = number.substr(1);
+		addr.type = PDU_ADDR_INTERNATIONAL;
+		addr.plan = PDU_ADDR_PLAN_ISDN;
+	} else {
+		addr.number = number;
+		addr.type = PDU_ADDR_UNKNOWN;
+		addr.plan = PDU_ADDR_PLAN_ISDN;
+	}
+	return addr;
+}
+
+// Max chars in one message
+static constexpr size_t getSmsPartMaxChars(GsmEncoding encoding, bool multipart) {
+	if (encoding == GSM_ENC_7BIT)
+		return multipart ? 153 : 160;
+	return multipart ? 134 : 140;
+}
+
+std::tuple<bool, std::vector<SmsSubmitPdu>> encodeSmsSubmit(const std::string &dst, const std::string &text, uint8_t ref_id, bool status_report) {
+	PduAddr addr = parsePduAddr(dst);
+	if (!addr.number.size())
+		return {false, {}};
+	
+	// Prefer GSM 7bit, when all chars can be encoded
+	auto [is_gsm, encoded] = convertUtf8ToGsm(text);
+	GsmEncoding encoding = is_gsm ? GSM_ENC_7BIT : GSM_ENC_UCS2;
+	if (!is_gsm)
+		encoded = convertUtf8ToUcs2(text);
+	
+	// Split text without breaking escape sequences or surrogate pairs
+	std::vector<std::string> chunks;
+	if (encoded.size() <= getSmsPartMaxChars(encoding, false)) {
+		chunks.push_back(encoded);
+	} else {
+		size_t max_chars = getSmsPartMaxChars(encoding, true);
+		size_t offset = 0;
+		
+		while (offset < encoded.size()) {
+			size_t len = std::min(max_chars, encoded.size() - offset);
+			
+			if (offset + len < encoded.size()) {
+				if (encoding == GSM_ENC_7BIT) {
+					if (encoded[offset + len - 1] == 0x1B)
+						len--;
+				} else {
+					uint8_t upper = encoded[offset + len - 2];
+					if (upper >= 0xD8 && upper <= 0xDB)
+						len -= 2;
+				}
+			}
+			
+			chunks.push_back(encoded.substr(offset, len));
+			offset += len;
+		}
+	}
+	
+	if (chunks.size() > 0xFF)
+		return {false, {}};
+	
+	std::vector<SmsSubmitPdu> result;
+	result.reserve(chunks.size());
+	
+	for (size_t i = 0; i < chunks.size(); i++) {
+		Pdu pdu = {};
+		pdu.type = PDU_TYPE_SUBMIT;
+		
+		auto &submit = pdu.payload.emplace<PduSubmit>();
+		submit.dst = addr;
+		submit.srr = status_report;
+		submit.dcs = (encoding == GSM_ENC_7BIT ? 0x00 : 0x08);
+		
+		std::string udh;
+		if (chunks.size() > 1) {
+			PduUserDataHeader header = {};
+			header.concatenated = {
+				.ref_id = ref_id,
+				.parts = static_cast<uint16_t>(chunks.size()),
+				.part = static_cast<uint16_t>(i + 1)
+			};
+			udh = encodeUserDataHeader(&header);
+			submit.udhi = true;
+		}
+		
+		if (encoding == GSM_ENC_7BIT) {
+			// Septets after UDH starts from septet boundary
+			size_t udh_septets = (udh.size() * 8 + 6) / 7;
+			submit.data = udh + pack7bit(chunks[i], udh_septets * 7 - udh.size() * 8);
+			submit.udl = udh_septets + chunks[i].size();
+		} else {
+			submit.data = udh + chunks[i];
+			submit.udl = submit.data.size();
+		}
+		
+		BinaryBufferWriter writer;
+		if (!encodePdu(&writer, &pdu))
+			return {false, {}};
+		
+		auto &part = result.emplace_back();
+		part.data.assign(reinterpret_cast<const char *>(writer.buffer()), writer.size());
+		part.tpdu_len = writer.size() - writer.buffer()[0] - 1;
+	}
+	
+	return {true, result};
+}
+
 bool decodePduData(const std::string &data, int dcs, std::string *out, PduUserDataHeader *header) {
 	
 	return false;
@@ -611,30 +995,20 @@ std::pair<bool, std::string> decodeSmsDcsData(const std::string &data, uint8_t u
 			return std::make_pair(false, "");
 	}
 	
-	std::string bytes;
-	if (udhl > 0) {
-		// Remove UDH from data
-		if (encoding == GSM_ENC_7BIT) {
-			size_t udhl_7bit = (udhl * 8 + 6) / 7;
-			bytes = unpack7bit(data, udl).substr(udhl_7bit);
-		} else {
-			bytes = data.substr(udhl);
-		}
-	} else {
-		bytes = (encoding == GSM_ENC_7BIT ? unpack7bit(data, udl) : data);
-	}
-	
+	// UDH is skipped while decoding, without copying data
 	switch (encoding) {
 		case GSM_ENC_7BIT:
-			return std::make_pair(true, convertGsmToUtf8(bytes));
+			return std::make_pair(true, decodeGsm7ToUtf8(data, udl, (udhl * 8 + 6) / 7));
 		break;
 		
 		case GSM_ENC_8BIT:
-			return std::make_pair(true, bytes);
+			return std::make_pair(true, data.substr(std::min(data.size(), static_cast<size_t>(udhl))));
 		break;
 		
 		case GSM_ENC_UCS2:
-			return convertUcs2ToUtf8(bytes, true);
+			if (static_cast<size_t>(udhl) > data.size())
+				return std::make_pair(true, "");
+			return convertUcs2ToUtf8(data.c_str() + udhl, data.size() - udhl, true);
 		break;
 	}
 	
@@ -656,7 +1030,7 @@ std::pair<bool, std::string> decodeCbsDcsString(const std::string &data, int dcs
 	
 	switch (encoding) {
 		case GSM_ENC_7BIT:
-			return std::make_pair(true, convertGsmToUtf8(unpack7bit(data)));
+			return std::make_pair(true, decodeGsm7ToUtf8(data, data.size() * 8 / 7));
 		break;
 		
 		case GSM_ENC_8BIT:
@@ -671,47 +1045,81 @@ std::pair<bool, std::string> decodeCbsDcsString(const std::string &data, int dcs
 	return std::make_pair(false, "");
 }
 
-bool strAppendCodepoint(std::string &out, uint32_t value) {
+std::pair<bool, std::string> decodeCbsDcsHexString(const std::string &hex, int dcs) {
+	GsmEncoding encoding;
+	GsmLanguage language;
+	bool compression;
+	bool has_iso_lang;
+	
+	if (!decodeCbsDcs(dcs, &encoding, &language, &compression, &has_iso_lang) || encoding != GSM_ENC_7BIT)
+		return decodeCbsDcsString(hex2bin(hex), dcs);
+	
+	// Not supported for USSD
+	if (compression || has_iso_lang)
+		return std::make_pair(false, "");
+	
+	// Unpack septets directly from hex, without intermediate binary string
+	auto [success, decoded] = decodeHexGsm7ToUtf8(hex, hex.size() * 4 / 7);
+	if (!success)
+		return decodeCbsDcsString(hex2bin(hex), dcs);
+	
+	return std::make_pair(true, std::move(decoded));
+}
+
+static inline size_t encodeUtf8(char *out, uint32_t value) {
 	if (value < 0x80) {
-		out += static_cast<char>(value);
+		out[0] = static_cast<char>(value);
+		return 1;
 	} else if (value < 0x800) {
-		out += static_cast<char>((value >> 6) | 0xC0);
-		out += static_cast<char>((value & 0x3F) | 0x80);
-	} else if (value < 0xFFFF) {
+		out[0] = static_cast<char>((value >> 6) | 0xC0);
+		out[1] = static_cast<char>((value & 0x3F) | 0x80);
+		return 2;
+	} else if (value <= 0xFFFF) {
 		if (value >= 0xDC00 && value <= 0xDFFF) {
 			// Invalid codepoint
-			return false;
+			return 0;
 		}
-		out += static_cast<char>((value >> 12) | 0xE0);
-		out += static_cast<char>(((value >> 6) & 0x3F) | 0x80);
-		out += static_cast<char>((value & 0x3F) | 0x80);
-	} else if (value < 0x10FFFF) {
-		out += static_cast<char>((value >> 18) | 0xF0);
-		out += static_cast<char>(((value >> 12) & 0x3F) | 0x80);
-		out += static_cast<char>(((value >> 6) & 0x3F) | 0x80);
-		out += static_cast<char>((value & 0x3F) | 0x80);
-	} else {
-		// Invalid codepoint
-		return false;
+		out[0] = static_cast<char>((value >> 12) | 0xE0);
+		out[1] = static_cast<char>(((value >> 6) & 0x3F) | 0x80);
+		out[2] = static_cast<char>((value & 0x3F) | 0x80);
+		return 3;
+	} else if (value <= 0x10FFFF) {
+		out[0] = static_cast<char>((value >> 18) | 0xF0);
+		out[1] = static_cast<char>(((value >> 12) & 0x3F) | 0x80);
+		out[2] = static_cast<char>(((value >> 6) & 0x3F) | 0x80);
+		out[3] = static_cast<char>((value & 0x3F) | 0x80);
+		return 4;
 	}
+	// Invalid codepoint
+	return 0;
+}
+
+bool strAppendCodepoint(std::string &out, uint32_t value) {
+	char buf[4];
+	size_t len = encodeUtf8(buf, value);
+	if (!len)
+		return false;
+	out.append(buf, len);
 	return true;
 }
 
-std::pair<bool, std::string> convertUcs2ToUtf8(const std::string &data, bool be) {
-	if ((data.size() % 2) != 0) {
+std::pair<bool, std::string> convertUcs2ToUtf8(const char *data, size_t len, bool be) {
+	if ((len % 2) != 0) {
 		// Invalid size
 		return std::make_pair(false, "");
 	}
 	
+	// Each UCS-2 char is max 3 bytes in UTF-8, surrogate pair is 4 bytes
 	std::string out;
-	out.reserve(data.size());
+	out.resize(len / 2 * 3);
+	char *w = out.data();
 	
-	for (size_t i = 0; i < data.size(); i += 2) {
+	for (size_t i = 0; i < len; i += 2) {
 		uint16_t W1 = makeWideChar(data[i], data[i + 1], be);
 		uint32_t value;
 		
 		if (W1 >= 0xD800 && W1 <= 0xDBFF) {
-			if (i + 3 >= data.size()) {
+			if (i + 3 >= len) {
 				// Unexpected EOF
 				return std::make_pair(false, "");
 			}
@@ -728,68 +1136,202 @@ std::pair<bool, std::string> convertUcs2ToUtf8(const std::string &data, bool be)
 			value = W1;
 		}
 		
-		if (!strAppendCodepoint(out, value))
+		size_t n = encodeUtf8(w, value);
+		if (!n)
 			return std::make_pair(false, "");
-    }
+		w += n;
+	}
 	
+	out.resize(w - out.data());
 	return std::make_pair(true, out);
 }
 
-std::string convertGsmToUtf8(const std::string &data) {
+template <typename Bytes>
+static std::string decodeGsm7ToUtf8(const Bytes &data, size_t len, size_t max_chars, size_t skip_chars) {
+	size_t total_chars = std::min(max_chars, len * 8 / 7);
+	
+	// Each GSM char is max 3 bytes in UTF-8
 	std::string out;
-	out.reserve(data.size());
+	out.resize(total_chars * 3);
+	char *w = out.data();
 	
 	bool escape = false;
-	for (auto c: data) {
-		uint8_t byte = static_cast<uint8_t>(c);
+	size_t index = 0;
+	forEachSeptet(data, len, total_chars, [&](uint8_t c) {
+		if (index++ < skip_chars)
+			return;
+		
 		if (escape) {
-			auto found = GSM7_TO_UNICODE_EXT.find(byte);
-			if (found != GSM7_TO_UNICODE_EXT.cend()) {
-				strAppendCodepoint(out, found->second);
+			if (GSM7_TO_UTF8_EXT[c].len) {
+				w = writeUtf8Char(w, GSM7_TO_UTF8_EXT[c]);
 			} else {
-				out += ' ';
-				strAppendCodepoint(out, GSM7_TO_UNICODE[byte]);
+				*w++ = ' ';
+				w = writeUtf8Char(w, GSM7_TO_UTF8[c]);
 			}
 			escape = false;
+		} else if (c == 0x1B) {
+			escape = true;
 		} else {
-			if (byte > 0x7F) {
-				// Impossible worst case
-				// Replacement Character for any invalid GSM7
-				strAppendCodepoint(out, 0xFFFD);
-			} else if (byte == 0x1B) {
-				escape = true;
+			w = writeUtf8Char(w, GSM7_TO_UTF8[c]);
+		}
+	});
+	
+	if (escape)
+		*w++ = ' ';
+	
+	out.resize(w - out.data());
+	return out;
+}
+
+std::string decodeGsm7ToUtf8(const std::string &data, size_t max_chars, size_t skip_chars) {
+	const uint8_t *bytes = reinterpret_cast<const uint8_t *>(data.c_str());
+	return decodeGsm7ToUtf8(bytes, data.size(), max_chars, skip_chars);
+}
+
+std::pair<bool, std::string> decodeHexGsm7ToUtf8(const std::string &hex, size_t max_chars, size_t skip_chars) {
+	if ((hex.size() % 2) != 0 || !hex.size())
+		return std::make_pair(false, "");
+	
+	HexBytes bytes = {reinterpret_cast<const uint8_t *>(hex.c_str())};
+	std::string out = decodeGsm7ToUtf8(bytes, hex.size() / 2, max_chars, skip_chars);
+	if ((bytes.invalid & 0xF0))
+		return std::make_pair(false, "");
+	return std::make_pair(true, std::move(out));
+}
+
+std::string convertGsmToUtf8(const std::string &data) {
+	std::string out;
+	out.resize(data.size() * 3);
+	char *w = out.data();
+	
+	bool escape = false;
+	for (auto ch: data) {
+		uint8_t c = static_cast<uint8_t>(ch);
+		if (c > 0x7F) {
+			if (escape)
+				*w++ = ' ';
+			
+			// Impossible worst case
+			// Replacement Character for any invalid GSM7
+			w += encodeUtf8(w, 0xFFFD);
+			escape = false;
+		} else if (escape) {
+			if (GSM7_TO_UTF8_EXT[c].len) {
+				w = writeUtf8Char(w, GSM7_TO_UTF8_EXT[c]);
 			} else {
-				strAppendCodepoint(out, GSM7_TO_UNICODE[byte]);
+				*w++ = ' ';
+				w = writeUtf8Char(w, GSM7_TO_UTF8[c]);
 			}
+			escape = false;
+		} else if (c == 0x1B) {
+			escape = true;
+		} else {
+			w = writeUtf8Char(w, GSM7_TO_UTF8[c]);
 		}
 	}
 	
 	if (escape)
-		out += ' ';
+		*w++ = ' ';
 	
+	out.resize(w - out.data());
 	return out;
 }
 
 std::string unpack7bit(const std::string &data, size_t max_chars) {
-	size_t total_chars = std::min(max_chars, data.size() * 8 / 7);
+	std::string out;
+	out.reserve(std::min(max_chars, data.size() * 8 / 7));
+	forEachSeptet(reinterpret_cast<const uint8_t *>(data.c_str()), data.size(), max_chars, [&out](uint8_t c) {
+		out += static_cast<char>(c);
+	});
+	return out;
+}
+
+// Read one UTF-8 char, invalid sequences are replaced with U+FFFD
+static uint32_t readUtf8Char(const std::string &data, size_t *offset) {
+	uint8_t c = data[(*offset)++];
+	
+	size_t len;
+	uint32_t value;
+	if (c < 0x80) {
+		return c;
+	} else if ((c & 0xE0) == 0xC0) {
+		len = 1;
+		value = c & 0x1F;
+	} else if ((c & 0xF0) == 0xE0) {
+		len = 2;
+		value = c & 0x0F;
+	} else if ((c & 0xF8) == 0xF0) {
+		len = 3;
+		value = c & 0x07;
+	} else {
+		return 0xFFFD;
+	}
+	
+	for (size_t i = 0; i < len; i++) {
+		if (*offset >= data.size() || (data[*offset] & 0xC0) != 0x80)
+			return 0xFFFD;
+		value = (value << 6) | (data[(*offset)++] & 0x3F);
+	}
 	
+	if (value > 0x10FFFF || (value >= 0xD800 && value <= 0xDFFF))
+		return 0xFFFD;
+	
+	return value;
+}
+
+std::pair<bool, std::string> convertUtf8ToGsm(const std::string &data) {
 	std::string out;
-	out.reserve(total_chars);
+	out.reserve(data.size());
 	
-	const uint8_t *bytes = reinterpret_cast<const uint8_t *>(data.c_str());
-	for (size_t i = 0; i < total_chars; i++) {
-		size_t bit_off = i * 7;
-		size_t byte_off = bit_off / 8;
+	size_t offset = 0;
+	while (offset < data.size()) {
+		auto found = UNICODE_TO_GSM7.find(readUtf8Char(data, &offset));
+		if (found == UNICODE_TO_GSM7.cend())
+			return std::make_pair(false, "");
 		
+		if ((found->second & 0x1B00))
+			out += static_cast<char>(0x1B);
+		out += static_cast<char>(found->second & 0x7F);
+	}
+	
+	return std::make_pair(true, out);
+}
+
+std::string convertUtf8ToUcs2(const std::string &data) {
+	std::string out;
+	out.reserve(data.size() * 2);
+	
+	size_t offset = 0;
+	while (offset < data.size()) {
+		uint32_t value = readUtf8Char(data, &offset);
+		if (value > 0xFFFF) {
+			// Surrogate pair
+			value -= 0x10000;
+			uint16_t W1 = 0xD800 | (value >> 10);
+			uint16_t W2 = 0xDC00 | (value & 0x3FF);
+			out += {static_cast<char>(W1 >> 8), static_cast<char>(W1 & 0xFF), static_cast<char>(W2 >> 8), static_cast<char>(W2 & 0xFF)};
+		} else {
+			out += {static_cast<char>(value >> 8), static_cast<char>(value & 0xFF)};
+		}
+	}
+	
+	return out;
+}
+
+std::string pack7bit(const std::string &data, size_t fill_bits) {
+	std::string out;
+	out.resize((fill_bits + data.size() * 7 + 7) / 8);
+	
+	uint8_t *bytes = reinterpret_cast<uint8_t *>(out.data());
+	for (size_t i = 0; i < data.size(); i++) {
+		size_t bit_off = fill_bits + i * 7;
+		size_t byte_off = bit_off / 8;
 		uint8_t shift = bit_off % 8;
-		uint8_t size = std::min(7, 8 - shift);
-		
-		uint8_t value = (bytes[byte_off] >> shift) & ((1 << size) - 1);
-		
-		if (size < 7)
-			value |= (bytes[byte_off + 1] & ((1 << (7 - size)) - 1)) << size;
+		uint8_t value = data[i] & 0x7F;
 		
-		out += static_cast<char>(value);
+		bytes[byte_off] |= value << shift;
+		if (shift > 1)
+			bytes[byte_off + 1] |= value >> (8 - shift);
 	}
 	
 	return out;
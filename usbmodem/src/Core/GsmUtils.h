@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 #include <optional>
 #include <tuple>
 #include <any>
@@ -203,6 +204,14 @@ struct Pdu {
 	}
 };
 
+struct SmsSubmitPdu {
+	// SMSC + TPDU
+	std::string data;
+	
+	// TPDU length for AT+CMGS, without SMSC
+	size_t tpdu_len = 0;
+};
+
 constexpr size_t getPduMaxDataSize(PduType type) {
 	switch (type) {
 		case PDU_TYPE_DELIVER:		return 140;
@@ -221,11 +230,24 @@ bool decodePduSubmit(BinaryBufferReader *parser, Pdu *pdu, uint8_t flags);
 size_t udlToBytes(uint8_t udl, int dcs);
 int decodeUserDataHeader(const std::string &data, PduUserDataHeader *header);
 
+bool encodePdu(BinaryBufferWriter *writer, const Pdu *pdu);
+bool encodePduAddr(BinaryBufferWriter *writer, const PduAddr &addr, bool is_smsc);
+bool encodePduDateTime(BinaryBufferWriter *writer, const PduDateTime *dt);
+bool encodePduValidityPeriodFormat(BinaryBufferWriter *writer, PduValidityPeriodFormat vpf, const PduValidityPeriod *vp);
+bool encodePduSubmit(BinaryBufferWriter *writer, const Pdu *pdu);
+std::string encodeUserDataHeader(const PduUserDataHeader *header);
+PduAddr parsePduAddr(const std::string &number);
+
+// Encode text to one or more SMS-SUBMIT PDU, with 7bit or UCS-2 and concatenation header
+std::tuple<bool, std::vector<SmsSubmitPdu>> encodeSmsSubmit(const std::string &dst, const std::string &text, uint8_t ref_id, bool status_report);
+
 // Data Coding
 bool isValidLanguage(GsmLanguage lang);
 bool decodeCbsDcs(int dcs, GsmEncoding *out_encoding, GsmLanguage *out_language, bool *out_compression, bool *out_has_iso_lang);
 bool decodeSmsDcs(int dcs, GsmEncoding *out_encoding, bool *out_compression);
 std::pair<bool, std::string> decodeCbsDcsString(const std::string &data, int dcs);
+// Same as decodeCbsDcsString, but input is hex (or raw data, if not valid hex)
+std::pair<bool, std::string> decodeCbsDcsHexString(const std::string &hex, int dcs);
 std::pair<bool, std::string> decodeSmsDcsData(const std::string &data, uint8_t udl, bool udhi, int dcs, PduUserDataHeader *header_out);
 std::pair<bool, std::string> decodeSmsDcsData(Pdu *pdu, PduUserDataHeader *header_out);
 
@@ -234,9 +256,19 @@ bool isValidUssd(const std::string &cmd);
 
 // Encodings
 bool strAppendCodepoint(std::string &out, uint32_t value);
-std::pair<bool, std::string> convertUcs2ToUtf8(const std::string &data, bool be);
+std::pair<bool, std::string> convertUcs2ToUtf8(const char *data, size_t len, bool be);
+inline std::pair<bool, std::string> convertUcs2ToUtf8(const std::string &data, bool be) {
+	return convertUcs2ToUtf8(data.c_str(), data.size(), be);
+}
 std::string convertGsmToUtf8(const std::string &data);
+// Unpack 7bit and convert GSM charset to UTF-8 in one pass
+std::string decodeGsm7ToUtf8(const std::string &data, size_t max_chars, size_t skip_chars = 0);
+// Same, but decodes hex nibbles in the unpack loop
+std::pair<bool, std::string> decodeHexGsm7ToUtf8(const std::string &hex, size_t max_chars, size_t skip_chars = 0);
 std::string unpack7bit(const std::string &data, size_t max_chars);
+std::string pack7bit(const std::string &data, size_t fill_bits = 0);
+std::pair<bool, std::string> convertUtf8ToGsm(const std::string &data);
+std::string convertUtf8ToUcs2(const std::string &data);
 inline std::string unpack7bit(const std::string &data) {
 	return unpack7bit(data, data.size() * 8 / 7);
 }
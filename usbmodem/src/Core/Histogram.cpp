@@ -0,0 +1,53 @@
+#include "Histogram.h"
+
+#include <cmath>
+#include <algorithm>
+
+int Histogram::getBucket(uint64_t value) {
+	if (value < SUB_BUCKETS)
+		return static_cast<int>(value);
+	
+	int exp = 63 - __builtin_clzll(value);
+	if (exp >= MAX_EXP)
+		return BUCKETS - 1;
+	
+	int sub = (value >> (exp - SUB_BITS)) & (SUB_BUCKETS - 1);
+	return SUB_BUCKETS + (exp - SUB_BITS) * SUB_BUCKETS + sub;
+}
+
+uint64_t Histogram::getBucketMax(int bucket) {
+	if (bucket < SUB_BUCKETS)
+		return bucket;
+	
+	int exp = (bucket - SUB_BUCKETS) / SUB_BUCKETS + SUB_BITS;
+	uint64_t sub = (bucket - SUB_BUCKETS) % SUB_BUCKETS;
+	uint64_t min = (SUB_BUCKETS + sub) << (exp - SUB_BITS);
+	return min + (1ULL << (exp - SUB_BITS)) - 1;
+}
+
+void Histogram::add(uint64_t value) {
+	m_buckets[getBucket(value)]++;
+	m_count++;
+	m_sum += value;
+	m_max = std::max(m_max, value);
+}
+
+void Histogram::reset() {
+	*this = Histogram();
+}
+
+uint64_t Histogram::percentile(double p) const {
+	if (!m_count)
+		return 0;
+	
+	uint64_t target = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(p * m_count)));
+	uint64_t total = 0;
+	
+	for (int i = 0; i < BUCKETS; i++) {
+		total += m_buckets[i];
+		if (total >= target)
+			return std::min(getBucketMax(i), m_max);
+	}
+	
+	return m_max;
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+/*
+ * Log-linear histogram: exact values below 8, then 8 buckets per power of two (~12% error).
+ * Fixed size, so adding value never allocates.
+ * */
+class Histogram {
+	public:
+		static constexpr int SUB_BITS = 3;
+		static constexpr int SUB_BUCKETS = 1 << SUB_BITS;
+		static constexpr int MAX_EXP = 36;
+		static constexpr int BUCKETS = SUB_BUCKETS + (MAX_EXP - SUB_BITS) * SUB_BUCKETS;
+	protected:
+		uint32_t m_buckets[BUCKETS] = {};
+		uint64_t m_count = 0;
+		uint64_t m_sum = 0;
+		uint64_t m_max = 0;
+		
+		static int getBucket(uint64_t value);
+		static uint64_t getBucketMax(int bucket);
+	public:
+		void add(uint64_t value);
+		void reset();
+		
+		// Upper bound of the bucket with p-quantile (0.0 ... 1.0)
+		uint64_t percentile(double p) const;
+		
+		inline uint64_t count() const {
+			return m_count;
+		}
+		
+		inline uint64_t max() const {
+			return m_max;
+		}
+		
+		inline double mean() const {
+			return m_count > 0 ? static_cast<double>(m_sum) / m_count : 0;
+		}
+};
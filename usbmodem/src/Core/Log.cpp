@@ -1 +1,346 @@
+#include "Log.h"
+#include "MpscQueue.h"
+#include "Semaphore.h"
+#include "Utils.h"
 
+#include <ctime>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <cstdarg>
+#include <cstring>
+#include <algorithm>
+
+struct LogRateState {
+	std::atomic<int64_t> window = 0;
+	std::atomic<uint32_t> count = 0;
+	std::atomic<uint32_t> dropped = 0;
+};
+
+static MpscQueue<Log::Record> log_queue(Log::QUEUE_SIZE);
+static Semaphore log_sem;
+static std::thread log_thread;
+static std::atomic<bool> log_started = false;
+static std::atomic<bool> log_stop = false;
+static std::atomic<bool> log_sleeping = false;
+static std::atomic<uint32_t> log_lost = 0;
+
+static std::atomic<int> log_rate_limit = Log::DEFAULT_RATE_LIMIT;
+static LogRateState log_rate[LOG_CAT__MAX];
+
+static std::mutex trace_mutex;
+static std::string trace_path;
+static FILE *trace_fp = nullptr;
+
+static int64_t getUnixTimeUs() {
+	struct timespec tm = {};
+	clock_gettime(CLOCK_REALTIME, &tm);
+	return static_cast<int64_t>(tm.tv_sec) * 1000000 + tm.tv_nsec / 1000;
+}
+
+static FILE *openTraceFile(const std::string &path) {
+	FILE *fp = fopen(path.c_str(), "w");
+	if (!fp) {
+		fprintf(stderr, "error: can't open AT trace file %s\n", path.c_str());
+		return nullptr;
+	}
+	fwrite(Log::TRACE_MAGIC, 1, strlen(Log::TRACE_MAGIC), fp);
+	return fp;
+}
+
+bool Log::checkRateLimit(LogCategory category) {
+	int limit = log_rate_limit.load(std::memory_order_relaxed);
+	if (limit <= 0)
+		return true;
+	
+	auto &state = log_rate[category];
+	int64_t window = getCurrentTimestamp() / 1000;
+	int64_t current = state.window.load(std::memory_order_relaxed);
+	
+	if (current != window && state.window.compare_exchange_strong(current, window))
+		state.count = 0;
+	
+	if (state.count.fetch_add(1, std::memory_order_relaxed) < static_cast<uint32_t>(limit))
+		return true;
+	
+	state.dropped++;
+	return false;
+}
+
+void Log::write(LogCategory category, LogLevel level, const char *format, ...) {
+	va_list args;
+	
+	// Direct write, no limits
+	if (!log_started) {
+		va_start(args, format);
+		vfprintf(stderr, format, args);
+		va_end(args);
+		return;
+	}
+	
+	if (!checkRateLimit(category))
+		return;
+	
+	Record record;
+	record.type = RECORD_TEXT;
+	record.category = category;
+	record.dir = LOG_TRACE_TX;
+	record.flags = 0;
+	record.channel = 0;
+	record.time = 0;
+	
+	va_start(args, format);
+	int size = vsnprintf(record.data, sizeof(record.data), format, args);
+	va_end(args);
+	
+	if (size < 0)
+		return;
+	
+	if (size >= static_cast<int>(sizeof(record.data))) {
+		// Mark truncated message
+		size = sizeof(record.data) - 1;
+		memcpy(record.data + size - 4, "...\n", 4);
+	}
+	
+	record.size = size;
+	push(&record);
+}
+
+void Log::trace(uint8_t channel, LogTraceDir dir, const char *data, size_t size) {
+	if (!log_started)
+		return;
+	
+	int64_t time = getUnixTimeUs();
+	size_t offset = 0;
+	
+	do {
+		size_t chunk = std::min(size - offset, MAX_RECORD_DATA);
+		
+		Record record;
+		record.type = RECORD_TRACE;
+		record.category = LOG_CAT_AT;
+		record.dir = dir;
+		record.flags = offset + chunk < size ? TRACE_MORE : 0;
+		record.channel = channel;
+		record.time = time;
+		record.size = chunk;
+		memcpy(record.data, data + offset, chunk);
+		push(&record);
+		
+		offset += chunk;
+	} while (offset < size);
+}
+
+void Log::push(Record *record) {
+	if (!log_queue.push(std::move(*record))) {
+		log_lost++;
+		return;
+	}
+	
+	if (log_sleeping.exchange(false))
+		log_sem.post();
+}
+
+void Log::writeRecord(const Record &record) {
+	if (record.type == RECORD_TEXT) {
+		fwrite(record.data, 1, record.size, stderr);
+		return;
+	}
+	
+	std::lock_guard<std::mutex> lock(trace_mutex);
+	if (!trace_fp)
+		return;
+	
+	TraceFrame frame;
+	frame.time = record.time;
+	frame.channel = record.channel;
+	frame.dir = record.dir;
+	frame.flags = record.flags;
+	frame.size = record.size;
+	fwrite(&frame, 1, sizeof(frame), trace_fp);
+	fwrite(record.data, 1, record.size, trace_fp);
+	
+	// Rotate only on frame boundary
+	if (!(record.flags & TRACE_MORE) && ftell(trace_fp) > MAX_TRACE_SIZE) {
+		fclose(trace_fp);
+		rename(trace_path.c_str(), (trace_path + ".old").c_str());
+		trace_fp = openTraceFile(trace_path);
+	}
+}
+
+void Log::writeDropped() {
+	for (int i = 0; i < LOG_CAT__MAX; i++) {
+		uint32_t dropped = log_rate[i].dropped.exchange(0);
+		if (dropped > 0)
+			fprintf(stderr, "log: %u messages dropped by rate limit [%s]\n", dropped, getCategoryName(static_cast<LogCategory>(i)));
+	}
+	
+	uint32_t lost = log_lost.exchange(0);
+	if (lost > 0)
+		fprintf(stderr, "log: %u messages lost, queue is full\n", lost);
+}
+
+void Log::writerLoop() {
+	Record record;
+	
+	while (true) {
+		while (log_queue.pop(&record))
+			writeRecord(record);
+		
+		writeDropped();
+		fflush(stderr);
+		
+		trace_mutex.lock();
+		if (trace_fp)
+			fflush(trace_fp);
+		trace_mutex.unlock();
+		
+		if (log_stop)
+			break;
+		
+		// Producers wake up writer only when it sleeps
+		log_sleeping = true;
+		if (!log_queue.empty() || log_stop) {
+			log_sleeping = false;
+			continue;
+		}
+		
+		log_sem.wait(1000);
+		log_sleeping = false;
+	}
+}
+
+void Log::start() {
+	if (log_started)
+		return;
+	
+	log_stop = false;
+	log_thread = std::thread(writerLoop);
+	log_started = true;
+}
+
+void Log::stop() {
+	if (!log_started)
+		return;
+	
+	// New messages are written directly, writer drains the queue
+	log_started = false;
+	log_stop = true;
+	log_sem.post();
+	log_thread.join();
+	
+	setTraceFile("");
+}
+
+void Log::setLevel(LogCategory category, LogLevel level) {
+	m_levels[category] = level;
+}
+
+void Log::setRateLimit(int limit) {
+	log_rate_limit = limit;
+}
+
+bool Log::setTraceFile(const std::string &path) {
+	std::lock_guard<std::mutex> lock(trace_mutex);
+	
+	// Service restart, keep current trace
+	if (path.size() && path == trace_path && trace_fp)
+		return true;
+	
+	if (trace_fp) {
+		fclose(trace_fp);
+		trace_fp = nullptr;
+	}
+	
+	trace_path = path;
+	
+	if (path.size())
+		trace_fp = openTraceFile(path);
+	
+	m_trace = trace_fp != nullptr;
+	
+	return !path.size() || trace_fp != nullptr;
+}
+
+bool Log::parseLevel(const std::string &name, LogLevel *level) {
+	static const char *names[] = {"none", "error", "info", "debug"};
+	for (size_t i = 0; i < COUNT_OF(names); i++) {
+		if (name == names[i]) {
+			*level = static_cast<LogLevel>(i);
+			return true;
+		}
+	}
+	return false;
+}
+
+const char *Log::getCategoryName(LogCategory category) {
+	switch (category) {
+		case LOG_CAT_CORE:	return "core";
+		case LOG_CAT_AT:	return "at";
+		case LOG_CAT_SMS:	return "sms";
+		case LOG_CAT_NET:	return "net";
+		case LOG_CAT_UBUS:	return "ubus";
+		case LOG_CAT__MAX:	return "unknown";
+	}
+	return "unknown";
+}
+
+int Log::printTrace(const std::string &path) {
+	FILE *fp = fopen(path.c_str(), "r");
+	if (!fp) {
+		fprintf(stderr, "error: can't open %s\n", path.c_str());
+		return 1;
+	}
+	
+	char magic[sizeof(TRACE_MAGIC) - 1];
+	if (fread(magic, 1, sizeof(magic), fp) != sizeof(magic) || memcmp(magic, TRACE_MAGIC, sizeof(magic)) != 0) {
+		fprintf(stderr, "error: %s is not AT trace file\n", path.c_str());
+		fclose(fp);
+		return 1;
+	}
+	
+	// Frames of one channel and direction are written by one thread, so continuation is always for the same pair
+	std::map<std::pair<int, int>, std::string> pending;
+	TraceFrame frame;
+	char buffer[MAX_RECORD_DATA];
+	
+	while (fread(&frame, 1, sizeof(frame), fp) == sizeof(frame)) {
+		if (frame.dir > LOG_TRACE_RX || frame.size > sizeof(buffer) || fread(buffer, 1, frame.size, fp) != frame.size) {
+			fprintf(stderr, "error: %s is truncated\n", path.c_str());
+			break;
+		}
+		
+		auto &data = pending[{frame.channel, frame.dir}];
+		data.append(buffer, frame.size);
+		if ((frame.flags & TRACE_MORE))
+			continue;
+		
+		time_t sec = frame.time / 1000000;
+		struct tm tm = {};
+		localtime_r(&sec, &tm);
+		
+		char time_str[32];
+		strftime(time_str, sizeof(time_str), "%Y-%m-%d %H:%M:%S", &tm);
+		
+		std::string escaped;
+		for (unsigned char c: data) {
+			if (c == '\r') {
+				escaped += "\\r";
+			} else if (c == '\n') {
+				escaped += "\\n";
+			} else if (c == '\\') {
+				escaped += "\\\\";
+			} else if (c < 0x20 || c >= 0x7F) {
+				escaped += strprintf("\\x%02X", c);
+			} else {
+				escaped += c;
+			}
+		}
+		
+		printf("%s.%06d #%d %s %s\n", time_str, static_cast<int>(frame.time % 1000000), frame.channel, frame.dir == LOG_TRACE_TX ? ">>" : "<<", escaped.c_str());
+		data.clear();
+	}
+	
+	fclose(fp);
+	return 0;
+}
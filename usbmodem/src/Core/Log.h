@@ -1,6 +1,128 @@
 #pragma once
 
 #include <cstdio>
+#include <string>
+#include <atomic>
+#include <cstdint>
 
-#define LOGD(fmt, ...) fprintf(stderr, fmt, ##__VA_ARGS__)
-#define LOGE(fmt, ...) fprintf(stderr, "error: " fmt, ##__VA_ARGS__)
+enum LogLevel: uint8_t {
+	LOG_LEVEL_NONE		= 0,
+	LOG_LEVEL_ERROR		= 1,
+	LOG_LEVEL_INFO		= 2,
+	LOG_LEVEL_DEBUG		= 3,
+};
+
+enum LogCategory: uint8_t {
+	LOG_CAT_CORE		= 0,
+	LOG_CAT_AT			= 1,
+	LOG_CAT_SMS			= 2,
+	LOG_CAT_NET			= 3,
+	LOG_CAT_UBUS		= 4,
+	LOG_CAT__MAX
+};
+
+enum LogTraceDir: uint8_t {
+	LOG_TRACE_TX		= 0,
+	LOG_TRACE_RX		= 1,
+};
+
+/*
+ * Category of the messages in the current file:
+ *   #define LOG_CATEGORY LOG_CAT_SMS
+ * must be before any include.
+ * */
+#ifndef LOG_CATEGORY
+#define LOG_CATEGORY LOG_CAT_CORE
+#endif
+
+#define LOG_WRITE(level, fmt, ...) do { \
+	if (Log::isEnabled(LOG_CATEGORY, level)) \
+		Log::write(LOG_CATEGORY, level, fmt, ##__VA_ARGS__); \
+} while (0)
+
+#define LOGD(fmt, ...) LOG_WRITE(LOG_LEVEL_DEBUG, fmt, ##__VA_ARGS__)
+#define LOGI(fmt, ...) LOG_WRITE(LOG_LEVEL_INFO, fmt, ##__VA_ARGS__)
+#define LOGE(fmt, ...) LOG_WRITE(LOG_LEVEL_ERROR, "error: " fmt, ##__VA_ARGS__)
+
+/*
+ * Messages are formatted on the caller thread into the lock-free queue
+ * and written to stderr by the background thread.
+ * Without started writer (tools, early start) messages are written directly.
+ * */
+class Log {
+	public:
+		static constexpr size_t QUEUE_SIZE = 256;
+		static constexpr size_t MAX_RECORD_DATA = 480;
+		static constexpr int DEFAULT_RATE_LIMIT = 200;			// messages per second for each category
+		static constexpr long MAX_TRACE_SIZE = 1024 * 1024;		// then file is rotated to <file>.old
+		
+		enum RecordType: uint8_t {
+			RECORD_TEXT,
+			RECORD_TRACE,
+		};
+		
+		struct Record {
+			RecordType type;
+			LogCategory category;
+			LogTraceDir dir;
+			uint8_t flags;
+			uint8_t channel;
+			uint16_t size;
+			int64_t time;
+			char data[MAX_RECORD_DATA];
+		};
+		
+		// Frame in the AT trace file
+		struct TraceFrame {
+			int64_t time;			// unix time, us
+			uint8_t channel;		// AT channel id, frames of many modems are interleaved in the shared daemon
+			uint8_t dir;			// LogTraceDir
+			uint8_t flags;			// TRACE_MORE - data continues in the next frame
+			uint16_t size;
+		} __attribute__((packed));
+		
+		static constexpr uint8_t TRACE_MORE = 1 << 0;
+		static constexpr char TRACE_MAGIC[] = "USBMODEM-AT-TRACE-2\n";
+	protected:
+		static inline std::atomic<uint8_t> m_levels[LOG_CAT__MAX] = {
+			LOG_LEVEL_DEBUG,	// LOG_CAT_CORE
+			LOG_LEVEL_INFO,		// LOG_CAT_AT, traffic is debug
+			LOG_LEVEL_DEBUG,	// LOG_CAT_SMS
+			LOG_LEVEL_DEBUG,	// LOG_CAT_NET
+			LOG_LEVEL_DEBUG,	// LOG_CAT_UBUS
+		};
+		static inline std::atomic<bool> m_trace = false;
+		
+		static bool checkRateLimit(LogCategory category);
+		static void push(Record *record);
+		static void writerLoop();
+		static void writeRecord(const Record &record);
+		static void writeDropped();
+	public:
+		static inline bool isEnabled(LogCategory category, LogLevel level) {
+			return m_levels[category].load(std::memory_order_relaxed) >= level;
+		}
+		
+		static inline bool isTraceEnabled() {
+			return m_trace.load(std::memory_order_relaxed);
+		}
+		
+		static void write(LogCategory category, LogLevel level, const char *format, ...) __attribute__((format(printf, 3, 4)));
+		
+		// Raw bytes of the AT channel, written to the trace file without formatting
+		static void trace(uint8_t channel, LogTraceDir dir, const char *data, size_t size);
+		
+		static void setLevel(LogCategory category, LogLevel level);
+		static void setRateLimit(int limit);
+		static bool setTraceFile(const std::string &path);
+		
+		static bool parseLevel(const std::string &name, LogLevel *level);
+		static const char *getCategoryName(LogCategory category);
+		
+		// Background writer
+		static void start();
+		static void stop();
+		
+		// Print AT trace file in human readable format
+		static int printTrace(const std::string &path);
+};
@@ -20,8 +20,7 @@ void Loop::implSetNextTimeout(int64_t time) {
 }
 
 void Loop::implRun() {
-	static char buf[4];
-	struct pollfd pfd[] = {{.fd = m_waker_r, .events = POLLIN}};
+	struct pollfd pfd[] = {{.fd = m_waker_fd, .events = POLLIN}};
 	
 	while (!m_need_stop) {
 		int timeout = m_next_run - getCurrentTimestamp();
@@ -36,10 +35,6 @@ void Loop::implRun() {
 				LOGE("poll POLLERR or POLLHUP\n");
 				throw std::runtime_error("poll error");
 			}
-	
-			if ((pfd[0].revents & POLLIN)) {
-				while (read(m_waker_r, buf, sizeof(buf)) > 0 || errno == EINTR);
-			}
 		}
 		
 		runTimeouts();
@@ -3,15 +3,12 @@
 #include <fcntl.h>
 #include <unistd.h>
 #include <csignal>
+#include <sys/eventfd.h>
 
 void LoopBase::init() {
-	int fds[2];
-	
-	if (pipe2(fds, O_CLOEXEC | O_NONBLOCK) < 0)
-		throw std::runtime_error("pipe2() error");
-	
-	m_waker_r = fds[0];
-	m_waker_w = fds[1];
+	m_waker_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+	if (m_waker_fd < 0)
+		throw std::runtime_error("eventfd() error");
 	
 	implInit();
 	
@@ -30,8 +27,12 @@ void LoopBase::run() {
 		m_run = false;
 	}
 	
-	for (auto &promise: m_promises)
-		promise.set_value(PromiseTimeout({}));
+	// Release all exec() callers, tasks will never run
+	m_mutex.lock();
+	m_done = true;
+	for (auto waiter: m_exec_waiters)
+		waiter->done.post();
+	m_mutex.unlock();
 	
 	implStop();
 }
@@ -40,11 +41,16 @@ void LoopBase::destroy() {
 	if (m_inited) {
 		implDestroy();
 		
-		close(m_waker_w);
-		close(m_waker_r);
+		close(m_waker_fd);
+		m_waker_fd = -1;
+		
+		m_heap.clear();
+		m_pool.clear();
+		m_pool_free.clear();
 		
-		m_list.clear();
-		m_timers.clear();
+		std::function<void()> task;
+		while (m_tasks.pop(&task));
+		m_tasks_overflow.clear();
 		
 		m_inited = false;
 	}
@@ -55,141 +61,282 @@ void LoopBase::stop() {
 	implRequestStop();
 }
 
+void LoopBase::runTasks() {
+	std::function<void()> task;
+	
+	// Limit batch size, so tasks which post new tasks can't starve poll
+	size_t count = 0;
+	while (!m_need_stop && m_tasks.pop(&task)) {
+		task();
+		
+		if (++count == TASK_QUEUE_SIZE) {
+			wake();
+			break;
+		}
+	}
+	
+	if (m_has_overflow && count < TASK_QUEUE_SIZE) {
+		// Keep FIFO: overflow tasks are newer than everything in queue
+		if (!m_tasks.empty()) {
+			wake();
+			return;
+		}
+		
+		m_mutex.lock();
+		auto overflow = std::move(m_tasks_overflow);
+		m_tasks_overflow.clear();
+		m_has_overflow = false;
+		m_mutex.unlock();
+		
+		for (auto &task: overflow) {
+			if (!m_need_stop)
+				task();
+		}
+	}
+}
+
 void LoopBase::runTimeouts() {
 	if (m_need_stop)
 		return;
 	
-	m_mutex.lock();
-	auto next_timer = (m_list.size() > 0 ? m_list.front() : nullptr);
-	m_mutex.unlock();
+	resetWaker();
+	runTasks();
 	
-	if (!next_timer) {
-		implSetNextTimeout(getCurrentTimestamp() + 60000);
-		return;
-	}
+	int64_t now = getCurrentTimestamp();
+	
+	std::unique_lock lock(m_mutex);
 	
-	if (next_timer->time - getCurrentTimestamp() <= 0) {
-		if (!(next_timer->flags & TIMER_CANCEL))
-			next_timer->callback();
+	// Limit by current heap size, so zero-interval loops can't starve poll
+	size_t limit = m_heap.size();
+	while (limit-- > 0 && !m_heap.empty() && !m_need_stop) {
+		uint32_t slot = m_heap[0];
+		Timer *timer = &m_pool[slot];
+		
+		if (timer->time - now > 0)
+			break;
+		
+		removeTimerFromQueue(slot);
 		
-		if ((next_timer->flags & TIMER_LOOP) && !(next_timer->flags & TIMER_CANCEL)) {
-			m_mutex.lock();
-			next_timer->time = getCurrentTimestamp() + next_timer->interval;
-			addTimerToQueue(next_timer);
-			m_mutex.unlock();
+		if (!(timer->flags & TIMER_LOOP)) {
+			auto callback = std::move(timer->callback);
+			freeTimer(slot);
+			
+			lock.unlock();
+			callback();
+			lock.lock();
 		} else {
-			m_mutex.lock();
-			removeTimerFromQueue(next_timer);
-			m_timers.erase(next_timer->id);
-			m_mutex.unlock();
+			// Pool is a deque, so timer pointer is stable while unlocked
+			lock.unlock();
+			timer->callback();
+			lock.lock();
+			
+			if ((timer->flags & TIMER_CANCEL)) {
+				freeTimer(slot);
+			} else {
+				timer->time = getCurrentTimestamp() + timer->interval;
+				addTimerToQueue(slot);
+			}
 		}
-		
-		m_mutex.lock();
-		next_timer = (m_list.size() > 0 ? m_list.front() : nullptr);
-		m_mutex.unlock();
 	}
 	
-	if (next_timer) {
-		implSetNextTimeout(next_timer->time);
-	} else {
-		implSetNextTimeout(getCurrentTimestamp() + 60000);
-	}
+	int64_t next_time = m_heap.empty() ? getCurrentTimestamp() + 60000 : m_pool[m_heap[0]].time;
+	lock.unlock();
+	
+	implSetNextTimeout(next_time);
 }
 
-void LoopBase::addTimerToQueue(std::shared_ptr<Timer> new_timer) {
-	removeTimerFromQueue(new_timer);
+LoopBase::Timer *LoopBase::getTimer(int64_t id) {
+	if (id < 0)
+		return nullptr;
 	
-	bool inserted = false;
-	for (auto it = m_list.begin(); it != m_list.end(); it++) {
-		if (it->get()->time - new_timer->time > 0) {
-			new_timer->it = m_list.insert(it, new_timer);
-			inserted = true;
-			break;
-		}
+	uint32_t slot = id & TIMER_SLOT_MASK;
+	uint64_t gen = (static_cast<uint64_t>(id) >> TIMER_SLOT_BITS) & TIMER_GEN_MASK;
+	
+	if (slot >= m_pool.size() || m_pool[slot].gen != gen)
+		return nullptr;
+	
+	return &m_pool[slot];
+}
+
+uint32_t LoopBase::allocTimer() {
+	if (!m_pool_free.empty()) {
+		uint32_t slot = m_pool_free.back();
+		m_pool_free.pop_back();
+		return slot;
 	}
 	
-	if (!inserted) {
-		m_list.push_back(new_timer);
-		new_timer->it = --m_list.end();
+	if (m_pool.size() > TIMER_SLOT_MASK)
+		return UINT32_MAX;
+	
+	m_pool.emplace_back();
+	return m_pool.size() - 1;
+}
+
+void LoopBase::freeTimer(uint32_t slot) {
+	Timer *timer = &m_pool[slot];
+	timer->callback = nullptr;
+	timer->flags = 0;
+	// Invalidate old id
+	timer->gen = (timer->gen + 1) & TIMER_GEN_MASK;
+	m_pool_free.push_back(slot);
+}
+
+void LoopBase::addTimerToQueue(uint32_t slot) {
+	Timer *timer = &m_pool[slot];
+	timer->heap_index = m_heap.size();
+	timer->flags |= TIMER_INSTALLED;
+	m_heap.push_back(slot);
+	heapSiftUp(timer->heap_index);
+}
+
+void LoopBase::removeTimerFromQueue(uint32_t slot) {
+	Timer *timer = &m_pool[slot];
+	if (!(timer->flags & TIMER_INSTALLED))
+		return;
+	
+	int index = timer->heap_index;
+	int last = m_heap.size() - 1;
+	
+	if (index != last) {
+		heapSwap(index, last);
+		m_heap.pop_back();
+		heapSiftDown(index);
+		heapSiftUp(index);
+	} else {
+		m_heap.pop_back();
 	}
 	
-	new_timer->flags |= TIMER_INSTALLED;
+	timer->heap_index = -1;
+	timer->flags &= ~TIMER_INSTALLED;
+}
+
+void LoopBase::heapSwap(int a, int b) {
+	std::swap(m_heap[a], m_heap[b]);
+	m_pool[m_heap[a]].heap_index = a;
+	m_pool[m_heap[b]].heap_index = b;
+}
+
+void LoopBase::heapSiftUp(int index) {
+	while (index > 0) {
+		int parent = (index - 1) / 2;
+		if (!heapLess(index, parent))
+			break;
+		heapSwap(index, parent);
+		index = parent;
+	}
 }
 
-void LoopBase::removeTimerFromQueue(std::shared_ptr<Timer> timer) {
-	if ((timer->flags & TIMER_INSTALLED)) {
-		m_list.erase(timer->it);
-		timer->flags &= ~TIMER_INSTALLED;
+void LoopBase::heapSiftDown(int index) {
+	int size = m_heap.size();
+	while (true) {
+		int left = index * 2 + 1;
+		int right = left + 1;
+		int min = index;
+		
+		if (left < size && heapLess(left, min))
+			min = left;
+		if (right < size && heapLess(right, min))
+			min = right;
+		if (min == index)
+			break;
+		
+		heapSwap(index, min);
+		index = min;
 	}
 }
 
 void LoopBase::wake() {
-	if (m_waker_w != -1) {
-		while (write(m_waker_w, "w", 1) < 0 && errno == EINTR);
+	// Coalesce wakeups until loop resets waker
+	if (m_waker_fd != -1 && !m_wake_pending.exchange(true)) {
+		uint64_t value = 1;
+		while (write(m_waker_fd, &value, sizeof(value)) < 0 && errno == EINTR);
 	}
 }
 
-int LoopBase::addTimer(const std::function<void()> &callback, int timeout_ms, bool loop) {
+void LoopBase::resetWaker() {
+	uint64_t value;
+	while (read(m_waker_fd, &value, sizeof(value)) < 0 && errno == EINTR);
+	m_wake_pending = false;
+}
+
+bool LoopBase::addExecWaiter(ExecWaiter *waiter) {
+	std::lock_guard lock(m_mutex);
+	if (!m_inited || m_done)
+		return false;
+	m_exec_waiters.push_back(waiter);
+	return true;
+}
+
+void LoopBase::removeExecWaiter(ExecWaiter *waiter) {
+	std::lock_guard lock(m_mutex);
+	m_exec_waiters.remove(waiter);
+}
+
+int64_t LoopBase::addTimer(const std::function<void()> &callback, int timeout_ms, bool loop) {
 	if (!m_inited)
 		return -1;
 	
 	m_mutex.lock();
 	
-	int id = m_global_timer_id++;
+	uint32_t slot = allocTimer();
+	if (slot == UINT32_MAX) {
+		m_mutex.unlock();
+		LOGE("%s: too many timers\n", name());
+		return -1;
+	}
 	
-	auto new_timer = std::make_shared<Timer>();
-	new_timer->id = id;
-	new_timer->interval = timeout_ms;
-	new_timer->callback = callback;
-	new_timer->time = getCurrentTimestamp() + timeout_ms;
-	new_timer->flags = loop ? TIMER_LOOP : 0;
+	Timer *timer = &m_pool[slot];
+	timer->interval = timeout_ms;
+	timer->callback = callback;
+	timer->time = getCurrentTimestamp() + timeout_ms;
+	timer->flags = loop ? TIMER_LOOP : 0;
 	
-	m_timers[id] = new_timer;
-	addTimerToQueue(new_timer);
+	int64_t id = static_cast<int64_t>((timer->gen << TIMER_SLOT_BITS) | slot);
+	
+	bool need_wake = m_heap.empty() || timer->time - m_pool[m_heap[0]].time < 0;
+	addTimerToQueue(slot);
 	
 	m_mutex.unlock();
 	
-	wake();
+	// Wake only when new timer is earliest
+	if (need_wake)
+		wake();
 	
 	return id;
 }
 
-std::any LoopBase::execOnThisThread(const std::function<std::any()> &callback) {
-	if (!checkThreadId()) {
-		m_mutex.lock();
-		m_promises.resize(m_promises.size() + 1);
-		auto &promise = m_promises.back();
-		auto promise_it = --m_promises.end();
-		m_mutex.unlock();
-		
-		addTimer([this, &promise, &callback]() {
-			promise.set_value(callback());
-		}, 0, false);
-		
-		auto future = promise.get_future();
-		future.wait();
-		auto value = future.get();
-		
+bool LoopBase::postTask(const std::function<void()> &callback) {
+	if (!m_inited)
+		return false;
+	
+	if (m_has_overflow || !m_tasks.push(std::function<void()>(callback))) {
+		// Rare case, queue is full
 		m_mutex.lock();
-		m_promises.erase(promise_it);
+		m_tasks_overflow.push_back(callback);
+		m_has_overflow = true;
 		m_mutex.unlock();
-		
-		if (value.type() == typeid(PromiseTimeout))
-			return {};
-		
-		return value;
-	} else {
-		return callback();
 	}
+	
+	wake();
+	
+	return true;
 }
 
-void LoopBase::removeTimer(int id) {
+void LoopBase::removeTimer(int64_t id) {
 	if (!m_inited)
 		return;
 	
 	m_mutex.lock();
-	auto it = m_timers.find(id);
-	if (it != m_timers.end())
-		it->second->flags |= TIMER_CANCEL;
+	Timer *timer = getTimer(id);
+	if (timer) {
+		if ((timer->flags & TIMER_INSTALLED)) {
+			uint32_t slot = id & TIMER_SLOT_MASK;
+			removeTimerFromQueue(slot);
+			freeTimer(slot);
+		} else {
+			// Interval timer, which is running right now
+			timer->flags |= TIMER_CANCEL;
+		}
+	}
 	m_mutex.unlock();
 }
@@ -4,15 +4,19 @@
 #include <map>
 #include <any>
 #include <list>
+#include <deque>
+#include <vector>
+#include <atomic>
 #include <memory>
 #include <thread>
-#include <future>
 #include <stdexcept>
 #include <functional>
 #include <optional>
 
 #include "Log.h"
 #include "Utils.h"
+#include "MpscQueue.h"
+#include "Semaphore.h"
 
 class LoopBase {
 	protected:
@@ -22,35 +26,66 @@ class LoopBase {
 			TIMER_CANCEL	= 1 << 2
 		};
 		
+		// Timer id = (generation << TIMER_SLOT_BITS) | slot, 47-bit generation never wraps in practice
+		static constexpr int TIMER_SLOT_BITS = 16;
+		static constexpr uint32_t TIMER_SLOT_MASK = (1 << TIMER_SLOT_BITS) - 1;
+		static constexpr uint64_t TIMER_GEN_MASK = (1ULL << (63 - TIMER_SLOT_BITS)) - 1;
+		
 		struct Timer {
-			std::list<std::shared_ptr<Timer>>::iterator it;
-			int id = 0;
 			std::function<void()> callback;
+			uint64_t gen = 0;
+			int heap_index = -1;
 			uint8_t flags = 0;
 			int interval = 0;
 			int64_t time = 0;
 		};
 		
-		struct PromiseTimeout { };
+		static constexpr size_t TASK_QUEUE_SIZE = 256;
+		
+		struct ExecWaiter {
+			Semaphore done;
+		};
+		
+		template <typename T>
+		struct ExecResult: public ExecWaiter {
+			std::optional<T> value;
+		};
 		
-		int m_waker_r = -1;
-		int m_waker_w = -1;
+		// eventfd
+		int m_waker_fd = -1;
+		std::atomic<bool> m_wake_pending = false;
 		
-		std::list<std::shared_ptr<Timer>> m_list;
-		std::map<int, std::shared_ptr<Timer>> m_timers;
-		std::list<std::promise<std::any>> m_promises;
+		std::deque<Timer> m_pool;
+		std::vector<uint32_t> m_pool_free;
+		std::vector<uint32_t> m_heap;
+		MpscQueue<std::function<void()>> m_tasks {TASK_QUEUE_SIZE};
+		std::deque<std::function<void()>> m_tasks_overflow;
+		std::atomic<bool> m_has_overflow = false;
+		std::list<ExecWaiter *> m_exec_waiters;
 		std::mutex m_mutex;
 		
 		bool m_inited = false;
 		bool m_need_stop = false;
 		bool m_run = false;
-		int m_global_timer_id = 0;
+		bool m_done = false;
 		
 		std::thread::id m_thread_id;
 	protected:
-		void addTimerToQueue(std::shared_ptr<Timer> new_timer);
-		void removeTimerFromQueue(std::shared_ptr<Timer> timer);
+		Timer *getTimer(int64_t id);
+		uint32_t allocTimer();
+		void freeTimer(uint32_t slot);
+		
+		void addTimerToQueue(uint32_t slot);
+		void removeTimerFromQueue(uint32_t slot);
+		void heapSiftUp(int index);
+		void heapSiftDown(int index);
+		void heapSwap(int a, int b);
 		
+		inline bool heapLess(int a, int b) {
+			return m_pool[m_heap[a]].time - m_pool[m_heap[b]].time < 0;
+		}
+		
+		void runTasks();
 		void runTimeouts();
 		void handlerSignal(int sig);
 		
@@ -64,6 +99,10 @@ class LoopBase {
 		
 		void done();
 		void wake();
+		void resetWaker();
+		
+		bool addExecWaiter(ExecWaiter *waiter);
+		void removeExecWaiter(ExecWaiter *waiter);
 	public:
 		void init();
 		void run();
@@ -74,7 +113,28 @@ class LoopBase {
 			return !m_run || m_thread_id == std::this_thread::get_id();
 		}
 		
-		std::any execOnThisThread(const std::function<std::any()> &callback);
-		int addTimer(const std::function<void()> &callback, int timeout_ms, bool loop);
-		void removeTimer(int id);
+		template <typename T>
+		std::optional<T> execOnThisThread(const std::function<T()> &callback) {
+			if (checkThreadId())
+				return callback();
+			
+			ExecResult<T> result;
+			if (!addExecWaiter(&result))
+				return std::nullopt;
+			
+			postTask([&result, &callback]() {
+				result.value = callback();
+				result.done.post();
+			});
+			
+			while (!result.done.wait(60000));
+			
+			removeExecWaiter(&result);
+			
+			return std::move(result.value);
+		}
+		
+		int64_t addTimer(const std::function<void()> &callback, int timeout_ms, bool loop);
+		void removeTimer(int64_t id);
+		bool postTask(const std::function<void()> &callback);
 };
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+
+/*
+ * Bounded lock-free queue: many producers, single consumer.
+ * Each cell has sequence number, so producers don't need a lock.
+ * */
+template <typename T>
+class MpscQueue {
+	protected:
+		struct Cell {
+			std::atomic<size_t> seq;
+			T data;
+		};
+		
+		std::unique_ptr<Cell[]> m_cells;
+		size_t m_mask = 0;
+		
+		alignas(64) std::atomic<size_t> m_tail = 0;
+		alignas(64) size_t m_head = 0;
+	
+	public:
+		// Capacity must be power of 2
+		explicit MpscQueue(size_t capacity) {
+			m_cells.reset(new Cell[capacity]);
+			m_mask = capacity - 1;
+			for (size_t i = 0; i < capacity; i++)
+				m_cells[i].seq.store(i, std::memory_order_relaxed);
+		}
+		
+		MpscQueue(const MpscQueue &) = delete;
+		MpscQueue &operator=(const MpscQueue &) = delete;
+		
+		// Any thread
+		bool push(T &&value) {
+			size_t pos = m_tail.load(std::memory_order_relaxed);
+			Cell *cell;
+			while (true) {
+				cell = &m_cells[pos & m_mask];
+				size_t seq = cell->seq.load(std::memory_order_acquire);
+				intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+				if (diff == 0) {
+					if (m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+						break;
+				} else if (diff < 0) {
+					// Queue is full
+					return false;
+				} else {
+					pos = m_tail.load(std::memory_order_relaxed);
+				}
+			}
+			
+			cell->data = std::move(value);
+			cell->seq.store(pos + 1, std::memory_order_release);
+			return true;
+		}
+		
+		// Only consumer thread
+		bool pop(T *value) {
+			Cell *cell = &m_cells[m_head & m_mask];
+			if (cell->seq.load(std::memory_order_acquire) != m_head + 1)
+				return false;
+			
+			*value = std::move(cell->data);
+			cell->data = T();
+			cell->seq.store(m_head + m_mask + 1, std::memory_order_release);
+			m_head++;
+			return true;
+		}
+		
+		// Only consumer thread, also false when some producer has not finished push yet
+		bool empty() const {
+			return m_tail.load(std::memory_order_acquire) == m_head;
+		}
+		
+		constexpr size_t capacity() const {
+			return m_mask + 1;
+		}
+};
@@ -1,3 +1,5 @@
+#define LOG_CATEGORY LOG_CAT_NET
+
 #include "Netifd.h"
 
 Netifd::Netifd() {
@@ -1,3 +1,5 @@
+#define LOG_CATEGORY LOG_CAT_AT
+
 #include "Serial.h"
 
 #include <cmath>
@@ -1,10 +1,26 @@
+#define LOG_CATEGORY LOG_CAT_SMS
+
 #include "SmsDb.h"
 #include "Log.h"
+#include "Crc32.h"
+#include "BinaryStream.h"
 
+#include <memory>
+#include <fcntl.h>
 #include <unistd.h>
 #include <sys/file.h>
 #include <sys/statvfs.h>
 
+SmsDb::~SmsDb() {
+	waitCompaction();
+	
+	// Flush pending changes
+	if (m_inited && m_storage_type == STORAGE_FILESYSTEM && (m_dirty.size() || m_dirty_flags.size() || m_deleted.size()))
+		save();
+	
+	waitCompaction();
+}
+
 void SmsDb::init() {
 	m_inited = true;
 }
@@ -20,13 +36,7 @@ const char *SmsDb::getStorageTypeName() {
 }
 
 int SmsDb::getUnreadCount() {
-	int cnt = 0;
-	for (auto &it: m_storage) {
-		auto &sms = it.second;
-		if ((sms.flags & SMS_IS_UNREAD))
-			cnt++;
-	}
-	return cnt;
+	return m_unread_count;
 }
 
 int SmsDb::getMaxCapacity() {
@@ -41,48 +51,76 @@ int SmsDb::getMaxCapacity() {
 	return m_capacity;
 }
 
+bool SmsDb::isComplete(const Sms *sms) {
+	for (auto &part: sms->parts) {
+		if (!part.text.size())
+			return false;
+	}
+	return true;
+}
+
 SmsDb::Sms *SmsDb::findSameSms(const RawSms &raw) {
 	if (raw.parts < 2)
 		return nullptr;
 	
-	for (auto &it: m_storage) {
-		auto &sms = it.second;
-		
-		if (sms.type != raw.type)
-			continue;
-		
-		if (sms.ref_id != raw.ref_id)
-			continue;
-		
-		if (sms.parts.size() != raw.parts)
-			continue;
-		
-		if (sms.parts[raw.part - 1].text.size() > 0)
-			continue;
-		
-		if (sms.addr != raw.addr)
-			continue;
-		
-		if (sms.smsc != raw.smsc)
-			continue;
-		
-		return &sms;
+	MultipartKey key = {raw.type, raw.ref_id, static_cast<size_t>(raw.parts), raw.addr, raw.smsc};
+	auto [begin, end] = m_multipart.equal_range(key);
+	for (auto it = begin; it != end; it++) {
+		auto &sms = m_storage[it->second];
+		if (!sms.parts[raw.part - 1].text.size())
+			return &sms;
 	}
 	
 	return nullptr;
 }
 
-void SmsDb::addToList(Sms *sms) {
-	auto &list = m_list[sms->type];
-	for (auto it = list.begin(); it != list.end(); it++) {
-		if (sms->time >= m_storage[*it].time) {
-			list.insert(it, sms->id);
-			return;
+void SmsDb::addToIndex(Sms *sms) {
+	m_list[sms->type].insert({sms->time, sms->id});
+	
+	if (sms->parts.size() > 1 && !isComplete(sms))
+		m_multipart.insert({getMultipartKey(sms), sms->id});
+	
+	if ((sms->flags & SMS_IS_UNREAD))
+		m_unread_count++;
+	
+	m_used_capacity += sms->parts.size();
+}
+
+void SmsDb::removeFromMultipart(Sms *sms) {
+	auto [begin, end] = m_multipart.equal_range(getMultipartKey(sms));
+	for (auto it = begin; it != end; it++) {
+		if (it->second == sms->id) {
+			m_multipart.erase(it);
+			break;
 		}
 	}
-	list.push_back(sms->id);
+}
+
+void SmsDb::removeFromIndex(Sms *sms) {
+	m_list[sms->type].erase({sms->time, sms->id});
 	
-	m_used_capacity += sms->parts.size();
+	if (sms->parts.size() > 1)
+		removeFromMultipart(sms);
+	
+	if ((sms->flags & SMS_IS_UNREAD))
+		m_unread_count--;
+	
+	m_used_capacity -= sms->parts.size();
+}
+
+void SmsDb::clear() {
+	for (auto &it: m_list)
+		it.second.clear();
+	m_storage.clear();
+	m_multipart.clear();
+	m_global_sms_id = 0;
+	m_used_capacity = 0;
+	m_unread_count = 0;
+	m_dirty.clear();
+	m_dirty_flags.clear();
+	m_deleted.clear();
+	m_file_records = 0;
+	m_need_rewrite = true;
 }
 
 bool SmsDb::add(const RawSms &raw) {
@@ -101,10 +139,23 @@ bool SmsDb::add(const RawSms &raw) {
 		if (!sms->time)
 			sms->time = time(nullptr);
 		
-		addToList(sms);
+		addToIndex(sms);
 	}
+	
 	sms->parts[raw.part - 1].foreign_id = raw.index;
 	sms->parts[raw.part - 1].text = raw.text;
+	
+	if (!(sms->flags & SMS_IS_UNREAD) && (raw.flags & SMS_IS_UNREAD))
+		m_unread_count++;
+	sms->flags |= raw.flags;
+	
+	m_dirty.insert(sms->id);
+	m_dirty_flags.erase(sms->id);
+	
+	// All parts received
+	if (raw.parts > 1 && isComplete(sms))
+		removeFromMultipart(sms);
+	
 	return true;
 }
 
@@ -116,14 +167,32 @@ bool SmsDb::add(const std::vector<RawSms> &list) {
 	return true;
 }
 
+int SmsDb::insert(Sms &&sms) {
+	int sms_id = m_global_sms_id++;
+	
+	if (!sms.time)
+		sms.time = time(nullptr);
+	
+	sms.id = sms_id;
+	m_storage[sms_id] = std::move(sms);
+	addToIndex(&m_storage[sms_id]);
+	
+	m_dirty.insert(sms_id);
+	m_dirty_flags.erase(sms_id);
+	
+	return sms_id;
+}
+
 std::vector<SmsDb::Sms> SmsDb::getSmsList(SmsType type, int offset, int limit) {
-	auto &list = m_list[type];
 	std::vector<Sms> result;
-	for (auto i = offset; i < list.size(); i++) {
-		if (i >= list.size())
-			break;
-		result.push_back(m_storage[list[i]]);
-	}
+	
+	if (offset < 0)
+		return result;
+	
+	walkSmsList(type, {}, offset, limit, [&result](const Sms &sms) {
+		result.push_back(sms);
+	});
+	
 	return result;
 }
 
@@ -139,8 +208,6 @@ bool SmsDb::deleteSms(int id) {
 	
 	auto &sms = m_storage[id];
 	
-	m_used_capacity -= sms.parts.size();
-	
 	// Remove sms from device
 	if (m_remove_sms_callback) {
 		for (auto &part: sms.parts) {
@@ -149,200 +216,539 @@ bool SmsDb::deleteSms(int id) {
 		}
 	}
 	
-	// Remove sms from lists
-	auto it = std::find(m_list[sms.type].begin(), m_list[sms.type].end(), sms.id);
-	if (it != m_list[sms.type].end())
-		m_list[sms.type].erase(it);
+	// Remove sms from indexes
+	removeFromIndex(&sms);
 	
 	// Remove from storage
 	m_storage.erase(id);
 	
+	m_dirty.erase(id);
+	m_dirty_flags.erase(id);
+	m_deleted.push_back(id);
+	
 	return true;
 }
 
-bool SmsDb::serialize(BinaryFileWriter *writer) {
-	// Magic
-	if (!writer->writeUInt32(DB_MAGIC))
+bool SmsDb::markRead(int id) {
+	auto it = m_storage.find(id);
+	if (it == m_storage.end())
 		return false;
 	
-	// DB version
-	if (!writer->writeUInt8(DB_VERSION))
+	auto &sms = it->second;
+	if ((sms.flags & SMS_IS_UNREAD)) {
+		sms.flags &= ~SMS_IS_UNREAD;
+		m_unread_count--;
+		
+		if (m_dirty.find(id) == m_dirty.end())
+			m_dirty_flags.insert(id);
+	}
+	
+	return true;
+}
+
+bool SmsDb::setFlags(int id, SmsFlags set, SmsFlags clear) {
+	auto it = m_storage.find(id);
+	if (it == m_storage.end())
 		return false;
 	
-	for (auto &it: m_storage) {
-		auto &sms = it.second;
+	auto &sms = it->second;
+	SmsFlags new_flags = (sms.flags & ~clear) | set;
+	if (new_flags != sms.flags) {
+		if ((new_flags & SMS_IS_UNREAD) != (sms.flags & SMS_IS_UNREAD))
+			m_unread_count += (new_flags & SMS_IS_UNREAD) ? 1 : -1;
 		
-		// Flags
-		if (!writer->writeUInt8(sms.type))
-			return false;
-		if (!writer->writeUInt32(sms.flags))
-			return false;
-		if (!writer->writeUInt32(sms.ref_id))
-			return false;
-		if (!writer->writeUInt64(sms.time))
-			return false;
+		sms.flags = new_flags;
 		
-		// Number and SMSC
-		if (!writer->writePackedString(16, sms.addr))
-			return false;
-		if (!writer->writePackedString(16, sms.smsc))
-			return false;
-		
-		// Number of parts
-		if (!writer->writeUInt8(sms.parts.size()))
-			return false;
-		
-		// Text of each parts
-		for (auto &p: sms.parts) {
-			if (!writer->writePackedString(16, p.text))
-				return false;
-		}
+		if (m_dirty.find(id) == m_dirty.end())
+			m_dirty_flags.insert(id);
 	}
 	
 	return true;
 }
 
-bool SmsDb::unserialize(BinaryFileReader *reader) {
-	uint32_t magic = 0;
-	uint8_t version = 0;
+bool SmsDb::serializeSms(BinaryWriterBase *writer, const Sms &sms, bool with_id) {
+	if (with_id && !writer->writeUInt32(sms.id))
+		return false;
 	
-	if (!reader->readUInt32(&magic) || magic != DB_MAGIC) {
-		LOGE("Invalid db magic, expected %08X, but got %08X\n", magic, DB_MAGIC);
+	// Flags
+	if (!writer->writeUInt8(sms.type))
+		return false;
+	if (!writer->writeUInt32(sms.flags))
+		return false;
+	if (!writer->writeUInt32(sms.ref_id))
+		return false;
+	if (!writer->writeUInt64(sms.time))
 		return false;
-	}
 	
-	if (!reader->readUInt8(&version) || version != DB_VERSION) {
-		LOGE("Invalid db version, expected %d, but got %d\n", version, DB_VERSION);
+	// Number and SMSC
+	if (!writer->writePackedString(16, sms.addr))
+		return false;
+	if (!writer->writePackedString(16, sms.smsc))
 		return false;
-	}
 	
-	while (!reader->eof()) {
-		Sms sms;
-		
-		// Flags
-		uint8_t type;
-		if (!reader->readUInt8(&type))
-			return false;
-		sms.type = static_cast<SmsType>(type);
-		
-		uint32_t flags;
-		if (!reader->readUInt32(&flags))
-			return false;
-		sms.flags = static_cast<SmsFlags>(flags);
-		
-		if (!reader->readUInt32(&sms.ref_id))
-			return false;
-		
-		if (!reader->readUInt64(&sms.time))
-			return false;
-		
-		// Number and SMSC
-		if (!reader->readPackedString(16, &sms.addr))
+	// Number of parts
+	if (!writer->writeUInt8(sms.parts.size()))
+		return false;
+	
+	// Text of each parts
+	for (auto &p: sms.parts) {
+		if (!writer->writePackedString(16, p.text))
 			return false;
-		if (!reader->readPackedString(16, &sms.smsc))
+	}
+	
+	return true;
+}
+
+bool SmsDb::unserializeSms(BinaryViewReader *reader, Sms *sms, bool with_id) {
+	if (with_id) {
+		uint32_t id;
+		if (!reader->readUInt32(&id))
 			return false;
-		
-		// Number of parts
-		uint8_t parts_n;
-		if (!reader->readUInt8(&parts_n))
+		sms->id = id;
+	}
+	
+	// Flags
+	uint8_t type;
+	uint32_t flags;
+	if (!reader->readUInt8(&type) || !reader->readUInt32(&flags))
+		return false;
+	sms->type = static_cast<SmsType>(type);
+	sms->flags = static_cast<SmsFlags>(flags);
+	
+	if (!reader->readUInt32(&sms->ref_id) || !reader->readUInt64(&sms->time))
+		return false;
+	
+	// Number and SMSC
+	std::string_view addr, smsc;
+	if (!reader->readPackedString<uint16_t>(&addr) || !reader->readPackedString<uint16_t>(&smsc))
+		return false;
+	sms->addr = addr;
+	sms->smsc = smsc;
+	
+	// Number of parts
+	uint8_t parts_n;
+	if (!reader->readUInt8(&parts_n))
+		return false;
+	sms->parts.resize(parts_n);
+	
+	// Text of each parts
+	for (auto i = 0; i < parts_n; i++) {
+		std::string_view text;
+		if (!reader->readPackedString<uint16_t>(&text))
 			return false;
-		sms.parts.resize(parts_n);
+		sms->parts[i].text = text;
+	}
+	
+	return true;
+}
+
+/*
+ * Record: [type u8][payload length u32][payload][crc32 of type, length and payload]
+ * */
+void SmsDb::writeRecord(BinaryBufferWriter *writer, RecordType type, BinaryBufferWriter *payload) {
+	size_t start = writer->size();
+	writer->writeUInt8(type);
+	writer->writeUInt32(payload->size());
+	writer->write(payload->buffer(), payload->size());
+	writer->writeUInt32(crc32(0, writer->buffer() + start, writer->size() - start));
+	payload->clear();
+}
+
+int SmsDb::writeJournal(BinaryBufferWriter *writer) {
+	BinaryBufferWriter payload;
+	int records = 0;
+	
+	for (auto id: m_deleted) {
+		payload.writeUInt32(id);
+		writeRecord(writer, RECORD_DELETE, &payload);
+		records++;
+	}
+	
+	for (auto id: m_dirty) {
+		auto it = m_storage.find(id);
+		if (it == m_storage.end())
+			continue;
 		
-		// Text of each parts
-		for (auto i = 0; i < parts_n; i++) {
-			if (!reader->readPackedString(16, &sms.parts[i].text))
-				return false;
+		// Truncated record has valid crc, but breaks all records after it
+		if (!serializeSms(&payload, it->second, true)) {
+			LOGE("Can't serialize SMS #%d, skipping\n", id);
+			payload.clear();
+			continue;
 		}
 		
-		int sms_id = m_global_sms_id++;
-		sms.id = sms_id;
+		writeRecord(writer, RECORD_PUT, &payload);
+		records++;
+	}
+	
+	for (auto id: m_dirty_flags) {
+		auto it = m_storage.find(id);
+		if (it == m_storage.end())
+			continue;
+		payload.writeUInt32(id);
+		payload.writeUInt32(it->second.flags);
+		writeRecord(writer, RECORD_FLAGS, &payload);
+		records++;
+	}
+	
+	return records;
+}
+
+int SmsDb::writeSnapshot(BinaryBufferWriter *writer) {
+	BinaryBufferWriter payload;
+	
+	writer->writeUInt32(DB_MAGIC);
+	writer->writeUInt8(DB_VERSION);
+	
+	int records = 0;
+	for (auto &it: m_storage) {
+		if (!serializeSms(&payload, it.second, true)) {
+			LOGE("Can't serialize SMS #%d, skipping\n", it.first);
+			payload.clear();
+			continue;
+		}
 		
-		// Add sms to list
-		m_storage[sms_id] = std::move(sms);
-		addToList(&m_storage[sms_id]);
+		writeRecord(writer, RECORD_PUT, &payload);
+		records++;
 	}
 	
-	return true;
+	return records;
 }
 
-bool SmsDb::load() {
-	m_list.clear();
-	m_storage.clear();
-	m_global_sms_id = 0;
-	m_used_capacity = 0;
+static bool syncDir(const std::string &file) {
+	size_t slash = file.rfind('/');
+	std::string dir = slash == std::string::npos ? "." : (slash == 0 ? "/" : file.substr(0, slash));
 	
-	if (!isFileExists(m_db_filename) || !getFileSize(m_db_filename))
-		return true;
+	int fd = open(dir.c_str(), O_RDONLY | O_DIRECTORY);
+	if (fd < 0)
+		return false;
 	
-	FILE *fp = fopen(m_db_filename.c_str(), "r");
+	bool success = fsync(fd) == 0;
+	close(fd);
+	return success;
+}
+
+bool SmsDb::writeFile(const BinaryBufferWriter &snapshot) {
+	FILE *fp = fopen(m_tmp_filename.c_str(), "w+");
 	if (!fp) {
-		LOGE("Can't open '%s' for reading, errno = %d\n", m_db_filename.c_str(), errno);
+		LOGE("Can't open '%s' for writing, errno = %d\n", m_tmp_filename.c_str(), errno);
 		return false;
 	}
 	
 	if (flock(fileno(fp), LOCK_EX) != 0) {
-		LOGE("Can't lock file '%s', errno = %d\n", m_db_filename.c_str(), errno);
+		LOGE("Can't lock file '%s', errno = %d\n", m_tmp_filename.c_str(), errno);
 		fclose(fp);
+		unlink(m_tmp_filename.c_str());
 		return false;
 	}
 	
-	BinaryFileReader reader(fp);
-	if (!unserialize(&reader)) {
-		LOGD("Can't unserialize SMS database from %s\n", m_db_filename.c_str());
+	size_t size = const_cast<BinaryBufferWriter &>(snapshot).size();
+	if (fwrite(snapshot.buffer(), 1, size, fp) != size || fflush(fp) != 0 || fsync(fileno(fp)) != 0) {
+		LOGE("Can't write SMS database to '%s', errno = %d\n", m_tmp_filename.c_str(), errno);
 		flock(fileno(fp), LOCK_UN);
 		fclose(fp);
+		unlink(m_tmp_filename.c_str());
 		return false;
 	}
 	
 	if (flock(fileno(fp), LOCK_UN) != 0) {
-		LOGE("Can't unlock file '%s', errno = %d\n", m_db_filename.c_str(), errno);
+		LOGE("Can't unlock file '%s', errno = %d\n", m_tmp_filename.c_str(), errno);
 		fclose(fp);
+		unlink(m_tmp_filename.c_str());
 		return false;
 	}
 	
 	fclose(fp);
 	
+	if (rename(m_tmp_filename.c_str(), m_db_filename.c_str()) != 0) {
+		LOGE("Can't move '%s' to '%s', errno = %d\n", m_tmp_filename.c_str(), m_db_filename.c_str(), errno);
+		unlink(m_tmp_filename.c_str());
+		return false;
+	}
+	
+	// Persist rename, otherwise old file can come back after power loss
+	if (!syncDir(m_db_filename))
+		LOGE("Can't sync directory of '%s', errno = %d\n", m_db_filename.c_str(), errno);
+	
 	return true;
 }
 
-bool SmsDb::save() {
-	FILE *fp = fopen(m_tmp_filename.c_str(), "w+");
+bool SmsDb::appendFile(const BinaryBufferWriter &journal) {
+	FILE *fp = fopen(m_db_filename.c_str(), "a");
 	if (!fp) {
-		LOGE("Can't open '%s' for writing, errno = %d\n", m_tmp_filename.c_str(), errno);
+		LOGE("Can't open '%s' for writing, errno = %d\n", m_db_filename.c_str(), errno);
 		return false;
 	}
 	
 	if (flock(fileno(fp), LOCK_EX) != 0) {
-		LOGE("Can't lock file '%s', errno = %d\n", m_tmp_filename.c_str(), errno);
+		LOGE("Can't lock file '%s', errno = %d\n", m_db_filename.c_str(), errno);
 		fclose(fp);
-		unlink(m_tmp_filename.c_str());
 		return false;
 	}
 	
-	BinaryFileWriter writer(fp);
-	if (!serialize(&writer)) {
-		LOGD("Can't serialize SMS database to %s\n", m_tmp_filename.c_str());
+	size_t size = const_cast<BinaryBufferWriter &>(journal).size();
+	if (fwrite(journal.buffer(), 1, size, fp) != size || fflush(fp) != 0) {
+		LOGE("Can't append SMS journal to '%s', errno = %d\n", m_db_filename.c_str(), errno);
 		flock(fileno(fp), LOCK_UN);
 		fclose(fp);
-		unlink(m_tmp_filename.c_str());
 		return false;
 	}
 	
-	if (flock(fileno(fp), LOCK_UN) != 0) {
-		LOGE("Can't unlock file '%s', errno = %d\n", m_tmp_filename.c_str(), errno);
-		fclose(fp);
-		unlink(m_tmp_filename.c_str());
+	flock(fileno(fp), LOCK_UN);
+	fclose(fp);
+	
+	return true;
+}
+
+bool SmsDb::startCompaction() {
+	auto snapshot = std::make_shared<BinaryBufferWriter>();
+	m_file_records = writeSnapshot(snapshot.get());
+	
+	// All changes are in snapshot now
+	m_dirty.clear();
+	m_dirty_flags.clear();
+	m_deleted.clear();
+	m_need_rewrite = false;
+	
+	m_compacting = true;
+	m_compact_thread = std::thread([this, snapshot]() {
+		m_compact_ok = writeFile(*snapshot);
+		m_compacting = false;
+		
+		if (m_compaction_callback)
+			m_compaction_callback();
+	});
+	
+	return true;
+}
+
+void SmsDb::waitCompaction() {
+	if (!m_compact_thread.joinable())
+		return;
+	
+	m_compact_thread.join();
+	
+	// Old file is still valid, but it doesn't contain changes from snapshot
+	if (!m_compact_ok) {
+		LOGE("Can't compact SMS database '%s'\n", m_db_filename.c_str());
+		m_need_rewrite = true;
+	}
+}
+
+void SmsDb::putSms(Sms &&sms) {
+	auto it = m_storage.find(sms.id);
+	if (it != m_storage.end())
+		removeFromIndex(&it->second);
+	
+	int sms_id = sms.id;
+	m_storage[sms_id] = std::move(sms);
+	addToIndex(&m_storage[sms_id]);
+	
+	if (sms_id >= m_global_sms_id)
+		m_global_sms_id = sms_id + 1;
+}
+
+bool SmsDb::applyRecord(uint8_t type, BinaryViewReader *reader) {
+	switch (type) {
+		case RECORD_PUT:
+		{
+			Sms sms;
+			if (!unserializeSms(reader, &sms, true))
+				return false;
+			putSms(std::move(sms));
+			return true;
+		}
+		
+		case RECORD_DELETE:
+		{
+			uint32_t id;
+			if (!reader->readUInt32(&id))
+				return false;
+			
+			auto it = m_storage.find(id);
+			if (it != m_storage.end()) {
+				removeFromIndex(&it->second);
+				m_storage.erase(it);
+			}
+			return true;
+		}
+		
+		case RECORD_FLAGS:
+		{
+			uint32_t id, flags;
+			if (!reader->readUInt32(&id) || !reader->readUInt32(&flags))
+				return false;
+			
+			auto it = m_storage.find(id);
+			if (it != m_storage.end()) {
+				removeFromIndex(&it->second);
+				it->second.flags = static_cast<SmsFlags>(flags);
+				addToIndex(&it->second);
+			}
+			return true;
+		}
+	}
+	
+	LOGE("Unknown SMS journal record type: %d\n", type);
+	return false;
+}
+
+bool SmsDb::unserializeLegacy(BinaryViewReader *reader) {
+	while (!reader->eof()) {
+		Sms sms;
+		if (!unserializeSms(reader, &sms, false))
+			return false;
+		sms.id = m_global_sms_id;
+		putSms(std::move(sms));
+	}
+	return true;
+}
+
+bool SmsDb::unserializeJournal(BinaryViewReader *reader, size_t *valid_size) {
+	while (!reader->eof()) {
+		size_t start = reader->offset();
+		uint8_t type;
+		uint32_t len, crc;
+		BinaryViewReader payload;
+		
+		if (!reader->readUInt8(&type) || !reader->readUInt32(&len))
+			return false;
+		
+		// Garbage length, don't trust it even if file is large enough
+		if (len > MAX_RECORD_SIZE) {
+			LOGE("Invalid SMS journal record length %u at offset %zu\n", len, start);
+			return false;
+		}
+		
+		// Torn record at the end of file
+		if (!reader->readBlock(&payload, len) || !reader->readUInt32(&crc))
+			return false;
+		
+		if (crc32(0, reader->data() + start, len + 5) != crc) {
+			LOGE("Invalid SMS journal record crc at offset %zu\n", start);
+			return false;
+		}
+		
+		if (!applyRecord(type, &payload))
+			return false;
+		
+		m_file_records++;
+		*valid_size = reader->offset();
+	}
+	return true;
+}
+
+bool SmsDb::load() {
+	waitCompaction();
+	clear();
+	
+	if (!isFileExists(m_db_filename) || !getFileSize(m_db_filename))
+		return true;
+	
+	int fd = open(m_db_filename.c_str(), O_RDWR | O_CLOEXEC);
+	if (fd < 0) {
+		LOGE("Can't open '%s' for reading, errno = %d\n", m_db_filename.c_str(), errno);
 		return false;
 	}
 	
-	fclose(fp);
+	if (flock(fd, LOCK_EX) != 0) {
+		LOGE("Can't lock file '%s', errno = %d\n", m_db_filename.c_str(), errno);
+		close(fd);
+		return false;
+	}
 	
-	if (rename(m_tmp_filename.c_str(), m_db_filename.c_str()) != 0) {
-		unlink(m_tmp_filename.c_str());
-		LOGD("Can't move '%s' to '%s', errno = %d\n", m_tmp_filename.c_str(), m_db_filename.c_str(), errno);
+	BinaryMappedFile file;
+	if (!file.map(fd)) {
+		LOGE("Can't map file '%s', errno = %d\n", m_db_filename.c_str(), errno);
+		flock(fd, LOCK_UN);
+		close(fd);
+		return false;
+	}
+	
+	BinaryViewReader reader = file.reader();
+	
+	uint32_t magic = 0;
+	uint8_t version = 0;
+	bool success = true;
+	
+	if (!reader.readUInt32(&magic) || magic != DB_MAGIC) {
+		LOGE("Invalid db magic, expected %08X, but got %08X\n", DB_MAGIC, magic);
+		success = false;
+	} else if (!reader.readUInt8(&version) || version > DB_VERSION) {
+		LOGE("Invalid db version, expected %d, but got %d\n", DB_VERSION, version);
+		success = false;
+	} else if (version == 0) {
+		// Old full snapshot format, converting to journal on next save
+		if (!unserializeLegacy(&reader)) {
+			LOGD("Can't unserialize SMS database from %s\n", m_db_filename.c_str());
+			success = false;
+		}
+	} else {
+		size_t valid_size = reader.offset();
+		m_need_rewrite = false;
+		
+		// Drop everything after last valid record
+		if (!unserializeJournal(&reader, &valid_size)) {
+			LOGE("SMS journal '%s' is damaged, truncating to %zu bytes\n", m_db_filename.c_str(), valid_size);
+			file.unmap();
+			if (ftruncate(fd, valid_size) != 0) {
+				LOGE("Can't truncate file '%s', errno = %d\n", m_db_filename.c_str(), errno);
+				m_need_rewrite = true;
+			}
+		}
 	}
 	
-	unlink(m_tmp_filename.c_str());
+	file.unmap();
+	
+	if (flock(fd, LOCK_UN) != 0) {
+		LOGE("Can't unlock file '%s', errno = %d\n", m_db_filename.c_str(), errno);
+		close(fd);
+		return false;
+	}
+	
+	close(fd);
+	
+	return success;
+}
+
+bool SmsDb::save() {
+	// Pending changes are written by save() from the compaction callback
+	if (m_compacting)
+		return true;
+	
+	waitCompaction();
+	
+	int live = m_storage.size();
+	int records = m_file_records + m_dirty.size() + m_dirty_flags.size() + m_deleted.size();
+	
+	if (m_need_rewrite) {
+		BinaryBufferWriter snapshot;
+		int snapshot_records = writeSnapshot(&snapshot);
+		if (!writeFile(snapshot))
+			return false;
+		
+		m_file_records = snapshot_records;
+		m_need_rewrite = false;
+		m_dirty.clear();
+		m_dirty_flags.clear();
+		m_deleted.clear();
+		return true;
+	}
+	
+	if (records >= COMPACT_MIN_RECORDS && (records - live) * 100 >= records * COMPACT_DEAD_PERCENT)
+		return startCompaction();
+	
+	BinaryBufferWriter journal;
+	int journal_records = writeJournal(&journal);
+	if (!journal_records)
+		return true;
+	
+	if (!appendFile(journal))
+		return false;
+	
+	m_file_records += journal_records;
+	m_dirty.clear();
+	m_dirty_flags.clear();
+	m_deleted.clear();
 	
 	return true;
 }
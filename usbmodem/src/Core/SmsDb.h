@@ -4,14 +4,30 @@
 #include "GsmUtils.h"
 
 #include <vector>
+#include <climits>
 #include <functional>
 #include <map>
+#include <set>
+#include <atomic>
+#include <thread>
+#include <unordered_map>
 
 class SmsDb {
 	public:
-		static constexpr uint8_t DB_VERSION = 0;
+		static constexpr uint8_t DB_VERSION = 1;
 		static constexpr uint32_t DB_MAGIC = 0x534d53;
 		
+		// Compact journal when it has enough records and most of them are dead
+		static constexpr int COMPACT_MIN_RECORDS = 64;
+		static constexpr int COMPACT_DEAD_PERCENT = 50;
+		static constexpr uint32_t MAX_RECORD_SIZE = 1024 * 1024;
+		
+		enum RecordType: uint8_t {
+			RECORD_PUT		= 1,
+			RECORD_DELETE	= 2,
+			RECORD_FLAGS	= 3
+		};
+		
 		enum StorageType {
 			STORAGE_FILESYSTEM,
 			STORAGE_SIM,
@@ -28,7 +44,9 @@ class SmsDb {
 		enum SmsFlags: uint32_t {
 			SMS_NO_FLAGS	= 0,
 			SMS_IS_UNREAD	= 1 << 0,
-			SMS_IS_INVALID	= 1 << 1
+			SMS_IS_INVALID	= 1 << 1,
+			SMS_IS_PENDING	= 1 << 2,	// Outgoing, waits in send queue
+			SMS_IS_FAILED	= 1 << 3	// Outgoing, not sent
 		};
 		
 		struct SmsPart {
@@ -60,10 +78,44 @@ class SmsDb {
 			std::string text;
 		};
 		
+		// Position in list for keyset paging, list is sorted by time and id (newest first)
+		struct SmsCursor {
+			uint64_t time = UINT64_MAX;
+			int id = INT_MAX;
+		};
+		
 		typedef std::function<void(int id)> RemoveSmsCallback;
+		typedef std::function<void()> CompactionCallback;
 	protected:
+		// Newest first, then by id
+		typedef std::pair<uint64_t, int> TimeKey;
+		typedef std::set<TimeKey, std::greater<TimeKey>> TimeIndex;
+		
+		// Multipart SMS which still waits for some parts
+		struct MultipartKey {
+			SmsType type;
+			uint32_t ref_id;
+			size_t parts;
+			std::string addr;
+			std::string smsc;
+			
+			inline bool operator==(const MultipartKey &b) const {
+				return type == b.type && ref_id == b.ref_id && parts == b.parts && addr == b.addr && smsc == b.smsc;
+			}
+		};
+		
+		struct MultipartKeyHash {
+			inline size_t operator()(const MultipartKey &k) const {
+				size_t h = std::hash<std::string>()(k.addr);
+				h ^= std::hash<std::string>()(k.smsc) + 0x9e3779b9 + (h << 6) + (h >> 2);
+				h ^= (static_cast<size_t>(k.ref_id) << 16) ^ (k.parts << 8) ^ k.type;
+				return h;
+			}
+		};
+		
 		int m_capacity = 1000;
 		int m_used_capacity = 0;
+		int m_unread_count = 0;
 		int m_global_sms_id = 0;
 		bool m_inited = false;
 		StorageType m_storage_type = STORAGE_FILESYSTEM;
@@ -71,20 +123,59 @@ class SmsDb {
 		std::string m_tmp_filename = "/tmp/sms.dat.tmp";
 		
 		std::map<int, Sms, std::less<int>> m_storage;
-		std::map<SmsType, std::vector<int>> m_list = {
+		std::map<SmsType, TimeIndex> m_list = {
 			{SMS_INCOMING, {}},
 			{SMS_OUTGOING, {}},
 			{SMS_DRAFT, {}},
 		};
+		std::unordered_multimap<MultipartKey, int, MultipartKeyHash> m_multipart;
 		
 		RemoveSmsCallback m_remove_sms_callback;
+		CompactionCallback m_compaction_callback;
+		
+		// Changes which are not written to journal yet
+		std::set<int> m_dirty;
+		std::set<int> m_dirty_flags;
+		std::vector<int> m_deleted;
+		
+		int m_file_records = 0;
+		bool m_need_rewrite = true;
+		
+		// Compaction writes snapshot in background thread
+		std::thread m_compact_thread;
+		std::atomic<bool> m_compacting = false;
+		std::atomic<bool> m_compact_ok = true;
+		
+		static inline MultipartKey getMultipartKey(const Sms *sms) {
+			return {sms->type, sms->ref_id, sms->parts.size(), sms->addr, sms->smsc};
+		}
+		
+		static bool isComplete(const Sms *sms);
 		
 		Sms *findSameSms(const RawSms &raw);
-		bool serialize(BinaryFileWriter *writer);
-		bool unserialize(BinaryFileReader *reader);
-		void addToList(Sms *sms);
+		
+		static bool serializeSms(BinaryWriterBase *writer, const Sms &sms, bool with_id);
+		static bool unserializeSms(BinaryViewReader *reader, Sms *sms, bool with_id);
+		static void writeRecord(BinaryBufferWriter *writer, RecordType type, BinaryBufferWriter *payload);
+		
+		int writeJournal(BinaryBufferWriter *writer);
+		int writeSnapshot(BinaryBufferWriter *writer);
+		bool writeFile(const BinaryBufferWriter &snapshot);
+		bool appendFile(const BinaryBufferWriter &journal);
+		bool startCompaction();
+		void waitCompaction();
+		
+		bool unserializeLegacy(BinaryViewReader *reader);
+		bool unserializeJournal(BinaryViewReader *reader, size_t *valid_size);
+		bool applyRecord(uint8_t type, BinaryViewReader *reader);
+		void putSms(Sms &&sms);
+		void addToIndex(Sms *sms);
+		void removeFromIndex(Sms *sms);
+		void removeFromMultipart(Sms *sms);
+		void clear();
 	public:
 		SmsDb() { }
+		~SmsDb();
 		
 		inline bool ready() {
 			return m_inited;
@@ -94,6 +185,9 @@ class SmsDb {
 		bool add(const RawSms &raw);
 		bool add(const std::vector<RawSms> &list);
 		
+		// Add complete message, returns new id
+		int insert(Sms &&sms);
+		
 		int getUnreadCount();
 		
 		inline void setStorageType(StorageType storage) {
@@ -130,14 +224,42 @@ class SmsDb {
 		
 		std::vector<Sms> getSmsList(SmsType type, int offset, int limit);
 		
+		/*
+		 * Visit messages older than cursor in place, limit <= 0 means all.
+		 * Returns true and position of last visited message when list has more messages.
+		 * */
+		template <typename T>
+		bool walkSmsList(SmsType type, const SmsCursor &cursor, int offset, int limit, T callback, SmsCursor *next = nullptr) {
+			auto &list = m_list[type];
+			auto it = list.upper_bound({cursor.time, cursor.id});
+			
+			for (; offset > 0 && it != list.end(); offset--)
+				it++;
+			
+			for (int i = 0; it != list.end() && (limit <= 0 || i < limit); it++, i++) {
+				callback(m_storage[it->second]);
+				if (next)
+					*next = {it->first, it->second};
+			}
+			
+			return it != list.end();
+		}
+		
 		std::tuple<bool, Sms> getSmsById(int id);
 		
 		bool deleteSms(int id);
+		bool markRead(int id);
+		bool setFlags(int id, SmsFlags set, SmsFlags clear = SMS_NO_FLAGS);
 		
 		inline void setRemoveSmsCallback(const RemoveSmsCallback &callback) {
 			m_remove_sms_callback = callback;
 		}
 		
+		// Called on the compaction thread, save() must be called again to flush changes made during compaction
+		inline void setCompactionCallback(const CompactionCallback &callback) {
+			m_compaction_callback = callback;
+		}
+		
 		bool load();
 		bool save();
 };
@@ -0,0 +1,178 @@
+#include "TimeSeries.h"
+
+#include <limits>
+#include <algorithm>
+
+/*
+ * Ring
+ * */
+TimeSeries::Ring::Ring(size_t samples, size_t bytes) : m_data(bytes), m_max_samples(samples) {
+
+}
+
+int32_t TimeSeries::Ring::readAbs(size_t offset) const {
+	uint32_t value = 0;
+	for (int i = 0; i < 4; i++)
+		value |= static_cast<uint32_t>(at(offset + i)) << (i * 8);
+	return static_cast<int32_t>(value);
+}
+
+void TimeSeries::Ring::write(uint8_t byte) {
+	m_data[(m_head + m_used) % m_data.size()] = byte;
+	m_used++;
+}
+
+void TimeSeries::Ring::evict() {
+	uint8_t code = at(0);
+	if (code == CODE_ABS) {
+		m_base = readAbs(1);
+	} else if (code != CODE_NAN) {
+		m_base += static_cast<int8_t>(code);
+	}
+	
+	size_t size = entrySize(0);
+	m_head = (m_head + size) % m_data.size();
+	m_used -= size;
+	m_count--;
+}
+
+void TimeSeries::Ring::push(bool valid, int32_t value) {
+	uint8_t code = CODE_NAN;
+	size_t size = 1;
+	
+	if (valid) {
+		int64_t delta = static_cast<int64_t>(value) - m_last;
+		if (m_last_valid && delta >= -127 && delta <= 126) {
+			code = static_cast<uint8_t>(static_cast<int8_t>(delta));
+		} else {
+			code = CODE_ABS;
+			size = 5;
+		}
+	}
+	
+	while (m_count > 0 && (m_count >= m_max_samples || m_used + size > m_data.size()))
+		evict();
+	
+	write(code);
+	if (code == CODE_ABS) {
+		for (int i = 0; i < 4; i++)
+			write((static_cast<uint32_t>(value) >> (i * 8)) & 0xFF);
+	}
+	m_count++;
+	
+	if (valid) {
+		m_last = value;
+		m_last_valid = true;
+	}
+}
+
+void TimeSeries::Ring::clear() {
+	m_head = 0;
+	m_used = 0;
+	m_count = 0;
+	m_last_valid = false;
+}
+
+/*
+ * TimeSeries
+ * */
+TimeSeries::TimeSeries(double scale, Aggregate aggregate) : m_scale(scale), m_aggregate(aggregate) {
+	for (auto &config: TIER_CONFIG)
+		m_tiers.emplace_back(config);
+}
+
+void TimeSeries::flush(Tier *tier) {
+	double value = NAN;
+	if (tier->n > 0)
+		value = (m_aggregate == AGGREGATE_AVG ? tier->sum / tier->n : tier->last);
+	
+	// Missed slots, e.g. loop was busy
+	if (tier->end >= 0) {
+		int64_t gap = tier->slot - tier->end - 1;
+		if (gap >= static_cast<int64_t>(tier->ring.maxSamples())) {
+			tier->ring.clear();
+		} else {
+			for (int64_t i = 0; i < gap; i++)
+				tier->ring.push(false, 0);
+		}
+	}
+	
+	bool valid = !std::isnan(value);
+	int64_t fixed = valid ? std::llround(value * m_scale) : 0;
+	fixed = std::clamp<int64_t>(fixed, std::numeric_limits<int32_t>::min(), std::numeric_limits<int32_t>::max());
+	
+	tier->ring.push(valid, fixed);
+	tier->end = tier->slot;
+}
+
+void TimeSeries::clear(Tier *tier) {
+	tier->ring.clear();
+	tier->end = -1;
+	tier->slot = -1;
+}
+
+void TimeSeries::add(int64_t time_ms, double value) {
+	for (int i = 0; i < TIERS; i++) {
+		auto &tier = m_tiers[i];
+		int64_t slot = time_ms / 1000 / TIER_CONFIG[i].resolution;
+		
+		if (tier.slot != slot) {
+			if (slot < tier.slot) {
+				// Clock moved backwards
+				clear(&tier);
+			} else if (tier.slot >= 0) {
+				flush(&tier);
+			}
+			
+			tier.slot = slot;
+			tier.sum = 0;
+			tier.n = 0;
+			tier.last = NAN;
+		}
+		
+		if (!std::isnan(value)) {
+			tier.sum += value;
+			tier.n++;
+			tier.last = value;
+		}
+	}
+}
+
+std::vector<double> TimeSeries::get(int tier_id, int64_t from, size_t count) const {
+	std::vector<double> result(count, NAN);
+	if (tier_id < 0 || tier_id >= TIERS)
+		return result;
+	
+	auto &tier = m_tiers[tier_id];
+	if (tier.end < 0)
+		return result;
+	
+	int64_t first_slot = from / TIER_CONFIG[tier_id].resolution;
+	int64_t slot = tier.end - static_cast<int64_t>(tier.ring.count()) + 1;
+	
+	tier.ring.forEach([&](bool valid, int32_t value) {
+		int64_t index = slot - first_slot;
+		if (valid && index >= 0 && index < static_cast<int64_t>(count))
+			result[index] = value / m_scale;
+		slot++;
+	});
+	
+	return result;
+}
+
+int TimeSeries::findTier(int64_t seconds, size_t max_points) {
+	for (int i = 0; i < TIERS; i++) {
+		auto &config = TIER_CONFIG[i];
+		size_t points = seconds / config.resolution + 1;
+		if (points <= max_points && points <= config.samples)
+			return i;
+	}
+	return TIERS - 1;
+}
+
+size_t TimeSeries::memoryUsage() const {
+	size_t size = sizeof(*this);
+	for (auto &config: TIER_CONFIG)
+		size += sizeof(Tier) + config.bytes;
+	return size;
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <cmath>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/*
+ * Fixed-memory time series of the one metric with 1 s, 1 min and 15 min tiers.
+ * Values are stored as delta-encoded fixed point numbers, so slowly changing value costs one byte per sample.
+ * */
+class TimeSeries {
+	public:
+		enum Aggregate {
+			AGGREGATE_AVG,		// levels
+			AGGREGATE_LAST,		// enums, ids
+		};
+		
+		struct TierConfig {
+			int resolution;		// seconds
+			size_t samples;
+			size_t bytes;
+		};
+		
+		static constexpr int TIERS = 3;
+		static constexpr TierConfig TIER_CONFIG[TIERS] = {
+			{1,		3600,	4096},		// 1 hour
+			{60,	1440,	2048},		// 1 day
+			{900,	672,	1024},		// 1 week
+		};
+	protected:
+		/*
+		 * Byte ring of the entries: delta (1 byte), CODE_NAN (1 byte) or CODE_ABS + int32 (5 bytes).
+		 * Delta is relative to the last valid value, so evicted entry is applied to the m_base.
+		 * */
+		class Ring {
+			protected:
+				static constexpr uint8_t CODE_ABS = 0x7F;
+				static constexpr uint8_t CODE_NAN = 0x80;
+				
+				std::vector<uint8_t> m_data;
+				size_t m_max_samples = 0;
+				size_t m_head = 0;
+				size_t m_used = 0;
+				size_t m_count = 0;
+				
+				// Reference value before the oldest entry and after the newest entry
+				int32_t m_base = 0;
+				int32_t m_last = 0;
+				bool m_last_valid = false;
+				
+				inline uint8_t at(size_t offset) const {
+					return m_data[(m_head + offset) % m_data.size()];
+				}
+				
+				inline size_t entrySize(size_t offset) const {
+					return at(offset) == CODE_ABS ? 5 : 1;
+				}
+				
+				int32_t readAbs(size_t offset) const;
+				void write(uint8_t byte);
+				void evict();
+			public:
+				Ring(size_t samples, size_t bytes);
+				
+				void push(bool valid, int32_t value);
+				void clear();
+				
+				inline size_t count() const {
+					return m_count;
+				}
+				
+				inline size_t maxSamples() const {
+					return m_max_samples;
+				}
+				
+				// Callback(bool valid, int32_t value) for each sample, oldest first
+				template <typename F>
+				void forEach(F callback) const {
+					int32_t value = m_base;
+					size_t offset = 0;
+					
+					while (offset < m_used) {
+						uint8_t code = at(offset);
+						if (code == CODE_NAN) {
+							callback(false, 0);
+						} else {
+							value = code == CODE_ABS ? readAbs(offset + 1) : value + static_cast<int8_t>(code);
+							callback(true, value);
+						}
+						offset += entrySize(offset);
+					}
+				}
+		};
+		
+		struct Tier {
+			Ring ring;
+			int64_t end = -1;		// slot of the newest entry
+			
+			// Current slot, written to the ring when next slot starts
+			int64_t slot = -1;
+			double sum = 0;
+			int n = 0;
+			double last = NAN;
+			
+			explicit Tier(const TierConfig &config) : ring(config.samples, config.bytes) { }
+		};
+		
+		std::vector<Tier> m_tiers;
+		double m_scale;
+		Aggregate m_aggregate;
+		
+		void flush(Tier *tier);
+		void clear(Tier *tier);
+	public:
+		explicit TimeSeries(double scale = 1, Aggregate aggregate = AGGREGATE_AVG);
+		
+		// NAN - no value
+		void add(int64_t time_ms, double value);
+		
+		// Values of [from, from + count * resolution), NAN - no data
+		std::vector<double> get(int tier, int64_t from, size_t count) const;
+		
+		// Finest tier which covers range without exceeding max_points
+		static int findTier(int64_t seconds, size_t max_points);
+		
+		size_t memoryUsage() const;
+};
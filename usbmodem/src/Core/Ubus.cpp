@@ -163,13 +163,31 @@ bool Ubus::reply(ubus_request_data *req, const json &params) {
 	return ret == 0;
 }
 
+bool Ubus::reply(ubus_request_data *req, blob_attr *msg) {
+	UbusLoop::assertThread();
+	return ubus_send_reply(m_ctx, req, msg) == 0;
+}
+
+bool Ubus::notify(ubus_object *obj, const std::string &type, blob_attr *msg) {
+	UbusLoop::assertThread();
+	// Don't wait for subscribers
+	return ubus_notify(m_ctx, obj, type.c_str(), msg, -1) == 0;
+}
+
 bool Ubus::deferFinish(UbusDeferRequest *req, int status, const json &params, bool cleanup) {
 	UbusLoop::assertThread();
 	
-	if (status == UBUS_STATUS_OK) {
+	if (status == UBUS_STATUS_OK)
 		blobmsgFromJson(&req->b, params);
-		ubus_send_reply(m_ctx, &req->r, req->b.head);
-	}
+	
+	return deferFinish(req, status, req->b.head, cleanup);
+}
+
+bool Ubus::deferFinish(UbusDeferRequest *req, int status, blob_attr *msg, bool cleanup) {
+	UbusLoop::assertThread();
+	
+	if (status == UBUS_STATUS_OK)
+		ubus_send_reply(m_ctx, &req->r, msg);
 	ubus_complete_deferred_request(m_ctx, &req->r, status);
 	blob_buf_free(&req->b);
 	if (cleanup)
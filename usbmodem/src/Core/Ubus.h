@@ -55,7 +55,10 @@ class Ubus {
 		
 		UbusDeferRequest *defer(ubus_request_data *original_req);
 		bool deferFinish(UbusDeferRequest *req, int status, const json &params, bool cleanup = true);
+		bool deferFinish(UbusDeferRequest *req, int status, blob_attr *msg, bool cleanup = true);
 		bool reply(ubus_request_data *req, const json &params);
+		bool reply(ubus_request_data *req, blob_attr *msg);
+		bool notify(ubus_object *obj, const std::string &type, blob_attr *msg);
 		
 		static void onCallComplete(ubus_request *r, int ret);
 		static void onCallData(ubus_request *r, int type, blob_attr *msg);
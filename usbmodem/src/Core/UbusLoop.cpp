@@ -17,10 +17,9 @@ void UbusLoop::implInit() {
 		instance()->runTimeouts();
 	};
 	
-	m_waker.fd = m_waker_r;
+	// Waker is reset in runTimeouts()
+	m_waker.fd = m_waker_fd;
 	m_waker.cb = +[](struct uloop_fd *ufd, unsigned int events) {
-		static char buf[4];
-		while (read(ufd->fd, buf, sizeof(buf)) > 0 || errno == EINTR);
 		instance()->runTimeouts();
 	};
 	
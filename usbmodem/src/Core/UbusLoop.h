@@ -38,25 +38,26 @@ class UbusLoop: public LoopBase {
 		
 		template <typename T>
 		static inline std::optional<T> exec(const std::function<T()> &callback) {
-			auto value = instance()->execOnThisThread(callback);
-			if (value.type() == typeid(void))
-				return std::nullopt;
-			return std::any_cast<T>(value);
+			return instance()->execOnThisThread<T>(callback);
 		}
 		
-		static inline int setTimeout(const std::function<void()> &callback, int timeout_ms) {
+		static inline bool post(const std::function<void()> &callback) {
+			return instance()->postTask(callback);
+		}
+		
+		static inline int64_t setTimeout(const std::function<void()> &callback, int timeout_ms) {
 			return instance()->addTimer(callback, timeout_ms, false);
 		}
 		
-		static inline int setInterval(const std::function<void()> &callback, int timeout_ms) {
+		static inline int64_t setInterval(const std::function<void()> &callback, int timeout_ms) {
 			return instance()->addTimer(callback, timeout_ms, true);
 		}
 		
-		static inline void clearTimeout(int id) {
+		static inline void clearTimeout(int64_t id) {
 			instance()->removeTimer(id);
 		}
 		
-		static inline void clearInterval(int id) {
+		static inline void clearInterval(int64_t id) {
 			instance()->removeTimer(id);
 		}
 };
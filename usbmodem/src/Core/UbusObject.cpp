@@ -12,6 +12,7 @@ UbusObject::UbusObject() {
 	m_object.o.name = nullptr;
 	m_object.o.n_methods = 0;
 	m_object.o.methods = nullptr;
+	m_object.o.subscribe_cb = ubusSubscribeHandler;
 }
 
 void UbusObject::setName(const std::string &name) {
@@ -70,6 +71,23 @@ int UbusObject::ubusMethodHandler(ubus_context *ctx, ubus_object *obj, ubus_requ
 	return object_wrap->self->callHandler(method, req, attr);
 }
 
+void UbusObject::ubusSubscribeHandler(ubus_context *ctx, ubus_object *obj) {
+	ObjectWrap *object_wrap = reinterpret_cast<ObjectWrap *>(obj);
+	if (object_wrap->self->m_subscribe_callback)
+		object_wrap->self->m_subscribe_callback(obj->has_subscribers);
+}
+
+UbusObject &UbusObject::onSubscribe(const SubscribeCallback &callback) {
+	m_subscribe_callback = callback;
+	return *this;
+}
+
+bool UbusObject::notify(const std::string &type, blob_attr *msg) {
+	if (!m_registered || !m_object.o.has_subscribers)
+		return false;
+	return m_ubus->notify(getObject(), type, msg);
+}
+
 UbusObject &UbusObject::method(const std::string &name, const Callback &callback, const std::map<std::string, int> &fields) {
 	if (m_registered)
 		throw std::runtime_error("UbusObject is readonly, because it already registered to ubus.");
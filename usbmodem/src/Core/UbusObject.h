@@ -24,6 +24,7 @@ class UbusObject {
 	
 	public:
 		typedef std::function<int(std::shared_ptr<UbusRequest>)> Callback;
+		typedef std::function<void(bool)> SubscribeCallback;
 		
 		enum FieldType: int {
 			UNSPEC		= BLOBMSG_TYPE_UNSPEC,
@@ -51,6 +52,7 @@ class UbusObject {
 		std::vector<ubus_method> m_methods;
 		std::vector<char *> m_names;
 		Ubus *m_ubus = nullptr;
+		SubscribeCallback m_subscribe_callback;
 		
 		char *createName(const char *name, size_t length);
 		blobmsg_policy *createBlobmsgPolicy(const std::map<std::string, int> &fields, int *count);
@@ -69,6 +71,7 @@ class UbusObject {
 		int findMethodByName(const char *name);
 		int callHandler(const char *method_name, ubus_request_data *req, blob_attr *msg);
 		static int ubusMethodHandler(ubus_context *ctx, ubus_object *obj, ubus_request_data *req, const char *method, blob_attr *attr);
+		static void ubusSubscribeHandler(ubus_context *ctx, ubus_object *obj);
 	public:
 		void operator=(const UbusObject &) = delete;
 		
@@ -82,5 +85,14 @@ class UbusObject {
 			return m_object.o.id;
 		}
 		
+		inline bool hasSubscribers() const {
+			return m_object.o.has_subscribers;
+		}
+		
 		UbusObject &method(const std::string &name, const Callback &callback, const std::map<std::string, int> &fields = {});
+		
+		// Called when first subscriber is added or last is removed
+		UbusObject &onSubscribe(const SubscribeCallback &callback);
+		
+		bool notify(const std::string &type, blob_attr *msg);
 };
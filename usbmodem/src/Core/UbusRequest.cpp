@@ -1,3 +1,5 @@
+#define LOG_CATEGORY LOG_CAT_UBUS
+
 #include "UbusRequest.h"
 
 size_t UbusRequest::m_global_req_id = 0;
@@ -23,7 +25,7 @@ const json &UbusRequest::data() {
 	return m_json;
 }
 
-bool UbusRequest::reply(const json &params, int status) {
+bool UbusRequest::canReply(int status) {
 	if (m_done) {
 		LOGE("Request already replied!\n");
 		return false;
@@ -34,6 +36,13 @@ bool UbusRequest::reply(const json &params, int status) {
 		return false;
 	}
 	
+	return true;
+}
+
+bool UbusRequest::reply(const json &params, int status) {
+	if (!canReply(status))
+		return false;
+	
 	if (m_defer_req) {
 		if (m_ubus->deferFinish(m_defer_req, status, params, false)) {
 			m_done = true;
@@ -50,6 +59,26 @@ bool UbusRequest::reply(const json &params, int status) {
 	return false;
 }
 
+bool UbusRequest::replyBlob(blob_attr *msg, int status) {
+	if (!canReply(status))
+		return false;
+	
+	if (m_defer_req) {
+		if (m_ubus->deferFinish(m_defer_req, status, msg, false)) {
+			m_done = true;
+			m_defer_req = nullptr;
+			return true;
+		}
+	} else {
+		if (m_ubus->reply(m_req, msg)) {
+			m_done = true;
+			return true;
+		}
+	}
+	
+	return false;
+}
+
 void UbusRequest::defer() {
 	if (!m_defer_req && !m_done)
 		m_defer_req = m_ubus->defer(m_req);
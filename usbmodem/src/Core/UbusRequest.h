@@ -33,6 +33,8 @@ class UbusRequest {
 		size_t m_req_id = 0;
 		int64_t m_time = 0;
 		static size_t m_global_req_id;
+		
+		bool canReply(int status);
 	public:
 		UbusRequest(Ubus *ubus, ubus_request_data *req, blob_attr *data);
 		~UbusRequest();
@@ -50,6 +52,11 @@ class UbusRequest {
 		}
 		
 		bool reply(const json &params, int status = 0);
+		bool replyBlob(blob_attr *msg, int status = 0);
 		void defer();
 		const json &data();
+		
+		inline BlobReader args() const {
+			return BlobReader(m_data);
+		}
 };
@@ -3,6 +3,7 @@
 #include "Log.h"
 
 #include <algorithm> 
+#include <array>
 #include <cctype> 
 #include <cmath> 
 #include <csignal>
@@ -40,6 +41,16 @@ int64_t getCurrentTimestamp() {
 	return timespecToMs(&tm);
 }
 
+int64_t getMonotonicTimestampUs() {
+	struct timespec tm = {};
+	
+	int ret = clock_gettime(CLOCK_MONOTONIC, &tm);
+	if (ret != 0)
+		throw std::string("clock_gettime fatal error");
+	
+	return static_cast<int64_t>(tm.tv_sec) * 1000000 + tm.tv_nsec / 1000;
+}
+
 void setTimespecTimeout(struct timespec *tm, int timeout) {
 	msToTimespec(getCurrentTimestamp() + timeout, tm);
 }
@@ -164,27 +175,59 @@ std::string bin2hex(const std::string &raw, bool uc) {
 	return out;
 }
 
+const std::array<uint8_t, 256> HEX_TO_NIBBLE = []() {
+	std::array<uint8_t, 256> table = {};
+	for (size_t i = 0; i < table.size(); i++) {
+		int value = hex2byte(static_cast<char>(i));
+		table[i] = value < 0 ? 0xFF : value;
+	}
+	return table;
+}();
+
 std::pair<bool, std::string> tryHexToBin(const std::string &hex) {
 	if ((hex.size() % 2) != 0)
-		return tryHexToBin("0" + hex.size());
+		return tryHexToBin("0" + hex);
 	
 	if (!hex.size())
 		return std::make_pair(false, "");
 	
 	std::string out;
-	out.reserve(hex.size() / 2);
+	out.resize(hex.size() / 2);
+	
+	const uint8_t *r = reinterpret_cast<const uint8_t *>(hex.c_str());
+	char *w = out.data();
+	size_t out_len = out.size();
+	size_t i = 0;
+	
+	// Decode 4 bytes at a time, invalid chars are checked once per block
+	for (; out_len - i >= 4; i += 4, r += 8) {
+		uint8_t n[8];
+		uint8_t invalid = 0;
+		for (int j = 0; j < 8; j++) {
+			n[j] = HEX_TO_NIBBLE[r[j]];
+			invalid |= n[j];
+		}
+		
+		if ((invalid & 0xF0))
+			return std::make_pair(false, "");
+		
+		w[i + 0] = static_cast<char>((n[0] << 4) | n[1]);
+		w[i + 1] = static_cast<char>((n[2] << 4) | n[3]);
+		w[i + 2] = static_cast<char>((n[4] << 4) | n[5]);
+		w[i + 3] = static_cast<char>((n[6] << 4) | n[7]);
+	}
 	
-	for (size_t i = 0; i < hex.size(); i += 2) {
-		int upper = hex2byte(hex[i]);
-		int lower = hex2byte(hex[i + 1]);
+	for (; i < out_len; i++, r += 2) {
+		uint8_t upper = HEX_TO_NIBBLE[r[0]];
+		uint8_t lower = HEX_TO_NIBBLE[r[1]];
 		
-		if (upper < 0 || lower < 0)
+		if (((upper | lower) & 0xF0))
 			return std::make_pair(false, "");
 		
-		out += static_cast<char>((upper << 4) | lower);
+		w[i] = static_cast<char>((upper << 4) | lower);
 	}
 	
-	return std::make_pair(true, out);
+	return std::make_pair(true, std::move(out));
 }
 
 std::string decodeBcd(const std::string &raw) {
@@ -210,6 +253,23 @@ std::string decodeBcd(const std::string &raw) {
 	return out;
 }
 
+std::pair<bool, std::string> encodeBcd(const std::string &digits) {
+	std::string out;
+	out.reserve((digits.size() + 1) / 2);
+	
+	for (size_t i = 0; i < digits.size(); i += 2) {
+		int lower = bcdDigit(digits[i]);
+		int upper = i + 1 < digits.size() ? bcdDigit(digits[i + 1]) : 0xF;
+		
+		if (lower < 0 || upper < 0)
+			return std::make_pair(false, "");
+		
+		out += static_cast<char>((upper << 4) | lower);
+	}
+	
+	return std::make_pair(true, out);
+}
+
 std::string converOctalIpv6(const std::string &value) {
 	const char *cursor = value.c_str();
 	std::string out;
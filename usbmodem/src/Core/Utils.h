@@ -5,7 +5,9 @@
 #include <time.h>
 
 #include <cmath>
+#include <array>
 #include <string>
+#include <string_view>
 #include <cerrno>
 #include <cstdint>
 #include <cstring>
@@ -22,6 +24,9 @@ void setSignalHandler(int signal, const std::function<void(int)> &callback);
 
 int64_t getCurrentTimestamp();
 
+// Monotonic, in microseconds, for measuring durations
+int64_t getMonotonicTimestampUs();
+
 constexpr bool isLittleEndian() {
 	return __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__;
 }
@@ -47,8 +52,8 @@ static inline bool strHasEol(const std::string &s) {
 	return s.size() >= 2 && s[s.size() - 2] == '\r' && s[s.size() - 1] == '\n';
 }
 
-static inline bool strStartsWith(const std::string &a, const std::string &b) {
-	return a.size() >= b.size() && memcmp(a.c_str(), b.c_str(), b.size()) == 0;
+static inline bool strStartsWith(std::string_view a, std::string_view b) {
+	return a.size() >= b.size() && memcmp(a.data(), b.data(), b.size()) == 0;
 }
 
 void setTimespecTimeout(struct timespec *tm, int timeout);
@@ -63,6 +68,16 @@ static inline int hex2byte(char c) {
 	return -1;
 }
 
+static inline int bcdDigit(char c) {
+	if (c >= '0' && c <= '9')
+		return c - '0';
+	if (c == '*')
+		return 0xA;
+	if (c == '#')
+		return 0xB;
+	return -1;
+}
+
 int strToInt(const std::string &s, int base = 10, int default_value = 0);
 
 std::string long2ip(uint32_t ip);
@@ -72,15 +87,19 @@ std::string converOctalIpv6(const std::string &value);
 int getIpType(const std::string &raw_ip, bool allow_dec_v6 = false);
 bool normalizeIp(std::string *raw_ip, int require_ipv = 0, bool allow_dec_v6 = false);
 
+// Hex char to nibble, 0xFF means invalid char
+extern const std::array<uint8_t, 256> HEX_TO_NIBBLE;
+
 std::pair<bool, std::string> tryHexToBin(const std::string &hex);
 
 std::string bin2hex(const std::string &raw, bool uc = false);
 
 std::string decodeBcd(const std::string &raw);
+std::pair<bool, std::string> encodeBcd(const std::string &digits);
 
 inline std::string hex2bin(const std::string &hex) {
 	auto [success, decoded] = tryHexToBin(hex);
-	return success ? decoded : hex;
+	return success ? std::move(decoded) : hex;
 }
 
 std::string urlencode(const std::string &str);
@@ -1,5 +1,7 @@
 #include "Modem.h"
 
+#include <Core/Loop.h>
+
 const char *Modem::getEnumName(NetworkTech tech, bool is_human_readable) {
 	if (is_human_readable) {
 		switch (tech) {
@@ -186,12 +188,33 @@ const char *Modem::getEnumName(NetworkMode state, bool is_human_readable) {
 	}
 }
 
-std::tuple<bool, std::any> Modem::cached(const std::string &key, std::function<std::any()> callback, int version) {
-	if (m_cache.find(key) == m_cache.end() || m_cache[key].version != version) {
-		auto value = callback();
-		if (value.type() == typeid(nullptr) || value.type() == typeid(void))
-			return {false, {}};
-		m_cache[key] = {value, version};
-	}
-	return {true, m_cache[key].value};
+int64_t Modem::setTimeout(const std::function<void()> &callback, int timeout_ms) {
+	auto id = std::make_shared<int64_t>(-1);
+	
+	std::lock_guard lock(m_timers_mutex);
+	*id = Loop::setTimeout([this, id, callback]() {
+		m_timers_mutex.lock();
+		m_timers.erase(*id);
+		m_timers_mutex.unlock();
+		
+		callback();
+	}, timeout_ms);
+	
+	if (*id != -1)
+		m_timers.insert(*id);
+	
+	return *id;
+}
+
+void Modem::clearTimeout(int64_t id) {
+	std::lock_guard lock(m_timers_mutex);
+	m_timers.erase(id);
+	Loop::clearTimeout(id);
+}
+
+void Modem::clearTimers() {
+	std::lock_guard lock(m_timers_mutex);
+	for (int64_t id: m_timers)
+		Loop::clearTimeout(id);
+	m_timers.clear();
 }
@@ -1,13 +1,19 @@
 #pragma once
 
 #include <any>
+#include <set>
+#include <map>
+#include <mutex>
 #include <string>
+#include <optional>
 #include <functional>
 #include <cmath>
 
 #include <Core/Log.h>
+#include <Core/Cache.h>
 #include <Core/Events.h>
 #include <Core/SmsDb.h>
+#include <Core/Histogram.h>
 
 /*
  * Generic modem interface
@@ -142,6 +148,9 @@ class Modem {
 			SMS_LIST_UNREAD
 		};
 		
+		// Message reference (TP-MR) on success, or error text
+		typedef std::function<void(bool, int, const std::string &)> SmsSendCallback;
+		
 		/*
 		 * Network operators
 		 * */
@@ -182,6 +191,30 @@ class Modem {
 			std::string name;
 		};
 		
+		typedef std::function<void(bool, const std::vector<Operator> &)> SearchOperatorsCallback;
+		typedef std::function<void(bool, const std::string &)> AtCommandCallback;
+		
+		/*
+		 * Control channel stats
+		 * */
+		struct AtCommandStats {
+			uint64_t count = 0;
+			uint64_t errors = 0;
+			uint64_t timeouts = 0;
+			Histogram latency;		// from sending command to final response, us
+			Histogram queue;		// waiting in the queue before sending, us
+		};
+		
+		struct AtStats {
+			// Key is a command name without arguments: AT+CREG=2 -> AT+CREG
+			std::map<std::string, AtCommandStats> commands;
+			std::vector<std::pair<std::string, uint64_t>> urc;
+			uint64_t urc_unhandled = 0;
+			uint64_t bytes_read = 0;
+			uint64_t bytes_written = 0;
+			uint64_t reader_wakeups = 0;
+		};
+		
 		/*
 		 * Info
 		 * */
@@ -209,6 +242,14 @@ class Modem {
 			NetworkCell cell;
 		};
 		
+		// Last known network state, without modem requests
+		struct NetworkState {
+			NetworkReg reg = NET_NOT_REGISTERED;
+			NetworkTech tech = TECH_NO_SERVICE;
+			NetworkSignal signal;
+			NetworkCell cell;
+		};
+		
 		struct ModemInfo {
 			std::string imei;
 			std::string vendor;
@@ -288,23 +329,52 @@ class Modem {
 		
 		/*
 		 * Cache
+		 * Fresh value is returned from memory, stale value is returned as is and refreshed on the modem thread,
+		 * empty or invalidated value is fetched right now.
 		 * */
-		struct CacheItem {
-			std::any value;
-			int version;
-		};
-		
-		std::map<std::string, CacheItem> m_cache;
-		
-		std::tuple<bool, std::any> cached(const std::string &key, std::function<std::any()> callback, int version = 0);
-		
 		template <typename T>
-		std::tuple<bool, T> cached(const std::string &key, std::function<std::any()> callback, int version = 0) {
-			auto [status, value] = cached(key, callback, version);
-			return {status, std::any_cast<T>(value)};
+		std::tuple<bool, T> cached(Cache<T> &cache, const std::function<std::optional<T>()> &fetch) {
+			auto state = cache.state();
+			if (state == CacheBase::CACHE_FRESH)
+				return {true, cache.value()};
+			
+			if (state == CacheBase::CACHE_STALE) {
+				if (!cache.isRefreshing()) {
+					cache.setRefreshing(true);
+					setTimeout([&cache, fetch]() {
+						uint32_t generation = cache.generation();
+						auto value = fetch();
+						if (value)
+							cache.set(*value, generation);
+						cache.setRefreshing(false);
+					}, 0);
+				}
+				return {true, cache.value()};
+			}
+			
+			uint32_t generation = cache.generation();
+			auto value = fetch();
+			if (!value)
+				return {false, {}};
+			
+			cache.set(*value, generation);
+			return {true, *value};
 		}
+		
+		/*
+		 * Timers owned by this modem, cleared on destroy
+		 * */
+		std::mutex m_timers_mutex;
+		std::set<int64_t> m_timers;
+		
+		int64_t setTimeout(const std::function<void()> &callback, int timeout_ms);
+		void clearTimeout(int64_t id);
 	public:
-		virtual ~Modem() { }
+		virtual ~Modem() {
+			clearTimers();
+		}
+		
+		void clearTimers();
 		
 		/*
 		 * Main Operations
@@ -318,6 +388,7 @@ class Modem {
 		virtual std::tuple<bool, ModemInfo> getModemInfo() = 0;
 		virtual std::tuple<bool, SimInfo> getSimInfo() = 0;
 		virtual std::tuple<bool, NetworkInfo> getNetworkInfo() = 0;
+		virtual std::tuple<bool, NetworkState> getNetworkState() = 0;
 		inline std::unordered_map<std::string, std::vector<std::pair<std::string, std::any>>> getCustomInfo() {
 			return m_custom_info;
 		}
@@ -325,7 +396,7 @@ class Modem {
 		/*
 		 * Network
 		 * */
-		virtual std::tuple<bool, std::vector<Operator>> searchOperators() = 0;
+		virtual bool searchOperators(const SearchOperatorsCallback &callback) = 0;
 		virtual bool setOperator(OperatorRegMode mode, int mcc = -1, int mnc = -1, NetworkTech tech = TECH_UNKNOWN) = 0;
 		
 		virtual std::tuple<bool, std::vector<NetworkMode>> getNetworkModes() = 0;
@@ -356,12 +427,19 @@ class Modem {
 		virtual SmsStorage getSmsStorage() = 0;
 		virtual std::tuple<bool, std::vector<SmsDb::RawSms>> getSmsList(SmsListType list) = 0;
 		
+		/*
+		 * Send one PDU, more_messages=true keeps radio link open for next message.
+		 * Callback is called on the Loop thread.
+		 * */
+		virtual bool sendSms(const SmsSubmitPdu &pdu, bool more_messages, const SmsSendCallback &callback) = 0;
+		
 		/*
 		 * Internals
 		 * */
 		virtual IfaceProto getIfaceProto() = 0;
 		virtual int getDelayAfterDhcpRelease() = 0;
-		virtual std::pair<bool, std::string> sendAtCommand(const std::string &cmd, int timeout) = 0;
+		virtual bool sendAtCommand(const std::string &cmd, int timeout, const AtCommandCallback &callback) = 0;
+		virtual std::tuple<bool, AtStats> getAtStats() = 0;
 		virtual std::vector<Capability> getCapabilities() = 0;
 		
 		/*
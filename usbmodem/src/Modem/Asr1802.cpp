@@ -4,7 +4,7 @@
 #include <Core/Loop.h>
 #include <Core/GsmUtils.h>
 
-void Asr1802Modem::handleMmsg(const std::string &event) {
+void Asr1802Modem::handleMmsg(std::string_view event) {
 	int status;
 	bool success = AtParser(event)
 		.parseInt(&status)
@@ -12,7 +12,7 @@ void Asr1802Modem::handleMmsg(const std::string &event) {
 	
 	// SMS ready
 	if (success && status == 0) {
-		Loop::setTimeout([this]() {
+		setTimeout([this]() {
 			intiSms();
 		}, 100);
 	}
@@ -78,64 +78,64 @@ bool Asr1802Modem::init() {
 	if (!syncApn())
 		return false;
 	
-	auto network_creg_handler = [this](const std::string &event) {
+	auto network_creg_handler = [this](std::string_view event) {
 		handleCreg(event);
 	};
 	m_at.onUnsolicited("+CREG", network_creg_handler);
 	m_at.onUnsolicited("+CGREG", network_creg_handler);
 	m_at.onUnsolicited("+CEREG", network_creg_handler);
 	
-	m_at.onUnsolicited("+CUSD", [this](const std::string &event) {
+	m_at.onUnsolicited("+CUSD", [this](std::string_view event) {
 		handleCusd(event);
 	});
-	m_at.onUnsolicited("+CGEV", [this](const std::string &event) {
+	m_at.onUnsolicited("+CGEV", [this](std::string_view event) {
 		handleCgev(event);
 	});
-	m_at.onUnsolicited("+CESQ", [this](const std::string &event) {
+	m_at.onUnsolicited("+CESQ", [this](std::string_view event) {
 		handleCesq(event);
 	});
-	m_at.onUnsolicited("+CPIN", [this](const std::string &event) {
+	m_at.onUnsolicited("+CPIN", [this](std::string_view event) {
 		handleCpin(event);
 	});
-	m_at.onUnsolicited("+MMSG", [this](const std::string &event) {
+	m_at.onUnsolicited("+MMSG", [this](std::string_view event) {
 		handleMmsg(event);
 	});
-	m_at.onUnsolicited("+CMT", [this](const std::string &event) {
+	m_at.onUnsolicited("+CMT", [this](std::string_view event) {
 		handleCmt(event);
 	});
-	m_at.onUnsolicited("+CMTI", [this](const std::string &event) {
+	m_at.onUnsolicited("+CMTI", [this](std::string_view event) {
 		handleCmt(event);
 	});
 	
-	m_at.onUnsolicited("+EEMGINFO", [this](const std::string &event) {
+	m_at.onUnsolicited("+EEMGINFO", [this](std::string_view event) {
 		handleEngInfoStart(event);
 	});
 	
-	m_at.onUnsolicited("+EEMGINFO ", [this](const std::string &event) {
+	m_at.onUnsolicited("+EEMGINFO ", [this](std::string_view event) {
 		handleEngInfoStart(event);
 	});
 	
 	// Serving Cell
-	m_at.onUnsolicited("+EEMLTESVC", [this](const std::string &event) {
+	m_at.onUnsolicited("+EEMLTESVC", [this](std::string_view event) {
 		handleServingCell(event);
 	});
-	m_at.onUnsolicited("+EEMUMTSSVC", [this](const std::string &event) {
+	m_at.onUnsolicited("+EEMUMTSSVC", [this](std::string_view event) {
 		handleServingCell(event);
 	});
-	m_at.onUnsolicited("+EEMGINFOSVC", [this](const std::string &event) {
+	m_at.onUnsolicited("+EEMGINFOSVC", [this](std::string_view event) {
 		handleServingCell(event);
 	});
 	
 	// Neighboring Cell
-	m_at.onUnsolicited("+EEMUMTSINTER", [this](const std::string &event) {
+	m_at.onUnsolicited("+EEMUMTSINTER", [this](std::string_view event) {
 		handleNeighboringCell(event);
 	});
-	m_at.onUnsolicited("+EEMUMTSINTRA", [this](const std::string &event) {
+	m_at.onUnsolicited("+EEMUMTSINTRA", [this](std::string_view event) {
 		handleNeighboringCell(event);
 	});
 	
 	if (!m_force_restart_network) {
-		Loop::setTimeout([this]() {
+		Loop::post([this]() {
 			// Detect, if already have internet
 			if (m_data_state == DISCONNECTED) {
 				int cid = getCurrentPdpCid();
@@ -148,7 +148,7 @@ bool Asr1802Modem::init() {
 			m_at.sendCommandNoResponse("AT+CGREG?");
 			m_at.sendCommandNoResponse("AT+CEREG?");
 			m_at.sendCommandNoResponse("AT+CESQ");
-		}, 0);
+		});
 	}
 	
 	on<EvDataDisconnected>([this](const auto &event) {
@@ -161,7 +161,7 @@ bool Asr1802Modem::init() {
 	
 	on<EvSimStateChanged>([this](const auto &event) {
 		if (event.state == SIM_READY) {
-			Loop::setTimeout([this]() {
+			setTimeout([this]() {
 				intiSms();
 			}, 1000);
 		}
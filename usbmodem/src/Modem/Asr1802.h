@@ -30,7 +30,7 @@ class Asr1802Modem: public BaseAtModem {
 		 * Network
 		 * */
 		DataConnectState m_data_state = DISCONNECTED;
-		int m_manual_connect_timeout = -1;
+		int64_t m_manual_connect_timeout = -1;
 		int m_connect_errors = 0;
 		bool m_prefer_dhcp = false;
 		bool m_force_restart_network = false;
@@ -49,12 +49,12 @@ class Asr1802Modem: public BaseAtModem {
 		IfaceProto getIfaceProto() override;
 		int getDelayAfterDhcpRelease() override;
 		
-		void handleCgev(const std::string &event);
-		void handleCesq(const std::string &event);
-		void handleMmsg(const std::string &event);
-		void handleServingCell(const std::string &event);
-		void handleNeighboringCell(const std::string &event);
-		void handleEngInfoStart(const std::string &event);
+		void handleCgev(std::string_view event);
+		void handleCesq(std::string_view event);
+		void handleMmsg(std::string_view event);
+		void handleServingCell(std::string_view event);
+		void handleNeighboringCell(std::string_view event);
+		void handleEngInfoStart(std::string_view event);
 		
 		std::tuple<bool, std::vector<NetworkMode>> getNetworkModes() override;
 		bool setNetworkMode(NetworkMode new_mode) override;
@@ -74,7 +74,7 @@ class Asr1802Modem: public BaseAtModem {
 		/*
 		 * Engineering Info
 		 * */
-		int m_eng_recheck_timeout = -1;
+		int64_t m_eng_recheck_timeout = -1;
 		int64_t m_eng_last_requested = 0;
 		
 		void requestEngInfo();
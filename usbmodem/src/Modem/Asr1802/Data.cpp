@@ -1,3 +1,5 @@
+#define LOG_CATEGORY LOG_CAT_NET
+
 #include "../Asr1802.h"
 #include <Core/Loop.h>
 
@@ -294,17 +296,17 @@ void Asr1802Modem::startDataConnection() {
 	m_data_state = CONNECTING;
 	emit<EvDataConnecting>({});
 	
-	Loop::setTimeout([this]() {
+	Loop::post([this]() {
 		if (dial()) {
 			handleConnect();
 		} else {
 			handleDisconnect();
 			
 			// Try reconnect after few seconds
-			m_manual_connect_timeout = Loop::setTimeout([this]() {
+			m_manual_connect_timeout = setTimeout([this]() {
 				m_manual_connect_timeout = -1;
 				startDataConnection();
 			}, 1000);
 		}
-	}, 0);
+	});
 }
@@ -4,7 +4,7 @@
 void Asr1802Modem::wakeEngTimer() {
 	if (getCurrentTimestamp() - m_eng_last_requested >= ENG_INFO_UPDATE_TIMEOUT) {
 		m_eng_last_requested = getCurrentTimestamp();
-		Loop::clearTimeout(m_eng_recheck_timeout);
+		clearTimeout(m_eng_recheck_timeout);
 		m_eng_recheck_timeout = -1;
 		startEngPolling();
 	} else {
@@ -19,7 +19,7 @@ void Asr1802Modem::startEngPolling() {
 	requestEngInfo();
 	
 	int timeout = getCurrentTimestamp() - m_eng_last_requested < ENG_INFO_UPDATE_TIMEOUT ? 2000 : 60000;
-	m_eng_recheck_timeout = Loop::setTimeout([this]() {
+	m_eng_recheck_timeout = setTimeout([this]() {
 		m_eng_recheck_timeout = -1;
 		startEngPolling();
 	}, timeout);
@@ -29,48 +29,52 @@ void Asr1802Modem::requestEngInfo() {
 	m_at.sendCommandNoResponse("AT+EEMGINFO?");
 }
 
-void Asr1802Modem::handleEngInfoStart(const std::string &event) {
+void Asr1802Modem::handleEngInfoStart(std::string_view event) {
 	m_neighboring_cell.clear();
 }
 
-void Asr1802Modem::handleNeighboringCell(const std::string &event) {
+void Asr1802Modem::handleNeighboringCell(std::string_view event) {
 	AtParser parser(event);
 	
 	// UMTS
 	if (strStartsWith(event, "+EEMUMTSINTER") || strStartsWith(event, "+EEMUMTSINTRA")) {
-		int rscp, rssi, mcc, mnc, lac, ci, arfcn;
+		struct {
+			int32_t rscp, rssi, mcc, mnc, lac, ci, arfcn;
+		} f;
 		
-		parser
-			.parseSkip() // index
-			.parseInt(&rscp) // rscp
-			.parseInt(&rssi) // rssi
-			.parseSkip() // s_rx_lev
-			.parseInt(&mcc) // mcc
-			.parseInt(&mnc) // mnc
-			.parseInt(&lac) // lac
-			.parseInt(&ci) // ci
-			.parseInt(&arfcn); // arfcn
-			
-		if (!parser.success())
+		using F = decltype(f);
+		static constexpr auto fields = AtParser::schema(
+			AtParser::Skip<>(), // index
+			&F::rscp, // rscp
+			&F::rssi, // rssi
+			AtParser::Skip<>(), // s_rx_lev
+			&F::mcc, // mcc
+			&F::mnc, // mnc
+			&F::lac, // lac
+			&F::ci, // ci
+			&F::arfcn // arfcn
+		);
+		
+		if (!parser.parseSchema(&f, fields).success())
 			return;
 		
-		if (rscp == -32768 && (rssi == -1 || rssi == 0))
+		if (f.rscp == -32768 && (f.rssi == -1 || f.rssi == 0))
 			return;
 		
 		m_neighboring_cell.resize(m_neighboring_cell.size() + 1);
 		
 		auto &cell = m_neighboring_cell.back();
-		cell.rssi_dbm = rssi == -1 ? NAN : decodeRSSI(rssi);
-		cell.rscp_dbm = rscp == -32768 ? NAN : rscp;
-		cell.mcc = strToInt(strprintf("%x", mcc));
-		cell.mnc = strToInt(strprintf("%x", mnc));
-		cell.loc_id = lac;
-		cell.cell_id = ci;
-		cell.freq = arfcn;
+		cell.rssi_dbm = f.rssi == -1 ? NAN : decodeRSSI(f.rssi);
+		cell.rscp_dbm = f.rscp == -32768 ? NAN : f.rscp;
+		cell.mcc = strToInt(strprintf("%x", f.mcc));
+		cell.mnc = strToInt(strprintf("%x", f.mnc));
+		cell.loc_id = f.lac;
+		cell.cell_id = f.ci;
+		cell.freq = f.arfcn;
 	}
 }
 
-void Asr1802Modem::handleServingCell(const std::string &event) {
+void Asr1802Modem::handleServingCell(std::string_view event) {
 	AtParser parser(event);
 	
 	m_signal.rssi_dbm = NAN;
@@ -88,44 +92,33 @@ void Asr1802Modem::handleServingCell(const std::string &event) {
 	
 	// LTE
 	if (strStartsWith(event, "+EEMLTESVC")) {
-		int rsrp;
-		int rsrq;
-		int main_rsrp;
-		int div_rsrp;
-		int main_rsrq;
-		int div_rsrq;
+		struct {
+			int32_t rsrp, rsrq, main_rsrp, div_rsrp, main_rsrq, div_rsrq;
+		} f;
 		
-		parser
-			.parseSkip()
-			.parseSkip()
-			.parseSkip()
-			.parseSkip()
-			.parseSkip()
-			.parseSkip()
-			.parseSkip()
-			.parseSkip()
-			.parseSkip()
-			.parseSkip()
-			.parseSkip()
-			.parseInt(&rsrp)
-			.parseInt(&rsrq)
-			.parseSkip()
-			.parseInt(&main_rsrp)
-			.parseInt(&div_rsrp)
-			.parseInt(&main_rsrq)
-			.parseInt(&div_rsrq);
+		using F = decltype(f);
+		static constexpr auto fields = AtParser::schema(
+			AtParser::Skip<11>(),
+			&F::rsrp,
+			&F::rsrq,
+			AtParser::Skip<>(),
+			&F::main_rsrp,
+			&F::div_rsrp,
+			&F::main_rsrq,
+			&F::div_rsrq
+		);
 		
-		if (!parser.success())
+		if (!parser.parseSchema(&f, fields).success())
 			return;
 		
-		m_signal.rsrp_dbm = decodeRSRP(rsrp);
-		m_signal.rsrq_db = decodeRSRQ(rsrq);
+		m_signal.rsrp_dbm = decodeRSRP(f.rsrp);
+		m_signal.rsrq_db = decodeRSRQ(f.rsrq);
 		
-		m_signal.main_rsrp_dbm = decodeRSRP(main_rsrp);
-		m_signal.main_rsrq_db = decodeRSRQ(main_rsrq);
+		m_signal.main_rsrp_dbm = decodeRSRP(f.main_rsrp);
+		m_signal.main_rsrq_db = decodeRSRQ(f.main_rsrq);
 		
-		m_signal.div_rsrp_dbm = decodeRSRP(div_rsrp);
-		m_signal.div_rsrq_db = decodeRSRQ(div_rsrq);
+		m_signal.div_rsrp_dbm = decodeRSRP(f.div_rsrp);
+		m_signal.div_rsrq_db = decodeRSRQ(f.div_rsrq);
 	}
 	
 	// UMTS
@@ -20,20 +20,20 @@ std::map<Asr1802Modem::NetworkMode, int> Asr1802Modem::m_mode2id = {
 	{Asr1802Modem::NET_MODE_3G_4G_PREFER_4G, 11},
 };
 
-void Asr1802Modem::handleCgev(const std::string &event) {
+void Asr1802Modem::handleCgev(std::string_view event) {
 	// "DEACT" and "DETACH" mean disconnect
-	if (event.find("DEACT") != std::string::npos || event.find("DETACH") != std::string::npos) {
-		Loop::setTimeout([this]() {
+	if (event.find("DEACT") != std::string_view::npos || event.find("DETACH") != std::string_view::npos) {
+		Loop::post([this]() {
 			handleDisconnect();
-		}, 0);
+		});
 	}
 	// Other events handle as "connection changed"
 	else {
 		// Ignore this event for 3G/EDGE
 		if (m_tech == TECH_LTE) {
-			Loop::setTimeout([this]() {
+			Loop::post([this]() {
 				handleConnect();
-			}, 0);
+			});
 		}
 	}
 }
@@ -43,12 +43,12 @@ std::tuple<bool, Asr1802Modem::NetworkInfo> Asr1802Modem::getNetworkInfo() {
 	return BaseAtModem::getNetworkInfo();
 }
 
-void Asr1802Modem::handleCesq(const std::string &event) {
+void Asr1802Modem::handleCesq(std::string_view event) {
 	bool is_3g = (m_tech == TECH_UMTS || m_tech == TECH_HSDPA || m_tech == TECH_HSUPA || m_tech == TECH_HSPA || m_tech == TECH_HSPAP);
 	if (is_3g || m_tech == TECH_LTE) {
-		Loop::setTimeout([this]() {
+		Loop::post([this]() {
 			requestEngInfo();
-		}, 0);
+		});
 	} else {
 		int rssi, ber, rscp, ecio, rsrq, rsrp;
 		
@@ -4,11 +4,13 @@
 #include <Core/Loop.h>
 
 BaseAtModem::BaseAtModem() : Modem() {
-	m_at.setVerbose(true);
 	m_at.setSerial(&m_serial);
 	m_at.setDefaultTimeoutCallback([this](const std::string &cmd) {
 		return getCommandTimeout(cmd);
 	});
+	m_at.setDefaultPriorityCallback([this](const std::string &cmd) {
+		return getCommandPriority(cmd);
+	});
 }
 
 bool BaseAtModem::execAtList(const char **commands, bool break_on_fail) {
@@ -83,6 +85,22 @@ int BaseAtModem::getCommandTimeout(const std::string &cmd) {
 	return 0;
 }
 
+int BaseAtModem::getCommandPriority(const std::string &cmd) {
+	// Operators search can take minutes, it's aborted by other commands and run again
+	if (strStartsWith(cmd, "AT+COPS=?"))
+		return AtChannel::PRIO_BACKGROUND;
+	
+	// SMS listing
+	if (strStartsWith(cmd, "AT+CMGL"))
+		return AtChannel::PRIO_LOW;
+	
+	// Read commands (AT+XXX?) are cheap, but not test commands (AT+XXX=?)
+	if (cmd.size() > 1 && cmd.back() == '?' && cmd[cmd.size() - 2] != '=')
+		return AtChannel::PRIO_HIGH;
+	
+	return AtChannel::PRIO_NORMAL;
+}
+
 bool BaseAtModem::customInit() {
 	if (m_modem_init.size()) {
 		for (auto cmd: strSplit("\n", m_modem_init)) {
@@ -104,10 +122,10 @@ bool BaseAtModem::open() {
 	// Detect TTY device lost
 	m_at.onIoBroken([this]() {
 		LOGE("IO broken...\n");
-		Loop::setTimeout([this]() {
+		Loop::post([this]() {
 			emit<EvIoBroken>({});
 			m_at.stop();
-		}, 0);
+		});
 	});
 	
 	// Detect modem hangs
@@ -138,6 +156,14 @@ bool BaseAtModem::open() {
 		}
 	});
 	
+	for (CacheBase *cache: std::initializer_list<CacheBase *>{&m_modem_info_cache, &m_sim_info_cache, &m_operator_cache}) {
+		for (auto &event: cache->events()) {
+			m_at.onUnsolicited(event, [cache](std::string_view line) {
+				cache->invalidate();
+			});
+		}
+	}
+	
 	m_at.start();
 	
 	if (!handshake()) {
@@ -166,18 +192,33 @@ int BaseAtModem::getDelayAfterDhcpRelease() {
 	return 0;
 }
 
-std::pair<bool, std::string> BaseAtModem::sendAtCommand(const std::string &cmd, int timeout) {
-	auto response = m_at.sendCommandNoPrefixAll(cmd, timeout);
-	
-	std::string out;
+bool BaseAtModem::sendAtCommand(const std::string &cmd, int timeout, const AtCommandCallback &callback) {
+	return m_at.submit(cmd, AtChannel::NO_PREFIX_ALL, "", [callback](const AtChannel::Response &response) {
+		std::string out;
+		
+		if (response.lines.size() > 0) {
+			out = strJoin("\n", response.lines) + "\n" + response.status;
+		} else {
+			out = response.status;
+		}
+		
+		callback(response.error == 0, out);
+	}, timeout);
+}
+
+std::tuple<bool, Modem::AtStats> BaseAtModem::getAtStats() {
+	auto at_stats = m_at.getStats();
 	
-	if (response.lines.size() > 0) {
-		out = strJoin("\n", response.lines) + "\n" + response.status;
-	} else {
-		out = response.status;
-	}
+	AtStats stats;
+	for (auto &[name, cmd]: at_stats.commands)
+		stats.commands[name] = {cmd.count, cmd.errors, cmd.timeouts, cmd.latency, cmd.queue};
+	stats.urc = std::move(at_stats.urc);
+	stats.urc_unhandled = at_stats.urc_unhandled;
+	stats.bytes_read = at_stats.bytes_read;
+	stats.bytes_written = at_stats.bytes_written;
+	stats.reader_wakeups = at_stats.reader_wakeups;
 	
-	return std::make_pair(response.error == 0, out);
+	return {true, stats};
 }
 
 bool BaseAtModem::setOption(const std::string &name, const std::any &value) {
@@ -94,6 +94,7 @@ class BaseAtModem: public Modem {
 		virtual bool ping(int tries = 3);
 		virtual bool handshake(int tries = 3);
 		virtual int getCommandTimeout(const std::string &cmd);
+		virtual int getCommandPriority(const std::string &cmd);
 		virtual bool customInit();
 		
 		bool execAtList(const char **commands, bool break_on_fail);
@@ -105,7 +106,7 @@ class BaseAtModem: public Modem {
 		bool m_pincode_entered = false;
 		
 		void startSimPolling();
-		void handleCpin(const std::string &event);
+		void handleCpin(std::string_view event);
 		void setSimState(SimState new_state);
 		virtual bool handleSimLock(const std::string &code);
 		
@@ -126,29 +127,34 @@ class BaseAtModem: public Modem {
 		
 		std::string m_manual_creg_req;
 		
-		int m_net_cache_version = 0;
 		bool m_allow_roaming = true;
 		
+		// Responses cache, invalidated by URC with the same prefix
+		Cache<ModemInfo> m_modem_info_cache{0};
+		Cache<SimInfo> m_sim_info_cache{5 * 60 * 1000, {"+CPIN"}};
+		Cache<Operator> m_operator_cache{60 * 1000, {"+CREG", "+CGREG", "+CEREG"}};
+		
 		static NetworkTech cregToTech(CregTech creg_tech);
 		static CregTech techToCreg(NetworkTech tech);
 		
-		virtual void handleCmt(const std::string &event);
-		virtual void handleCsq(const std::string &event);
-		virtual void handleCreg(const std::string &event);
+		virtual void handleCmt(std::string_view event);
+		virtual void handleCsq(std::string_view event);
+		virtual void handleCreg(std::string_view event);
 		virtual void handleNetworkChange();
 		
 		NetworkTech getTechFromCops();
+		std::tuple<bool, std::vector<Operator>> parseOperatorsList(const AtChannel::Response &response);
 		
 		/*
 		 * USSD internals
 		 * */
 		uint32_t m_ussd_request_id = 0;
-		int m_ussd_timeout = -1;
+		int64_t m_ussd_timeout = -1;
 		bool m_ussd_session = false;
 		UssdCallback m_ussd_callback;
 		
 		virtual void handleUssdResponse(int code, const std::string &data, int dcs);
-		virtual void handleCusd(const std::string &event);
+		virtual void handleCusd(std::string_view event);
 		
 		/*
 		 * SMS internals
@@ -159,6 +165,7 @@ class BaseAtModem: public Modem {
 		std::vector<SmsStorage> m_sms_all_storages[3];
 		SmsStorage m_sms_mem[3] = {SMS_STORAGE_UNKNOWN, SMS_STORAGE_UNKNOWN, SMS_STORAGE_UNKNOWN};
 		SmsStorageCapacity m_sms_capacity[3] = {};
+		bool m_cmms_supported = true;
 		
 		bool intiSms();
 		bool syncSmsStorage();
@@ -229,11 +236,12 @@ class BaseAtModem: public Modem {
 		virtual std::tuple<bool, ModemInfo> getModemInfo() override;
 		virtual std::tuple<bool, SimInfo> getSimInfo() override;
 		virtual std::tuple<bool, NetworkInfo> getNetworkInfo() override;
+		virtual std::tuple<bool, NetworkState> getNetworkState() override;
 		
 		/*
 		 * Network
 		 * */
-		virtual std::tuple<bool, std::vector<Operator>> searchOperators() override;
+		virtual bool searchOperators(const SearchOperatorsCallback &callback) override;
 		virtual bool setOperator(OperatorRegMode mode, int mcc = -1, int mnc = -1, NetworkTech tech = TECH_UNKNOWN) override;
 		
 		virtual std::tuple<bool, std::vector<NetworkMode>> getNetworkModes() override;
@@ -263,13 +271,15 @@ class BaseAtModem: public Modem {
 		virtual SmsStorageCapacity getSmsCapacity() override;
 		virtual SmsStorage getSmsStorage() override;
 		virtual std::tuple<bool, std::vector<SmsDb::RawSms>> getSmsList(SmsListType list) override;
+		virtual bool sendSms(const SmsSubmitPdu &pdu, bool more_messages, const SmsSendCallback &callback) override;
 		
 		/*
 		 * Internals
 		 * */
 		virtual IfaceProto getIfaceProto() override;
 		virtual int getDelayAfterDhcpRelease() override;
-		virtual std::pair<bool, std::string> sendAtCommand(const std::string &cmd, int timeout) override;
+		virtual bool sendAtCommand(const std::string &cmd, int timeout, const AtCommandCallback &callback) override;
+		virtual std::tuple<bool, AtStats> getAtStats() override;
 		virtual std::vector<Capability> getCapabilities() override;
 		
 		/*
@@ -1,7 +1,8 @@
 #include "../BaseAt.h"
 
 std::tuple<bool, BaseAtModem::ModemInfo> BaseAtModem::getModemInfo() {
-	return cached<ModemInfo>(__func__, [this]() {
+	// Not batched: responses have no prefix and can't be demultiplexed in one transaction
+	return cached<ModemInfo>(m_modem_info_cache, [this]() {
 		AtChannel::Response response;
 		ModemInfo info;
 		
@@ -1,3 +1,5 @@
+#define LOG_CATEGORY LOG_CAT_NET
+
 #include "../BaseAt.h"
 #include <Core/Loop.h>
 
@@ -15,6 +17,15 @@ std::tuple<bool, BaseAtModem::NetworkInfo> BaseAtModem::getNetworkInfo() {
 	}};
 }
 
+std::tuple<bool, BaseAtModem::NetworkState> BaseAtModem::getNetworkState() {
+	return {true, {
+		.reg		= m_net_reg,
+		.tech		= m_tech,
+		.signal		= m_signal,
+		.cell		= m_cell_info
+	}};
+}
+
 bool BaseAtModem::Creg::isRegistered() const {
 	switch (status) {
 		case CREG_REGISTERED_HOME:				return true;
@@ -81,7 +92,7 @@ BaseAtModem::CregTech BaseAtModem::techToCreg(NetworkTech tech) {
 	return CREG_TECH_UNKNOWN;
 }
 
-void BaseAtModem::handleCsq(const std::string &event) {
+void BaseAtModem::handleCsq(std::string_view event) {
 	int rssi, ber;
 	bool parsed = AtParser(event)
 		.parseInt(&rssi)
@@ -98,7 +109,7 @@ void BaseAtModem::handleCsq(const std::string &event) {
 	m_signal.bit_err_pct = decodeRERR(ber);
 }
 
-void BaseAtModem::handleCreg(const std::string &event) {
+void BaseAtModem::handleCreg(std::string_view event) {
 	Creg *reg = nullptr;
 	bool is_manual = false;
 	
@@ -163,12 +174,12 @@ void BaseAtModem::handleCreg(const std::string &event) {
 		break;
 		
 		default:
-			LOGE("Invalid CREG format: %s\n", event.c_str());
+			LOGE("Invalid CREG format: %.*s\n", (int) event.size(), event.data());
 		break;
 	}
 	
 	if (!parsed) {
-		LOGE("Invalid CREG: %s\n", event.c_str());
+		LOGE("Invalid CREG: %.*s\n", (int) event.size(), event.data());
 		return;
 	}
 	
@@ -177,9 +188,9 @@ void BaseAtModem::handleCreg(const std::string &event) {
 	reg->loc_id = loc_id;
 	reg->cell_id = cell_id;
 	
-	Loop::setTimeout([this]() {
+	Loop::post([this]() {
 		handleNetworkChange();
-	}, 0);
+	});
 }
 
 void BaseAtModem::handleNetworkChange() {
@@ -209,13 +220,13 @@ void BaseAtModem::handleNetworkChange() {
 	
 	if (m_net_reg != new_net_reg) {
 		m_net_reg = new_net_reg;
-		m_net_cache_version++;
+		m_operator_cache.invalidate();
 		emit<EvNetworkChanged>({.status = m_net_reg});
 	}
 	
 	if (m_tech != new_tech) {
 		m_tech = new_tech;
-		m_net_cache_version++;
+		m_operator_cache.invalidate();
 		emit<EvTechChanged>({.tech = m_tech});
 	}
 }
@@ -242,21 +253,22 @@ std::tuple<bool, BaseAtModem::Operator> BaseAtModem::getCurrentOperator() {
 	if (m_net_reg == NET_NOT_REGISTERED || m_net_reg == NET_SEARCHING)
 		return {true, {}};
 	
-	return cached<Operator>(__func__, [this]() {
+	return cached<Operator>(m_operator_cache, [this]() -> std::optional<Operator> {
 		bool success;
 		std::string name;
 		int format;
 		int mode;
 		int tech;
 		
+		// Both operator formats in one round trip
 		auto response = m_at.sendCommandMultiline("AT+COPS=3,0;+COPS?;+COPS=3,2;+COPS?", "+COPS");
 		if (response.error)
-			return std::any();
+			return std::nullopt;
 		
 		Operator value;
 		for (auto &line: response.lines) {
 			if (AtParser::getArgCnt(line) < 3)
-				return std::any();
+				return std::nullopt;
 			
 			if (AtParser::getArgCnt(line) == 3) {
 				success = AtParser(line)
@@ -274,7 +286,7 @@ std::tuple<bool, BaseAtModem::Operator> BaseAtModem::getCurrentOperator() {
 			}
 			
 			if (!success)
-				return std::any();
+				return std::nullopt;
 			
 			if (format == 2) {
 				value.mcc = strToInt(name.substr(0, 3), 10, -1);
@@ -291,15 +303,21 @@ std::tuple<bool, BaseAtModem::Operator> BaseAtModem::getCurrentOperator() {
 		if (!value.name.size())
 			value.name = strprintf("%03d %02d", value.mcc, value.mnc);
 		
-		return std::any(value);
-	}, m_net_cache_version);
+		return value;
+	});
+}
+
+bool BaseAtModem::searchOperators(const SearchOperatorsCallback &callback) {
+	return m_at.submit("AT+COPS=?", AtChannel::DEFAULT, "+COPS", [this, callback](const AtChannel::Response &response) {
+		auto [success, operators] = parseOperatorsList(response);
+		callback(success, operators);
+	});
 }
 
-std::tuple<bool, std::vector<BaseAtModem::Operator>> BaseAtModem::searchOperators() {
+std::tuple<bool, std::vector<BaseAtModem::Operator>> BaseAtModem::parseOperatorsList(const AtChannel::Response &response) {
 	std::vector<Operator> operators;
 	std::vector<std::string> operators_raw;
 	
-	auto response = m_at.sendCommand("AT+COPS=?", "+COPS");
 	if (response.error)
 		return {false, {}};
 	
@@ -3,16 +3,18 @@
 
 std::tuple<bool, BaseAtModem::SimInfo> BaseAtModem::getSimInfo() {
 	if (m_sim_state == SIM_READY) {
-		return cached<SimInfo>(__func__, [this]() {
+		return cached<SimInfo>(m_sim_info_cache, [this]() {
 			SimInfo info;
-			AtChannel::Response response;
 			
-			response = m_at.sendCommand("AT+CNUM", "+CNUM");
-			if (response.error || !AtParser(response.data()).parseSkip().parseString(&info.number).success())
+			auto responses = m_at.sendBatch({
+				{AtChannel::DEFAULT, "AT+CNUM", "+CNUM"},
+				{AtChannel::NUMERIC, "AT+CIMI", "+CIMI"},
+			});
+			
+			if (responses[0].error || !AtParser(responses[0].data()).parseSkip().parseString(&info.number).success())
 				info.number = "";
 			
-			response = m_at.sendCommandNumericOrWithPrefix("AT+CIMI", "+CIMI");
-			if (response.error || !AtParser(response.data()).parseString(&info.imsi).success())
+			if (responses[1].error || !AtParser(responses[1].data()).parseString(&info.imsi).success())
 				info.imsi = "";
 			
 			info.state = m_sim_state;
@@ -57,7 +59,7 @@ void BaseAtModem::startSimPolling() {
 		setSimState(SIM_ERROR);
 	}
 	
-	Loop::setTimeout([this]() {
+	setTimeout([this]() {
 		startSimPolling();
 	}, 1000);
 }
@@ -65,6 +67,7 @@ void BaseAtModem::startSimPolling() {
 void BaseAtModem::setSimState(SimState new_state) {
 	if (new_state != m_sim_state) {
 		m_sim_state = new_state;
+		m_sim_info_cache.invalidate();
 		emit<EvSimStateChanged>({.state = m_sim_state});
 	}
 }
@@ -83,13 +86,13 @@ bool BaseAtModem::handleSimLock(const std::string &code) {
 		
 		m_pincode_entered = true;
 		
-		Loop::setTimeout([this]() {
+		Loop::post([this]() {
 			if (m_at.sendCommandNoResponse("AT+CPIN=" + m_pincode) != 0)
 				LOGE("SIM PIN unlock error\n");
 			
 			setSimState(SIM_WAIT_UNLOCK);
 			startSimPolling();
-		}, 0);
+		});
 		
 		return true;
 	} else if (strStartsWith(code, "SIM REMOVED")) {
@@ -111,10 +114,10 @@ bool BaseAtModem::handleSimLock(const std::string &code) {
 	return false;
 }
 
-void BaseAtModem::handleCpin(const std::string &event) {
+void BaseAtModem::handleCpin(std::string_view event) {
 	std::string code;
 	if (!AtParser(event).parseString(&code).success()) {
-		LOGE("Invalid +CPIN: %s\n", event.c_str());
+		LOGE("Invalid +CPIN: %.*s\n", (int) event.size(), event.data());
 		setSimState(SIM_ERROR);
 		return;
 	}
@@ -1,6 +1,8 @@
+#define LOG_CATEGORY LOG_CAT_SMS
+
 #include "../BaseAt.h"
 
-void BaseAtModem::handleCmt(const std::string &event) {
+void BaseAtModem::handleCmt(std::string_view event) {
 	if (strStartsWith(event, "+CMT:")) {
 		
 	} else if (strStartsWith(event, "+CMTI:")) {
@@ -303,6 +305,33 @@ std::tuple<bool, std::vector<SmsDb::RawSms>> BaseAtModem::getSmsList(SmsListType
 	return {true, result};
 }
 
+bool BaseAtModem::sendSms(const SmsSubmitPdu &pdu, bool more_messages, const SmsSendCallback &callback) {
+	if (!m_sms_ready)
+		return false;
+	
+	// Keep radio link open between messages, modem closes it after 1-5 seconds without AT+CMGS
+	if (more_messages && m_cmms_supported) {
+		m_at.submit("AT+CMMS=1", AtChannel::NO_RESPONSE, "", [this](const AtChannel::Response &response) {
+			if (response.error == AtChannel::AT_ERROR) {
+				LOGD("AT+CMMS is not supported, sending messages without link control.\n");
+				m_cmms_supported = false;
+			}
+		});
+	}
+	
+	std::string cmd = "AT+CMGS=" + std::to_string(pdu.tpdu_len);
+	return m_at.submitPdu(cmd, bin2hex(pdu.data, true), "+CMGS", [callback](const AtChannel::Response &response) {
+		if (response.error) {
+			callback(false, -1, response.status.size() > 0 ? response.status : "AT error " + std::to_string(response.error));
+			return;
+		}
+		
+		int mr = -1;
+		AtParser(response.data()).parseInt(&mr);
+		callback(true, mr, "");
+	});
+}
+
 bool BaseAtModem::deleteReadedSms() {
 	return m_at.sendCommandNoResponse("AT+CMGD=1,3") == 0;
 }
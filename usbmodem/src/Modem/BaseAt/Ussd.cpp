@@ -2,20 +2,21 @@
 #include <Core/Loop.h>
 
 void BaseAtModem::handleUssdResponse(int code, const std::string &data, int dcs) {
-	auto [success, decoded] = decodeCbsDcsString(data, dcs);
+	// NOTE: data is assumed as raw, if can't decode as hex
+	auto [success, decoded] = decodeCbsDcsHexString(data, dcs);
 	if (!success) {
 		code = USSD_ERROR;
-		decoded = "Can't decode USSD: " + bin2hex(data, true) + " [dcs=" + std::to_string(dcs) + "].";
+		decoded = "Can't decode USSD: " + data + " [dcs=" + std::to_string(dcs) + "].";
 		LOGE("%s\n", decoded.c_str());
 	}
 	
 	if (m_ussd_callback) {
 		uint32_t current_req = m_ussd_request_id;
 		
-		Loop::setTimeout([=]() {
+		Loop::post([=]() {
 			if (current_req == m_ussd_request_id) {
 				auto callback = m_ussd_callback;
-				Loop::clearTimeout(m_ussd_timeout);
+				clearTimeout(m_ussd_timeout);
 				m_ussd_callback = nullptr;
 				m_ussd_timeout = -1;
 				m_ussd_session = (code == USSD_WAIT_REPLY);
@@ -28,11 +29,11 @@ void BaseAtModem::handleUssdResponse(int code, const std::string &data, int dcs)
 				if (code == USSD_WAIT_REPLY)
 					cancelUssd();
 			}
-		}, 0);
+		});
 	}
 }
 
-void BaseAtModem::handleCusd(const std::string &event) {
+void BaseAtModem::handleCusd(std::string_view event) {
 	int dcs = 0, code = 0;
 	std::string data;
 	
@@ -52,12 +53,11 @@ void BaseAtModem::handleCusd(const std::string &event) {
 	}
 	
 	if (!success) {
-		LOGE("Invalid CUSD: %s\n", event.c_str());
+		LOGE("Invalid CUSD: %.*s\n", (int) event.size(), event.data());
 		return;
 	}
 	
-	// NOTE: hex2bin assume as raw data, if can't decode as hex
-	handleUssdResponse(code, hex2bin(data), dcs);
+	handleUssdResponse(code, data, dcs);
 }
 
 bool BaseAtModem::sendUssd(const std::string &cmd, UssdCallback callback, int timeout) {
@@ -84,8 +84,9 @@ bool BaseAtModem::sendUssd(const std::string &cmd, UssdCallback callback, int ti
 		return false;
 	}
 	
-	m_ussd_timeout = Loop::setTimeout([this, callback]() {
+	m_ussd_timeout = setTimeout([this, callback]() {
 		m_ussd_callback = nullptr;
+		m_ussd_timeout = -1;
 		callback(USSD_ERROR, "USSD command timeout reached.");
 	}, timeout);
 	
@@ -98,14 +99,14 @@ bool BaseAtModem::cancelUssd() {
 	m_ussd_session = false;
 	
 	if (m_ussd_timeout != -1) {
-		Loop::clearTimeout(m_ussd_timeout);
+		clearTimeout(m_ussd_timeout);
 		m_ussd_timeout = -1;
 	}
 	
 	if (last_callback) {
-		Loop::setTimeout([last_callback]() {
+		Loop::post([last_callback]() {
 			last_callback(USSD_ERROR, "USSD command canceled.");
-		}, 0);
+		});
 	}
 	
 	return m_at.sendCommandNoResponse("AT+CUSD=2") == 0;
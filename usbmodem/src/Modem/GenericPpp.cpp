@@ -48,34 +48,34 @@ bool GenericPppModem::init() {
 		break;
 	}
 	
-	auto network_creg_handler = [this](const std::string &event) {
+	auto network_creg_handler = [this](std::string_view event) {
 		handleCreg(event);
 	};
 	m_at.onUnsolicited("+CREG", network_creg_handler);
 	m_at.onUnsolicited("+CGREG", network_creg_handler);
 	m_at.onUnsolicited("+CEREG", network_creg_handler);
 	
-	m_at.onUnsolicited("+CUSD", [this](const std::string &event) {
+	m_at.onUnsolicited("+CUSD", [this](std::string_view event) {
 		handleCusd(event);
 	});
 	
 	if (support_zrssi) {
-		m_at.onUnsolicited("+ZRSSI", [this](const std::string &event) {
+		m_at.onUnsolicited("+ZRSSI", [this](std::string_view event) {
 			handleZrssi(event);
 		});
 	} else {
-		m_at.onUnsolicited("+CSQ", [this](const std::string &event) {
+		m_at.onUnsolicited("+CSQ", [this](std::string_view event) {
 			handleCsq(event);
 		});
 	}
 	
-	m_at.onUnsolicited("+CPIN", [this](const std::string &event) {
+	m_at.onUnsolicited("+CPIN", [this](std::string_view event) {
 		handleCpin(event);
 	});
-	m_at.onUnsolicited("+CMT", [this](const std::string &event) {
+	m_at.onUnsolicited("+CMT", [this](std::string_view event) {
 		handleCmt(event);
 	});
-	m_at.onUnsolicited("+CMTI", [this](const std::string &event) {
+	m_at.onUnsolicited("+CMTI", [this](std::string_view event) {
 		handleCmt(event);
 	});
 	
@@ -88,7 +88,7 @@ bool GenericPppModem::init() {
 	
 	on<EvSimStateChanged>([this](const auto &event) {
 		if (event.state == SIM_READY) {
-			Loop::setTimeout([this]() {
+			setTimeout([this]() {
 				intiSms();
 			}, 1000);
 		}
@@ -99,7 +99,7 @@ bool GenericPppModem::init() {
 	return true;
 }
 
-void GenericPppModem::handleZrssi(const std::string &event) {
+void GenericPppModem::handleZrssi(std::string_view event) {
 	int raw_rssi, raw_ecio, raw_rscp;
 	
 	bool success = AtParser(event)
@@ -123,7 +123,7 @@ void GenericPppModem::handleZrssi(const std::string &event) {
 void GenericPppModem::wakeSignalTimer() {
 	if (getCurrentTimestamp() - m_signal_last_requested >= SIGNAL_INFO_UPDATE_IDLE_TIMEOUT) {
 		m_signal_last_requested = getCurrentTimestamp();
-		Loop::clearTimeout(m_signal_recheck_timeout);
+		clearTimeout(m_signal_recheck_timeout);
 		m_signal_recheck_timeout = -1;
 		startSignalPolling();
 	} else {
@@ -139,7 +139,7 @@ void GenericPppModem::startSignalPolling() {
 	
 	int timeout = getCurrentTimestamp() - m_signal_last_requested < SIGNAL_INFO_UPDATE_IDLE_TIMEOUT ?
 		SIGNAL_INFO_UPDATE_INTERVAL : SIGNAL_INFO_UPDATE_INTERVAL_IDLE;
-	m_signal_recheck_timeout = Loop::setTimeout([this]() {
+	m_signal_recheck_timeout = setTimeout([this]() {
 		m_signal_recheck_timeout = -1;
 		startSignalPolling();
 	}, timeout);
@@ -36,7 +36,7 @@ class GenericPppModem: public BaseAtModem {
 		/*
 		 * Network
 		 * */
-		int m_signal_recheck_timeout = -1;
+		int64_t m_signal_recheck_timeout = -1;
 		int64_t m_signal_last_requested = 0;
 		static std::map<NetworkMode, int> m_zte_mode2id;
 		
@@ -44,7 +44,7 @@ class GenericPppModem: public BaseAtModem {
 		void startSignalPolling();
 		void wakeSignalTimer();
 		
-		void handleZrssi(const std::string &event);
+		void handleZrssi(std::string_view event);
 		
 		std::tuple<bool, std::vector<NetworkMode>> getNetworkModes() override;
 		bool setNetworkMode(NetworkMode new_mode) override;
@@ -42,40 +42,40 @@ bool HuaweiNcmModem::init() {
 		return false;
 	}
 	
-	auto network_creg_handler = [this](const std::string &event) {
+	auto network_creg_handler = [this](std::string_view event) {
 		handleCreg(event);
 	};
 	m_at.onUnsolicited("+CREG", network_creg_handler);
 	m_at.onUnsolicited("+CGREG", network_creg_handler);
 	m_at.onUnsolicited("+CEREG", network_creg_handler);
 	
-	m_at.onUnsolicited("+CUSD", [this](const std::string &event) {
+	m_at.onUnsolicited("+CUSD", [this](std::string_view event) {
 		handleCusd(event);
 	});
-	m_at.onUnsolicited("^HCSQ", [this](const std::string &event) {
+	m_at.onUnsolicited("^HCSQ", [this](std::string_view event) {
 		handleHcsq(event);
 	});
-	m_at.onUnsolicited("+CPIN", [this](const std::string &event) {
+	m_at.onUnsolicited("+CPIN", [this](std::string_view event) {
 		handleCpin(event);
 	});
-	m_at.onUnsolicited("+CMT", [this](const std::string &event) {
+	m_at.onUnsolicited("+CMT", [this](std::string_view event) {
 		handleCmt(event);
 	});
-	m_at.onUnsolicited("+CMTI", [this](const std::string &event) {
+	m_at.onUnsolicited("+CMTI", [this](std::string_view event) {
 		handleCmt(event);
 	});
-	m_at.onUnsolicited("^NDISSTAT", [this](const std::string &event) {
-		Loop::setTimeout([this]() {
+	m_at.onUnsolicited("^NDISSTAT", [this](std::string_view event) {
+		Loop::post([this]() {
 			handleConnect();
-		}, 0);
+		});
 	});
 	
-	Loop::setTimeout([this]() {
+	Loop::post([this]() {
 		m_at.sendCommandNoResponse("AT+CREG?");
 		m_at.sendCommandNoResponse("AT+CGREG?");
 		m_at.sendCommandNoResponse("AT+CEREG?");
 		m_at.sendCommandNoResponse("AT^HCSQ?");
-	}, 0);
+	});
 	
 	on<EvDataDisconnected>([this](const auto &event) {
 		startDataConnection();
@@ -87,7 +87,7 @@ bool HuaweiNcmModem::init() {
 	
 	on<EvSimStateChanged>([this](const auto &event) {
 		if (event.state == SIM_READY) {
-			Loop::setTimeout([this]() {
+			setTimeout([this]() {
 				intiSms();
 			}, 1000);
 		}
@@ -29,7 +29,7 @@ class HuaweiNcmModem: public BaseAtModem {
 		 * Network
 		 * */
 		DataConnectState m_data_state = DISCONNECTED;
-		int m_manual_connect_timeout = -1;
+		int64_t m_manual_connect_timeout = -1;
 		bool m_prefer_dhcp = false;
 		bool m_first_data_connect = true;
 		int m_pdp_context = DEFAULT_PDP_CONTEXT;
@@ -41,7 +41,7 @@ class HuaweiNcmModem: public BaseAtModem {
 		bool readDhcpV4();
 		bool readDhcpV6();
 		
-		void handleHcsq(const std::string &event);
+		void handleHcsq(std::string_view event);
 		
 		void handleConnect();
 		void handleDisconnect();
@@ -61,7 +61,7 @@ class HuaweiNcmModem: public BaseAtModem {
 		IfaceProto getIfaceProto() override;
 		int getDelayAfterDhcpRelease() override;
 		
-		virtual std::tuple<bool, std::vector<Operator>> searchOperators() override;
+		virtual bool searchOperators(const SearchOperatorsCallback &callback) override;
 		virtual bool setOperator(OperatorRegMode mode, int mcc = -1, int mnc = -1, NetworkTech tech = TECH_UNKNOWN) override;
 		
 		std::tuple<bool, std::vector<NetworkMode>> getNetworkModes() override;
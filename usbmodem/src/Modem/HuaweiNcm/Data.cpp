@@ -1,3 +1,5 @@
+#define LOG_CATEGORY LOG_CAT_NET
+
 #include "../HuaweiNcm.h"
 #include <Core/Loop.h>
 
@@ -197,7 +199,7 @@ void HuaweiNcmModem::startDataConnection() {
 	m_data_state = CONNECTING;
 	emit<EvDataConnecting>({});
 	
-	Loop::setTimeout([this]() {
+	Loop::post([this]() {
 		if (m_first_data_connect) {
 			handleConnect();
 			m_first_data_connect = false;
@@ -212,10 +214,10 @@ void HuaweiNcmModem::startDataConnection() {
 			handleDisconnect();
 			
 			// Try reconnect after few seconds
-			m_manual_connect_timeout = Loop::setTimeout([this]() {
+			m_manual_connect_timeout = setTimeout([this]() {
 				m_manual_connect_timeout = -1;
 				startDataConnection();
 			}, 1000);
 		}
-	}, 0);
+	});
 }
@@ -24,7 +24,7 @@ std::map<HuaweiNcmModem::NetworkMode, std::string> HuaweiNcmModem::m_mode2id = {
 	{HuaweiNcmModem::NET_MODE_3G_4G_PREFER_4G, "0302"},
 };
 
-void HuaweiNcmModem::handleHcsq(const std::string &event) {
+void HuaweiNcmModem::handleHcsq(std::string_view event) {
 	std::string sysmode;
 	AtParser parser(event);
 	
@@ -186,10 +186,10 @@ std::tuple<bool, std::vector<HuaweiNcmModem::NetworkNeighborCell>> HuaweiNcmMode
 	return {true, {}};
 }
 
-std::tuple<bool, std::vector<HuaweiNcmModem::Operator>> HuaweiNcmModem::searchOperators() {
+bool HuaweiNcmModem::searchOperators(const SearchOperatorsCallback &callback) {
 	m_at.sendCommandNoResponse("AT+CGATT=0");
 	handleDisconnect();
-	return BaseAtModem::searchOperators();
+	return BaseAtModem::searchOperators(callback);
 }
 
 bool HuaweiNcmModem::setOperator(OperatorRegMode mode, int mcc, int mnc, NetworkTech tech) {
@@ -2,12 +2,34 @@
 
 #include <vector>
 #include <csignal>
+#include <cstring>
+#include <unistd.h>
+#include <sys/eventfd.h>
 #include <Core/Uci.h>
 #include <Core/UbusLoop.h>
 
-ModemService::ModemService(const std::string &iface): m_iface(iface) {
+// Used from signal handler
+static int stop_fd = -1;
+
+ModemService::ModemService(const std::string &iface, Ubus *shared_ubus): m_iface(iface) {
 	m_start_time = getCurrentTimestamp();
 	m_api = new ModemServiceApi(this);
+	
+	// Flush changes which were made during compaction
+	m_sms.setCompactionCallback([this]() {
+		Loop::post([this]() {
+			saveSms();
+		});
+	});
+	
+	if (shared_ubus) {
+		m_ubus = shared_ubus;
+		m_shared = true;
+		
+		// Each interface needs own SMS DB
+		m_sms.setDbFile("/tmp/sms-" + iface + ".dat");
+		m_sms.setTmpFile("/tmp/sms-" + iface + ".dat.tmp");
+	}
 }
 
 bool ModemService::loadOptions() {
@@ -40,6 +62,22 @@ bool ModemService::loadOptions() {
 		return false;
 	}
 	
+	// Per-device quirks from modems index, can be overridden by UCI
+	auto device_url = getMapValue(section.options, "device", "");
+	if (strStartsWith(device_url, "usb://")) {
+		auto [url_valid, url] = UsbDiscover::parseUsbUrl(device_url);
+		auto *descr = url_valid ? UsbDiscover::findModemDescr(url.vid, url.pid) : nullptr;
+		if (descr) {
+			if (descr->baudrate) {
+				m_options["control_device_baudrate"] = std::to_string(descr->baudrate);
+				m_options["ppp_device_baudrate"] = std::to_string(descr->baudrate);
+			}
+			
+			if (*descr->getInitCommands())
+				m_options["modem_init"] = descr->getInitCommands();
+		}
+	}
+	
 	for (auto &it: section.options)
 		m_options[it.first] = it.second;
 	
@@ -82,6 +120,50 @@ bool ModemService::loadOptions() {
 	return true;
 }
 
+void ModemService::initLog() {
+	if (m_shared && m_log_inited)
+		return;
+	m_log_inited = true;
+	
+	static const std::pair<const char *, LogCategory> levels[] = {
+		{"log_level_at", LOG_CAT_AT},
+		{"log_level_sms", LOG_CAT_SMS},
+		{"log_level_net", LOG_CAT_NET},
+		{"log_level_ubus", LOG_CAT_UBUS},
+	};
+	
+	// Global level for all categories, then overrides
+	auto global_level = getMapValue(m_options, "log_level", "");
+	if (global_level.size()) {
+		LogLevel level;
+		if (Log::parseLevel(global_level, &level)) {
+			for (int i = 0; i < LOG_CAT__MAX; i++)
+				Log::setLevel(static_cast<LogCategory>(i), level);
+		} else {
+			LOGE("Invalid log_level (%s) for interface %s.\n", global_level.c_str(), m_iface.c_str());
+		}
+	}
+	
+	for (auto &it: levels) {
+		auto value = getMapValue(m_options, it.first, "");
+		if (!value.size())
+			continue;
+		
+		LogLevel level;
+		if (Log::parseLevel(value, &level)) {
+			Log::setLevel(it.second, level);
+		} else {
+			LOGE("Invalid %s (%s) for interface %s.\n", it.first, value.c_str(), m_iface.c_str());
+		}
+	}
+	
+	auto rate = getMapValue(m_options, "log_rate", "");
+	if (rate.size())
+		Log::setRateLimit(strToInt(rate));
+	
+	Log::setTraceFile(getMapValue(m_options, "at_trace", ""));
+}
+
 bool ModemService::resolveDevices(bool lock) {
 	m_control_tty_baudrate = strToInt(m_options["control_device_baudrate"], 10, 0);
 	m_ppp_tty_baudrate = strToInt(m_options["ppp_device_baudrate"], 10, 0);
@@ -141,13 +223,24 @@ bool ModemService::resolveDevices(bool lock) {
 	return true;
 }
 
+void ModemService::unlockDevices() {
+	if (m_control_tty.size())
+		UsbDiscover::unlockDevice(m_control_tty);
+	
+	if (m_ppp_tty.size())
+		UsbDiscover::unlockDevice(m_ppp_tty);
+	
+	if (m_net_dev.size())
+		UsbDiscover::unlockDevice(m_net_dev);
+}
+
 bool ModemService::check() {
-	if (!m_ubus.open()) {
+	if (!m_ubus->open()) {
 		LOGE("Can't init ubus...\n");
 		return false;
 	}
 	
-	m_netifd.setUbus(&m_ubus);
+	m_netifd.setUbus(m_ubus);
 	
 	if (!loadOptions()) 
 		return false;
@@ -160,16 +253,19 @@ bool ModemService::check() {
 }
 
 bool ModemService::init() {
-	if (!m_ubus.open()) {
+	if (!m_ubus->avail() && !m_ubus->open()) {
 		LOGE("Can't init ubus...\n");
 		return setError("USBMODEM_INTERNAL_ERROR", true);
 	}
 	
-	m_netifd.setUbus(&m_ubus);
+	m_netifd.setUbus(m_ubus);
 	
 	if (!loadOptions())
 		return setError("USBMODEM_INVALID_CONFIG", true);
 	
+	initLog();
+	startSignalHistory();
+	
 	if (!resolveDevices(true))
 		return setError("NO_DEVICE");
 	
@@ -188,13 +284,29 @@ bool ModemService::setError(const std::string &code, bool fatal) {
 	m_error_code = code;
 	m_error_fatal = fatal;
 	
+	m_api->notify("error", [&](BlobWriter *w) {
+		w->add("code", code);
+		w->add("fatal", fatal);
+	});
+	
+	// Other services in this process must keep running
+	if (m_shared) {
+		if (!m_error_pending) {
+			m_error_pending = true;
+			Loop::post([this]() {
+				handleSharedError();
+			});
+		}
+		return false;
+	}
+	
 	Loop::instance()->stop();
 	UbusLoop::instance()->stop();
 	
 	return false;
 }
 
-int ModemService::checkError() {
+int ModemService::checkError(bool wait) {
 	if (!m_error_code.size() || m_manual_shutdown)
 		return 0;
 	
@@ -209,26 +321,30 @@ int ModemService::checkError() {
 	if (!m_netifd.avail()) {
 		LOGD("%s: %s\n", (m_error_fatal ? "Fatal" : "Error"), m_error_code.c_str());
 		LOGD("Can't send error to netifd, because it not inited...\n");
-		sleep(5);
+		if (wait)
+			sleep(5);
 		return 1;
 	}
 	
 	if (m_error_code == "NO_DEVICE") {
 		if (!m_netifd.protoSetAvail(m_iface, false)) {
 			LOGE("Can't send available=false to netifd...\n");
-			sleep(5);
+			if (wait)
+				sleep(5);
 		}
 	} else {
 		if (m_error_fatal) {
 			if (!m_netifd.protoBlockRestart(m_iface)) {
 				LOGE("Can't send restart blocking '%s' to netifd...\n", m_error_code.c_str());
-				sleep(5);
+				if (wait)
+					sleep(5);
 			}
 			
 			if (!m_netifd.protoError(m_iface, m_error_code))
 				LOGE("Can't send error '%s' to netifd...\n", m_error_code.c_str());
 		} else {
-			sleep(5);
+			if (wait)
+				sleep(5);
 			
 			if (!m_netifd.protoError(m_iface, m_error_code))
 				LOGE("Can't send error '%s' to netifd...\n", m_error_code.c_str());
@@ -238,18 +354,167 @@ int ModemService::checkError() {
 	return 1;
 }
 
+void ModemService::handleSharedError() {
+	m_error_pending = false;
+	
+	finishModem();
+	unlockDevices();
+	checkError(false);
+	
+	if (m_error_fatal || m_manual_shutdown) {
+		LOGE("[%s] Service stopped: %s\n", m_iface.c_str(), m_error_code.c_str());
+		return;
+	}
+	
+	// Same delay as process restart by netifd
+	LOGE("[%s] Restarting after error: %s\n", m_iface.c_str(), m_error_code.c_str());
+	m_restart_timer = Loop::setTimeout([this]() {
+		m_restart_timer = -1;
+		restartShared();
+	}, 5000);
+}
+
+void ModemService::restartShared() {
+	if (m_manual_shutdown)
+		return;
+	
+	m_error_code = "";
+	m_error_fatal = false;
+	
+	if (!init())
+		return;
+	
+	Modem *old_modem = m_modem;
+	m_modem = nullptr;
+	
+	bool success = runModem();
+	
+	if (!m_modem) {
+		m_modem = old_modem;
+		return;
+	}
+	
+	// API and modem callbacks runs only on this thread, so it's safe to swap modem here
+	if (m_api_started)
+		m_api->setModem(m_modem);
+	
+	// Already queued tasks can still use old modem, so delete it after them
+	if (old_modem) {
+		Loop::post([old_modem]() {
+			delete old_modem;
+		});
+	}
+	
+	if (success && !m_api_started) {
+		m_api_started = true;
+		intiUbusApi();
+	}
+}
+
+void ModemService::stopShared() {
+	m_manual_shutdown = true;
+	
+	if (m_restart_timer != -1) {
+		Loop::clearTimeout(m_restart_timer);
+		m_restart_timer = -1;
+	}
+	
+	finishModem();
+	unlockDevices();
+	
+	// netifd removes dynamic DHCP interfaces on teardown
+	m_dhcp_inited = false;
+	
+	if (m_api_started) {
+		m_api_started = false;
+		UbusLoop::post([this]() {
+			m_api->stop();
+		});
+	}
+}
+
+std::vector<std::string> ModemService::loadSharedState() {
+	std::vector<std::string> ifaces;
+	for (auto &iface: strSplit("\n", tryReadFile(SHARED_STATE_FILE))) {
+		if (iface.size())
+			ifaces.push_back(iface);
+	}
+	return ifaces;
+}
+
+void ModemService::saveSharedState(const std::map<std::string, std::unique_ptr<ModemService>> &services) {
+	FILE *fp = fopen(SHARED_STATE_FILE, "w");
+	if (!fp) {
+		LOGE("Can't write %s\n", SHARED_STATE_FILE);
+		return;
+	}
+	
+	for (auto &it: services) {
+		if (!it.second->m_manual_shutdown)
+			fprintf(fp, "%s\n", it.first.c_str());
+	}
+	
+	fclose(fp);
+}
+
+bool ModemService::openStopFd(StopFd *fd) {
+	stop_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+	if (stop_fd < 0) {
+		LOGE("eventfd() failed: %s\n", strerror(errno));
+		return false;
+	}
+	
+	fd->ufd.fd = stop_fd;
+	fd->ufd.cb = +[](struct uloop_fd *ufd, unsigned int events) {
+		uint64_t value;
+		while (read(ufd->fd, &value, sizeof(value)) < 0 && errno == EINTR);
+		reinterpret_cast<StopFd *>(ufd)->callback();
+	};
+	
+	if (uloop_fd_add(&fd->ufd, ULOOP_READ) < 0) {
+		LOGE("uloop_fd_add failed\n");
+		closeStopFd(fd);
+		return false;
+	}
+	
+	// Only async-signal-safe write() here
+	auto handler = +[](int sig) {
+		uint64_t value = 1;
+		int saved_errno = errno;
+		ssize_t ret = write(stop_fd, &value, sizeof(value));
+		(void) ret;
+		errno = saved_errno;
+	};
+	std::signal(SIGINT, handler);
+	std::signal(SIGTERM, handler);
+	
+	return true;
+}
+
+void ModemService::closeStopFd(StopFd *fd) {
+	if (stop_fd >= 0) {
+		std::signal(SIGINT, SIG_DFL);
+		std::signal(SIGTERM, SIG_DFL);
+		if (fd->ufd.registered)
+			uloop_fd_delete(&fd->ufd);
+		close(stop_fd);
+		stop_fd = -1;
+	}
+}
+
 void ModemService::intiUbusApi() {
-	UbusLoop::setTimeout([this]() {
-		m_api->setUbus(&m_ubus);
+	UbusLoop::post([this]() {
+		m_api->setUbus(m_ubus);
 		m_api->setModem(m_modem);
 		m_api->setSmsDb(&m_sms);
 		
 		if (!m_api->start())
 			LOGE("Can't start API server, but continuing running...\n");
-	}, 0);
+	});
 }
 
 int ModemService::start() {
+	Log::start();
 	UbusLoop::instance()->init();
 	Loop::instance()->init();
 	
@@ -278,7 +543,137 @@ int ModemService::start() {
 	int diff = getCurrentTimestamp() - m_start_time;
 	LOGD("Done, total uptime: %d ms\n", diff);
 	
-	return checkError();
+	int ret = checkError();
+	Log::stop();
+	
+	return ret;
+}
+
+bool ModemService::startShared() {
+	if (!init() || !runModem())
+		return false;
+	
+	m_api_started = true;
+	intiUbusApi();
+	
+	return true;
+}
+
+int ModemService::runShared(const std::vector<std::string> &ifaces) {
+	int64_t start_time = getCurrentTimestamp();
+	
+	Log::start();
+	UbusLoop::instance()->init();
+	Loop::instance()->init();
+	
+	Ubus ubus;
+	if (!ubus.open()) {
+		LOGE("Can't init ubus...\n");
+		Log::stop();
+		return 1;
+	}
+	
+	// Services are created and stopped only on the modem thread
+	std::map<std::string, std::unique_ptr<ModemService>> services;
+	
+	auto attach = [&services, &ubus](const std::string &iface) {
+		auto &service = services[iface];
+		if (!service) {
+			service = std::make_unique<ModemService>(iface, &ubus);
+			
+			// Errors are handled per service on the modem thread
+			if (!service->startShared())
+				LOGE("[%s] Can't start service: %s\n", iface.c_str(), service->m_error_code.c_str());
+		} else if (service->m_manual_shutdown) {
+			// Interface was detached, service object is reused
+			service->m_manual_shutdown = false;
+			service->restartShared();
+		}
+		saveSharedState(services);
+	};
+	
+	auto detach = [&services](const std::string &iface) {
+		auto it = services.find(iface);
+		if (it != services.end() && !it->second->m_manual_shutdown) {
+			it->second->stopShared();
+			saveSharedState(services);
+		}
+	};
+	
+	// Interfaces are handed over by the netifd proto handler
+	bool registered = ubus.object("usbmodem")
+		.method("attach", [&attach](auto req) {
+			auto iface = req->args().getStr("iface");
+			if (!iface.size())
+				return UBUS_STATUS_INVALID_ARGUMENT;
+			Loop::post([&attach, iface]() {
+				attach(iface);
+			});
+			return UBUS_STATUS_OK;
+		}, {
+			{"iface", UbusObject::STRING}
+		})
+		
+		.method("detach", [&detach](auto req) {
+			auto iface = req->args().getStr("iface");
+			if (!iface.size())
+				return UBUS_STATUS_INVALID_ARGUMENT;
+			Loop::post([&detach, iface]() {
+				detach(iface);
+			});
+			return UBUS_STATUS_OK;
+		}, {
+			{"iface", UbusObject::STRING}
+		})
+		
+		.attach();
+	
+	if (!registered) {
+		LOGE("Can't register ubus object, shared daemon is already running?\n");
+		Log::stop();
+		return 1;
+	}
+	
+	StopFd stop;
+	stop.callback = [&services]() {
+		Loop::post([&services]() {
+			LOGD("Received stop signal\n");
+			for (auto &it: services)
+				it.second->m_manual_shutdown = true;
+			Loop::instance()->stop();
+			UbusLoop::instance()->stop();
+		});
+	};
+	
+	if (!openStopFd(&stop)) {
+		Log::stop();
+		return 1;
+	}
+	
+	// Interfaces from the command line and from the previous instance (e.g. after respawn)
+	auto initial = loadSharedState();
+	initial.insert(initial.end(), ifaces.begin(), ifaces.end());
+	for (auto &iface: initial)
+		attach(iface);
+	
+	std::thread modem_thread([]() {
+		Loop::instance()->run();
+	});
+	
+	UbusLoop::instance()->run();
+	modem_thread.join();
+	
+	closeStopFd(&stop);
+	
+	for (auto &it: services)
+		it.second->finishModem();
+	
+	int diff = getCurrentTimestamp() - start_time;
+	LOGD("Done, total uptime: %d ms\n", diff);
+	
+	Log::stop();
+	
+	return 0;
 }
 
 int ModemService::run(const std::string &type, int argc, char *argv[]) {
@@ -290,6 +685,8 @@ int ModemService::run(const std::string &type, int argc, char *argv[]) {
 		
 		ModemService s(argv[0]);
 		return s.start();
+	} else if (type == "multi") {
+		return runShared(std::vector<std::string>(argv, argv + argc));
 	} else if (type == "check") {
 		auto sections = Uci::loadSections("network", "interface");
 		for (auto &section: sections) {
@@ -304,6 +701,11 @@ int ModemService::run(const std::string &type, int argc, char *argv[]) {
 }
 
 ModemService::~ModemService() {
+	if (m_signal_history_timer != -1)
+		Loop::clearInterval(m_signal_history_timer);
+	
+	cancelDhcpTimer();
+	
 	if (m_api)
 		delete m_api;
 	
@@ -3,6 +3,9 @@
 #include <signal.h>
 #include <pthread.h>
 #include <map>
+#include <deque>
+#include <memory>
+#include <vector>
 #include <string>
 
 #include <Core/Log.h>
@@ -10,6 +13,7 @@
 #include <Core/Ubus.h>
 #include <Core/Netifd.h>
 #include <Core/SmsDb.h>
+#include <Core/TimeSeries.h>
 
 #include "Modem.h"
 #include "ModemServiceApi.h"
@@ -18,6 +22,20 @@
 class ModemServiceApi;
 
 class ModemService {
+	public:
+		struct SmsSendStats {
+			uint64_t sent = 0;
+			uint64_t failed = 0;
+			uint64_t parts = 0;
+			int64_t last_latency = 0;
+			int64_t max_latency = 0;
+			int64_t total_latency = 0;
+		};
+		
+		struct SignalMetric {
+			const char *name;
+			TimeSeries series;
+		};
 	protected:
 		enum SmsMode {
 			SMS_MODE_MIRROR,
@@ -25,7 +43,8 @@ class ModemService {
 		};
 		
 	protected:
-		Ubus m_ubus;
+		Ubus m_own_ubus;
+		Ubus *m_ubus = &m_own_ubus;
 		Netifd m_netifd;
 		Modem *m_modem = nullptr;
 		ModemServiceApi *m_api = nullptr;
@@ -41,9 +60,27 @@ class ModemService {
 		int m_control_tty_baudrate = 0, m_ppp_tty_baudrate = 0;
 		
 		bool m_dhcp_inited = false;
+		int64_t m_dhcp_timer = -1;
 		std::string m_error_code;
 		bool m_error_fatal = false;
 		bool m_manual_shutdown = false;
+		
+		// Shared mode: many services in one process with common loops and ubus
+		static constexpr const char *SHARED_STATE_FILE = "/var/run/usbmodem.shared";
+		bool m_shared = false;
+		bool m_error_pending = false;
+		bool m_api_started = false;
+		int64_t m_restart_timer = -1;
+		
+		// Log options are process-wide, the shared daemon takes them from the first interface
+		static inline bool m_log_inited = false;
+		
+		// Shared daemon: SIGINT/SIGTERM handler only writes to eventfd, services are stopped on the modem thread
+		struct StopFd {
+			uloop_fd ufd = {};
+			std::function<void()> callback;
+		};
+		
 		struct sigaction m_sigaction = {};
 		
 		int64_t m_start_time = 0;
@@ -52,19 +89,59 @@ class ModemService {
 		
 		SmsMode m_sms_mode = SMS_MODE_DB;
 		
+		// Outgoing SMS, sent one by one
+		struct SmsSendJob {
+			int id;
+			std::vector<SmsSubmitPdu> parts;
+			size_t part = 0;
+		};
+		
+		std::deque<SmsSendJob> m_sms_queue;
+		bool m_sms_sending = false;
+		uint8_t m_sms_ref_id = 0;
+		SmsSendStats m_sms_send_stats;
+		std::deque<int64_t> m_sms_sent_times;
+		
+		// Signal telemetry, sampled every second on the modem thread
+		std::vector<SignalMetric> m_signal_history;
+		int64_t m_signal_history_timer = -1;
+		
+		// Bursty signal updates are coalesced to one event per interval
+		static constexpr int SIGNAL_NOTIFY_INTERVAL = 5000;
+		Modem::NetworkState m_signal_notified;
+		int64_t m_signal_notify_time = 0;
+		
 		bool loadOptions();
+		void initLog();
 		bool resolveDevices(bool lock);
+		void unlockDevices();
 		
 		bool startDhcp();
 		bool stopDhcp();
+		void cancelDhcpTimer();
 		
 		bool setError(const std::string &code, bool fatal = false);
 		
-		int checkError();
+		int checkError(bool wait = true);
 		void intiUbusApi();
+		
+		void handleSharedError();
+		void restartShared();
+		void stopShared();
+		
+		static std::vector<std::string> loadSharedState();
+		static void saveSharedState(const std::map<std::string, std::unique_ptr<ModemService>> &services);
+		static bool openStopFd(StopFd *fd);
+		static void closeStopFd(StopFd *fd);
 		void loadSmsFromModem();
+		void saveSms();
+		void sendNextSms();
+		void handleSmsPartSent(bool success, int64_t latency, const std::string &error);
+		
+		void startSignalHistory();
+		void sampleSignal();
 	public:
-		explicit ModemService(const std::string &iface);
+		explicit ModemService(const std::string &iface, Ubus *shared_ubus = nullptr);
 		~ModemService();
 		
 		inline int64_t uptime() const {
@@ -79,11 +156,30 @@ class ModemService {
 			return k == "1" || k == "true";
 		}
 		
+		// Encode and queue message, returns id in SmsDb
+		std::tuple<bool, int, std::string> queueSms(const std::string &number, const std::string &text, bool status_report);
+		
+		inline size_t getSmsQueueSize() const {
+			return m_sms_queue.size();
+		}
+		
+		inline const SmsSendStats &getSmsSendStats() const {
+			return m_sms_send_stats;
+		}
+		
+		int getSmsPartsPerMinute();
+		
+		inline const std::vector<SignalMetric> &getSignalHistory() const {
+			return m_signal_history;
+		}
+		
 		static int run(const std::string &type, int argc, char *argv[]);
+		static int runShared(const std::vector<std::string> &ifaces);
 		
 		bool init();
 		bool check();
 		bool runModem();
 		void finishModem();
 		int start();
+		bool startShared();
 };
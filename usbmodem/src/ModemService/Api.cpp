@@ -4,6 +4,10 @@
 #include <Core/GsmUtils.h>
 #include <Core/UbusLoop.h>
 
+#include <charconv>
+#include <algorithm>
+#include <cinttypes>
+
 static std::vector<Modem::NetworkTech> ALL_NETWORK_TECH_LIST = {
 	Modem::TECH_UNKNOWN,
 	Modem::TECH_NO_SERVICE,
@@ -38,161 +42,208 @@ static std::vector<Modem::NetworkMode> ALL_NETWORK_MODES = {
 	Modem::NET_MODE_3G_4G_PREFER_4G,
 };
 
+static void writeModemInfo(BlobWriter *w, const Modem::ModemInfo &info) {
+	w->add("vendor", info.vendor);
+	w->add("model", info.model);
+	w->add("version", info.version);
+	w->add("imei", info.imei);
+}
+
+static void writeSimInfo(BlobWriter *w, const Modem::SimInfo &info) {
+	w->add("imsi", info.imsi);
+	w->add("number", info.number);
+	w->add("state", Modem::getEnumName(info.state));
+}
+
+static void writeIpInfo(BlobWriter *w, const char *key, const Modem::IpInfo &info) {
+	w->table(key, [&]() {
+		w->add("ip", info.ip);
+		w->add("mask", info.mask);
+		w->add("gw", info.gw);
+		w->add("dns1", info.dns1);
+		w->add("dns2", info.dns2);
+	});
+}
+
+static void writeOperator(BlobWriter *w, const Modem::Operator &op) {
+	w->add("mcc", op.mcc);
+	w->add("mnc", op.mnc);
+	w->add("name", op.name);
+	w->add("status", Modem::getEnumName(op.status));
+	w->add("tech", Modem::getEnumName(op.tech));
+}
+
+static void writeSignal(BlobWriter *w, const Modem::NetworkSignal &signal) {
+	w->table("signal", [&]() {
+		w->add("rssi_dbm", signal.rssi_dbm);
+		w->add("bit_err_pct", signal.bit_err_pct);
+		w->add("rscp_dbm", signal.rscp_dbm);
+		w->add("ecio_db", signal.ecio_db);
+		w->add("rsrq_db", signal.rsrq_db);
+		w->add("rsrp_dbm", signal.rsrp_dbm);
+		w->add("main_rsrq_db", signal.main_rsrq_db);
+		w->add("main_rsrp_dbm", signal.main_rsrp_dbm);
+		w->add("div_rsrq_db", signal.div_rsrq_db);
+		w->add("div_rsrp_dbm", signal.div_rsrp_dbm);
+		w->add("sinr_db", signal.sinr_db);
+	});
+}
+
+static void writeCell(BlobWriter *w, const Modem::NetworkCell &cell) {
+	w->table("cell", [&]() {
+		w->add("cell_id", cell.cell_id);
+		w->add("loc_id", cell.loc_id);
+	});
+}
+
+static void writeNetworkInfo(BlobWriter *w, const Modem::NetworkInfo &info) {
+	writeIpInfo(w, "ipv4", info.ipv4);
+	writeIpInfo(w, "ipv6", info.ipv6);
+	
+	writeSignal(w, info.signal);
+	writeCell(w, info.cell);
+	
+	w->table("operator", [&]() {
+		w->add("registration", Modem::getEnumName(info.oper.reg));
+		writeOperator(w, info.oper);
+	});
+	
+	w->add("tech", Modem::getEnumName(info.tech));
+	w->add("registration", Modem::getEnumName(info.reg));
+}
+
+static void writeLatency(BlobWriter *w, const char *key, const Histogram &hist) {
+	// us -> ms
+	w->table(key, [&]() {
+		w->add("p50", hist.percentile(0.50) / 1000.0);
+		w->add("p95", hist.percentile(0.95) / 1000.0);
+		w->add("p99", hist.percentile(0.99) / 1000.0);
+		w->add("max", hist.max() / 1000.0);
+		w->add("avg", hist.mean() / 1000.0);
+	});
+}
+
 void ModemServiceApi::apiGetModemInfo(std::shared_ptr<UbusRequest> req) {
-	Loop::setTimeout([=]() {
+	Loop::post([=]() {
 		auto [success, modem_info] = m_modem->getModemInfo();
 		if (!success) {
-			reply(req, {
-				{"error", "Can't get modem info"}
-			});
+			replyError(req, "Can't get modem info");
 			return;
 		}
 		
-		reply(req, {
-			{"uptime", m_service->uptime()},
-			{"vendor", modem_info.vendor},
-			{"model", modem_info.model},
-			{"version", modem_info.version},
-			{"imei", modem_info.imei},
-			{"capabilities", m_modem->getCapabilities()}
+		auto response = std::make_shared<BlobWriter>();
+		response->add("uptime", m_service->uptime());
+		writeModemInfo(response.get(), modem_info);
+		response->array("capabilities", [&]() {
+			for (auto cap: m_modem->getCapabilities())
+				response->add(nullptr, cap);
 		});
-	}, 0);
+		reply(req, response);
+	});
 }
 
 void ModemServiceApi::apiGetSimInfo(std::shared_ptr<UbusRequest> req) {
-	Loop::setTimeout([=]() {
+	singleFlight("getSimInfo", req, [=]() {
 		auto [success, sim_info] = m_modem->getSimInfo();
-		if (!success) {
-			reply(req, {
-				{"error", "Can't get sim info"}
-			});
-			return;
-		}
+		if (!success)
+			return createError("Can't get sim info");
 		
-		reply(req, {
-			{"imsi", sim_info.imsi},
-			{"number", sim_info.number},
-			{"state", Modem::getEnumName(sim_info.state)}
-		});
-	}, 0);
+		auto response = std::make_shared<BlobWriter>();
+		writeSimInfo(response.get(), sim_info);
+		return response;
+	});
 }
 
 void ModemServiceApi::apiGetNetworkInfo(std::shared_ptr<UbusRequest> req) {
-	Loop::setTimeout([=]() {
+	singleFlight("getNetworkInfo", req, [=]() {
 		auto [success, net_info] = m_modem->getNetworkInfo();
-		if (!success) {
-			reply(req, {
-				{"error", "Can't get network info"}
-			});
-			return;
-		}
+		if (!success)
+			return createError("Can't get network info");
 		
-		reply(req, {
-			{"ipv4", {
-				{"ip", net_info.ipv4.ip},
-				{"mask", net_info.ipv4.mask},
-				{"gw", net_info.ipv4.gw},
-				{"dns1", net_info.ipv4.dns1},
-				{"dns2", net_info.ipv4.dns2},
-			}},
-			{"ipv6", {
-				{"ip", net_info.ipv6.ip},
-				{"mask", net_info.ipv6.mask},
-				{"gw", net_info.ipv6.gw},
-				{"dns1", net_info.ipv6.dns1},
-				{"dns2", net_info.ipv6.dns2},
-			}},
-			{"signal", {
-				{"rssi_dbm", net_info.signal.rssi_dbm},
-				{"bit_err_pct", net_info.signal.bit_err_pct},
-				{"rscp_dbm", net_info.signal.rscp_dbm},
-				{"ecio_db", net_info.signal.ecio_db},
-				{"rsrq_db", net_info.signal.rsrq_db},
-				{"rsrp_dbm", net_info.signal.rsrp_dbm},
-				{"main_rsrq_db", net_info.signal.main_rsrq_db},
-				{"main_rsrp_dbm", net_info.signal.main_rsrp_dbm},
-				{"div_rsrq_db", net_info.signal.div_rsrq_db},
-				{"div_rsrp_dbm", net_info.signal.div_rsrp_dbm},
-				{"sinr_db", net_info.signal.sinr_db},
-			}},
-			{"cell", {
-				{"cell_id", net_info.cell.cell_id},
-				{"loc_id", net_info.cell.loc_id},
-			}},
-			{"operator", {
-				{"registration", Modem::getEnumName(net_info.oper.reg)},
-				{"mcc", net_info.oper.mcc},
-				{"mnc", net_info.oper.mnc},
-				{"name", net_info.oper.name},
-				{"tech", Modem::getEnumName(net_info.oper.tech)},
-				{"status", Modem::getEnumName(net_info.oper.status)},
-			}},
-			{"tech", Modem::getEnumName(net_info.tech)},
-			{"registration", Modem::getEnumName(net_info.reg)},
-		});
-	}, 0);
+		auto response = std::make_shared<BlobWriter>();
+		writeNetworkInfo(response.get(), net_info);
+		return response;
+	});
 }
 
 void ModemServiceApi::apiSendUssd(std::shared_ptr<UbusRequest> req) {
-	const auto &params = req->data();
+	auto args = req->args();
 	
 	bool is_answer = true;
-	int timeout = getIntArg(params, "timeout", 0);
-	std::string query = getStrArg(params, "answer", "");
+	int timeout = args.getInt("timeout", 0);
+	std::string query = args.getStr("answer", "");
 	
 	if (!query.size()) {
 		is_answer = false;
-		query = getStrArg(params, "query", "");
+		query = args.getStr("query", "");
 	}
 	
-	Loop::setTimeout([=]() {
+	Loop::post([=]() {
 		if (!is_answer && m_modem->isUssdWaitReply())
 			m_modem->cancelUssd();
 		
 		bool success = m_modem->sendUssd(query, [=](Modem::UssdCode code, const std::string &response) {
 			if (code == Modem::USSD_ERROR) {
-				reply(req, {{"error", response}});
+				replyError(req, response);
 			} else {
-				reply(req, {
-					{"code", code},
-					{"response", response}
-				});
+				auto result = std::make_shared<BlobWriter>();
+				result->add("code", code);
+				result->add("response", response);
+				reply(req, result);
 			}
 		}, timeout);
 		
 		if (!success)
-			reply(req, {{"error", "Can't send USSD."}});
-	}, 0);
+			replyError(req, "Can't send USSD.");
+	});
 }
 
 void ModemServiceApi::apiCancelUssd(std::shared_ptr<UbusRequest> req) {
-	Loop::setTimeout([=]() {
+	Loop::post([=]() {
 		if (!m_modem->cancelUssd()) {
-			reply(req, {{"error", "Can't cancel USSD."}});
+			replyError(req, "Can't cancel USSD.");
 		} else {
 			reply(req, {});
 		}
-	}, 0);
+	});
 }
 
 void ModemServiceApi::apiSendCommand(std::shared_ptr<UbusRequest> req) {
-	const auto &params = req->data();
+	auto args = req->args();
 	
-	int timeout = getIntArg(params, "timeout", 0);
-	std::string cmd = getStrArg(params, "command", "");
+	int timeout = args.getInt("timeout", 0);
+	std::string cmd = args.getStr("command", "");
 	
 	if (!cmd.size()) {
 		reply(req, {}, UBUS_STATUS_INVALID_ARGUMENT);
 		return;
 	}
 	
-	Loop::setTimeout([=]() {
-		auto [success, response] = m_modem->sendAtCommand(cmd, timeout);
-		reply(req, {
-			{"success", success},
-			{"response", response},
+	Loop::post([=]() {
+		bool queued = m_modem->sendAtCommand(cmd, timeout, [=](bool success, const std::string &response) {
+			auto result = std::make_shared<BlobWriter>();
+			result->add("success", success);
+			result->add("response", response);
+			reply(req, result);
 		});
-	}, 0);
+		
+		if (!queued) {
+			auto result = std::make_shared<BlobWriter>();
+			result->add("success", false);
+			result->add("response", "");
+			reply(req, result);
+		}
+	});
+}
+
+bool ModemServiceApi::parseSmsCursor(const std::string &str, SmsDb::SmsCursor *cursor) {
+	const char *end = str.c_str() + str.size();
+	auto [time_end, time_ec] = std::from_chars(str.c_str(), end, cursor->time);
+	if (time_ec != std::errc() || time_end == end || *time_end != ':')
+		return false;
+	
+	auto [id_end, id_ec] = std::from_chars(time_end + 1, end, cursor->id);
+	return id_ec == std::errc() && id_end == end;
 }
 
 void ModemServiceApi::apiReadSms(std::shared_ptr<UbusRequest> req) {
@@ -202,124 +253,206 @@ void ModemServiceApi::apiReadSms(std::shared_ptr<UbusRequest> req) {
 		{"draft", SmsDb::SMS_DRAFT},
 	};
 	
-	const auto &params = req->data();
-	int offset = getIntArg(params, "offset", 0);
-	int limit = getIntArg(params, "limit", 100);
-	std::string type_name = getStrArg(params, "type", "incoming");
+	auto args = req->args();
+	int offset = args.getInt("offset", 0);
+	int limit = args.getInt("limit", 100);
+	bool headers_only = args.getBool("headers", false);
+	std::string type_name = args.getStr("type", "incoming");
 	SmsDb::SmsType type = sms_types.find(type_name) != sms_types.end() ? sms_types.at(type_name) : SmsDb::SMS_INCOMING;
 	
-	Loop::setTimeout([=]() {
-		auto list = m_sms->getSmsList(type, offset, limit);
-		
-		json response = {
-			{"capacity", {
-				{"used", m_sms->getUsedCapacity()},
-				{"total", m_sms->getMaxCapacity()}
-			}},
-			{"counters", {
-				{"incoming", m_sms->getSmsCount(SmsDb::SMS_INCOMING)},
-				{"outgoing", m_sms->getSmsCount(SmsDb::SMS_OUTGOING)},
-				{"draft", m_sms->getSmsCount(SmsDb::SMS_DRAFT)}
-			}},
-			{"storage", m_sms->getStorageTypeName()},
-			{"messages", json::array()}
-		};
-		
-		for (auto &sms: list) {
-			json message = {
-				{"id", sms.id},
-				{"addr", sms.addr},
-				{"smsc", sms.smsc},
-				{"time", sms.time},
-				{"unread", (sms.flags & SmsDb::SMS_IS_UNREAD) != 0},
-				{"invalid", (sms.flags & SmsDb::SMS_IS_INVALID) != 0},
-				{"parts", json::array()}
-			};
-			
-			for (auto &part: sms.parts) {
-				if (part.text.size() > 0) {
-					message["parts"].push_back(part.text);
-				} else {
-					message["parts"].push_back(nullptr);
-				}
-			}
-			
-			response["messages"].push_back(message);
+	// Continue from "next" of previous page or from messages older than "before" timestamp
+	SmsDb::SmsCursor cursor;
+	std::string cursor_str = args.getStr("cursor", "");
+	if (cursor_str.size()) {
+		if (!parseSmsCursor(cursor_str, &cursor)) {
+			reply(req, {}, UBUS_STATUS_INVALID_ARGUMENT);
+			return;
 		}
+	} else if (args.has("before")) {
+		cursor = {static_cast<uint64_t>(args.getInt("before", 0)), -1};
+	}
+	
+	if (offset < 0) {
+		reply(req, {}, UBUS_STATUS_INVALID_ARGUMENT);
+		return;
+	}
+	
+	Loop::post([=]() {
+		auto response = std::make_shared<BlobWriter>();
+		
+		response->table("capacity", [&]() {
+			response->add("used", m_sms->getUsedCapacity());
+			response->add("total", m_sms->getMaxCapacity());
+		});
+		
+		response->table("counters", [&]() {
+			response->add("incoming", m_sms->getSmsCount(SmsDb::SMS_INCOMING));
+			response->add("outgoing", m_sms->getSmsCount(SmsDb::SMS_OUTGOING));
+			response->add("draft", m_sms->getSmsCount(SmsDb::SMS_DRAFT));
+		});
+		
+		response->add("storage", m_sms->getStorageTypeName());
+		
+		// Messages are written directly from DB, without copying
+		SmsDb::SmsCursor next;
+		bool has_more = false;
+		response->array("messages", [&]() {
+			has_more = m_sms->walkSmsList(type, cursor, offset, limit, [&](const SmsDb::Sms &sms) {
+				response->table(nullptr, [&]() {
+					response->add("id", sms.id);
+					response->add("addr", sms.addr);
+					response->add("smsc", sms.smsc);
+					response->add("time", sms.time);
+					response->add("unread", (sms.flags & SmsDb::SMS_IS_UNREAD) != 0);
+					response->add("invalid", (sms.flags & SmsDb::SMS_IS_INVALID) != 0);
+					
+					if (type == SmsDb::SMS_OUTGOING) {
+						response->add("pending", (sms.flags & SmsDb::SMS_IS_PENDING) != 0);
+						response->add("failed", (sms.flags & SmsDb::SMS_IS_FAILED) != 0);
+					}
+					
+					if (headers_only)
+						return;
+					
+					response->array("parts", [&]() {
+						for (auto &part: sms.parts) {
+							if (part.text.size() > 0) {
+								response->add(nullptr, part.text);
+							} else {
+								response->addNull(nullptr);
+							}
+						}
+					});
+				});
+			}, &next);
+		});
+		
+		if (has_more)
+			response->add("next", strprintf("%" PRIu64 ":%d", next.time, next.id));
 		
 		reply(req, response);
-	}, 0);
+	});
 }
 
 void ModemServiceApi::apiDeleteSms(std::shared_ptr<UbusRequest> req) {
-	const auto &params = req->data();
-	
-	if (!params["ids"].is_array() || !params["ids"].size()) {
-		reply(req, {}, UBUS_STATUS_INVALID_ARGUMENT);
-		return;
-	}
+	auto ids = req->args().getList("ids");
 	
 	std::vector<int> message_ids;
+	bool valid = true;
 	
-	for (auto &item: params["ids"]) {
-		if (!item.is_number()) {
-			reply(req, {}, UBUS_STATUS_INVALID_ARGUMENT);
+	ids.each([&](blob_attr *item) {
+		int64_t id;
+		if (blobmsg_type(item) == BLOBMSG_TYPE_STRING || !BlobReader::toInt(item, &id)) {
+			valid = false;
 			return;
 		}
-		message_ids.push_back(item.get<int>());
+		message_ids.push_back(id);
+	});
+	
+	if (!valid || !message_ids.size()) {
+		reply(req, {}, UBUS_STATUS_INVALID_ARGUMENT);
+		return;
 	}
 	
-	Loop::setTimeout([=]() {
-		json response = {
-			{"result", json::object()},
-			{"errors", json::object()},
-		};
+	Loop::post([=]() {
+		std::vector<bool> results;
+		for (auto id: message_ids)
+			results.push_back(m_modem->deleteSms(id));
 		
-		for (auto id: message_ids) {
-			if (!m_modem->deleteSms(id)) {
-				response["result"][std::to_string(id)] = false;
-				response["errors"][std::to_string(id)] = strprintf("Message #%d failed to delete.", id);
-			} else {
-				response["result"][std::to_string(id)] = true;
+		auto response = std::make_shared<BlobWriter>();
+		
+		response->table("result", [&]() {
+			for (size_t i = 0; i < message_ids.size(); i++)
+				response->add(std::to_string(message_ids[i]).c_str(), static_cast<bool>(results[i]));
+		});
+		
+		response->table("errors", [&]() {
+			for (size_t i = 0; i < message_ids.size(); i++) {
+				if (!results[i])
+					response->add(std::to_string(message_ids[i]).c_str(), strprintf("Message #%d failed to delete.", message_ids[i]));
 			}
-		}
+		});
 		
 		reply(req, response);
-	}, 0);
+	});
 }
 
-void ModemServiceApi::apiSearchOperators(std::shared_ptr<UbusRequest> req) {
-	Loop::setTimeout([=]() {
-		auto [success, list] = m_modem->searchOperators();
+void ModemServiceApi::apiSendSms(std::shared_ptr<UbusRequest> req) {
+	auto args = req->args();
+	std::string number = args.getStr("number", "");
+	std::string text = args.getStr("text", "");
+	bool status_report = args.getBool("status_report", false);
+	
+	if (!number.size() || !text.size()) {
+		reply(req, {}, UBUS_STATUS_INVALID_ARGUMENT);
+		return;
+	}
+	
+	Loop::post([=]() {
+		auto [success, id, error] = m_service->queueSms(number, text, status_report);
 		if (!success) {
-			reply(req, {
-				{"error", "Search operators failed"}
-			});
+			replyError(req, error);
 			return;
 		}
 		
-		json response = {
-			{"list", json::array()}
-		};
-		for (auto &op: list) {
-			response["list"].push_back({
-				{"mcc", op.mcc},
-				{"mnc", op.mnc},
-				{"name", op.name},
-				{"status", Modem::getEnumName(op.status)},
-				{"tech", Modem::getEnumName(op.tech)},
-			});
-		}
+		auto response = std::make_shared<BlobWriter>();
+		response->add("id", id);
+		response->add("queued", m_service->getSmsQueueSize());
 		reply(req, response);
-	}, 0);
+	});
+}
+
+void ModemServiceApi::apiGetSmsQueue(std::shared_ptr<UbusRequest> req) {
+	Loop::post([=]() {
+		auto &stats = m_service->getSmsSendStats();
+		
+		auto response = std::make_shared<BlobWriter>();
+		response->add("queued", m_service->getSmsQueueSize());
+		response->add("sent", stats.sent);
+		response->add("failed", stats.failed);
+		response->add("parts", stats.parts);
+		response->add("parts_per_minute", m_service->getSmsPartsPerMinute());
+		
+		response->table("latency", [&]() {
+			response->add("last", stats.last_latency);
+			response->add("max", stats.max_latency);
+			response->add("avg", stats.parts > 0 ? stats.total_latency / static_cast<int64_t>(stats.parts) : 0);
+		});
+		
+		reply(req, response);
+	});
+}
+
+void ModemServiceApi::apiSearchOperators(std::shared_ptr<UbusRequest> req) {
+	Loop::post([=]() {
+		bool queued = m_modem->searchOperators([=](bool success, const std::vector<Modem::Operator> &list) {
+			if (!success) {
+				replyError(req, "Search operators failed");
+				return;
+			}
+			
+			auto response = std::make_shared<BlobWriter>();
+			response->array("list", [&]() {
+				for (auto &op: list) {
+					response->table(nullptr, [&]() {
+						writeOperator(response.get(), op);
+					});
+				}
+			});
+			reply(req, response);
+		});
+		
+		if (!queued)
+			replyError(req, "Search operators failed");
+	});
 }
 
 void ModemServiceApi::apiSetOperator(std::shared_ptr<UbusRequest> req) {
-	const auto &params = req->data();
-	std::string mode = getStrArg(params, "mode", "auto");
-	std::string tech_name = getStrArg(params, "tech", "");
-	int mcc = getIntArg(params, "mcc", 0);
-	int mnc = getIntArg(params, "mnc", 0);
+	auto args = req->args();
+	std::string mode = args.getStr("mode", "auto");
+	std::string tech_name = args.getStr("tech", "");
+	int mcc = args.getInt("mcc", 0);
+	int mnc = args.getInt("mnc", 0);
 	
 	Modem::NetworkTech tech = Modem::TECH_UNKNOWN;
 	for (auto v: ALL_NETWORK_TECH_LIST) {
@@ -329,59 +462,58 @@ void ModemServiceApi::apiSetOperator(std::shared_ptr<UbusRequest> req) {
 		}
 	}
 	
-	Loop::setTimeout([=]() {
-		json response = {{"success", false}};
+	Loop::post([=]() {
+		auto response = std::make_shared<BlobWriter>();
 		if (mode == "manual") {
-			response["success"] = m_modem->setOperator(Modem::OPERATOR_REG_MANUAL, mcc, mnc, tech);
+			response->add("success", m_modem->setOperator(Modem::OPERATOR_REG_MANUAL, mcc, mnc, tech));
 		} else if (mode == "auto") {
-			response["success"] = m_modem->setOperator(Modem::OPERATOR_REG_AUTO);
+			response->add("success", m_modem->setOperator(Modem::OPERATOR_REG_AUTO));
 		} else if (mode == "none") {
-			response["success"] = m_modem->setOperator(Modem::OPERATOR_REG_NONE);
+			response->add("success", m_modem->setOperator(Modem::OPERATOR_REG_NONE));
 		} else {
-			response["error"] = "Invalid mode.";
+			response->add("success", false);
+			response->add("error", "Invalid mode.");
 		}
 		reply(req, response);
-	}, 0);
+	});
 }
 
 void ModemServiceApi::apiGetNetworkSettings(std::shared_ptr<UbusRequest> req) {
-	Loop::setTimeout([=]() {
-		json response = {
-			{"network_modes", json::array()}
-		};
-		
+	Loop::post([=]() {
 		auto [success, list] = m_modem->getNetworkModes();
 		if (!success) {
-			reply(req, {{"error", "getNetworkModes error"}});
+			replyError(req, "getNetworkModes error");
 			return;
 		}
 		
 		auto [success2, curr_mode] = m_modem->getCurrentNetworkMode();
 		if (!success2) {
-			reply(req, {{"error", "getCurrentNetworkMode error"}});
+			replyError(req, "getCurrentNetworkMode error");
 			return;
 		}
 		
 		auto [success3, roaming] = m_modem->isRoamingEnabled();
 		if (!success3) {
-			reply(req, {{"error", "isRoamingEnabled error"}});
+			replyError(req, "isRoamingEnabled error");
 			return;
 		}
 		
-		for (auto &mode: list)
-			response["network_modes"].push_back(m_modem->getEnumName(mode));
-		
-		response["roaming"] = roaming;
-		response["network_mode"] = m_modem->getEnumName(curr_mode);
+		auto response = std::make_shared<BlobWriter>();
+		response->array("network_modes", [&]() {
+			for (auto &mode: list)
+				response->add(nullptr, m_modem->getEnumName(mode));
+		});
+		response->add("roaming", roaming);
+		response->add("network_mode", m_modem->getEnumName(curr_mode));
 		
 		reply(req, response);
-	}, 0);
+	});
 }
 
 void ModemServiceApi::apiSetNetworkSettings(std::shared_ptr<UbusRequest> req) {
-	const auto &params = req->data();
-	std::string mode_name = getStrArg(params, "mode", "");
-	bool roaming = getBoolArg(params, "roaming", false);
+	auto args = req->args();
+	std::string mode_name = args.getStr("mode", "");
+	bool roaming = args.getBool("roaming", false);
 	
 	Modem::NetworkMode mode = Modem::NET_MODE_UNKNOWN;
 	for (auto v: ALL_NETWORK_MODES) {
@@ -391,50 +523,157 @@ void ModemServiceApi::apiSetNetworkSettings(std::shared_ptr<UbusRequest> req) {
 		}
 	}
 	
-	Loop::setTimeout([=]() {
-		json response = {{"success", true}};
+	Loop::post([=]() {
+		auto response = std::make_shared<BlobWriter>();
 		
 		if (!m_modem->setNetworkMode(mode)) {
-			response["success"] = false;
-			response["error"] = "Can't set network mode";
+			response->add("success", false);
+			response->add("error", "Can't set network mode");
 		} else if (!m_modem->setDataRoaming(roaming)) {
-			response["success"] = false;
-			response["error"] = "Can't set data roaming";
+			response->add("success", false);
+			response->add("error", "Can't set data roaming");
+		} else {
+			response->add("success", true);
 		}
 		
 		reply(req, response);
-	}, 0);
+	});
 }
 
 
 void ModemServiceApi::apiGetNeighboringCell(std::shared_ptr<UbusRequest> req) {
-	Loop::setTimeout([=]() {
+	singleFlight("getNeighboringCell", req, [=]() {
 		auto [success, list] = m_modem->getNeighboringCell();
+		if (!success)
+			return createError("getNeighboringCell error");
+		
+		auto response = std::make_shared<BlobWriter>();
+		response->array("list", [&]() {
+			for (auto &cell: list) {
+				response->table(nullptr, [&]() {
+					response->add("rssi_dbm", cell.rssi_dbm);
+					response->add("rscp_dbm", cell.rscp_dbm);
+					response->add("mcc", cell.mcc);
+					response->add("mnc", cell.mnc);
+					response->add("loc_id", cell.loc_id);
+					response->add("cell_id", cell.cell_id);
+					response->add("freq", cell.freq);
+				});
+			}
+		});
+		return response;
+	});
+}
+
+void ModemServiceApi::apiGetStats(std::shared_ptr<UbusRequest> req) {
+	Loop::post([=]() {
+		auto [success, stats] = m_modem->getAtStats();
 		if (!success) {
-			reply(req, {{"error", "getNeighboringCell error"}});
+			replyError(req, "getStats error");
 			return;
 		}
 		
-		json response = {{"list", json::array()}};
-		for (auto &cell: list) {
-			response["list"].push_back({
-				{"rssi_dbm", cell.rssi_dbm},
-				{"rscp_dbm", cell.rscp_dbm},
-				{"mcc", cell.mcc},
-				{"mnc", cell.mnc},
-				{"loc_id", cell.loc_id},
-				{"cell_id", cell.cell_id},
-				{"freq", cell.freq},
-			});
+		auto response = std::make_shared<BlobWriter>();
+		response->add("uptime", m_service->uptime());
+		
+		// latency - modem response time, queue - our own delay before sending
+		response->table("commands", [&]() {
+			for (auto &[name, cmd]: stats.commands) {
+				response->table(name.c_str(), [&]() {
+					response->add("count", cmd.count);
+					response->add("errors", cmd.errors);
+					response->add("timeouts", cmd.timeouts);
+					writeLatency(response.get(), "latency", cmd.latency);
+					writeLatency(response.get(), "queue", cmd.queue);
+				});
+			}
+		});
+		
+		response->table("urc", [&]() {
+			for (auto &[prefix, hits]: stats.urc)
+				response->add(prefix.c_str(), hits);
+		});
+		response->add("urc_unhandled", stats.urc_unhandled);
+		
+		response->add("bytes_read", stats.bytes_read);
+		response->add("bytes_written", stats.bytes_written);
+		response->add("reader_wakeups", stats.reader_wakeups);
+		
+		// Requests which were served by other identical request
+		response->table("coalesced", [&]() {
+			std::lock_guard lock(m_flights_mutex);
+			for (auto &[method, count]: m_coalesced)
+				response->add(method.c_str(), count);
+		});
+		
+		reply(req, response);
+	});
+}
+
+void ModemServiceApi::apiGetSignalHistory(std::shared_ptr<UbusRequest> req) {
+	int64_t now = getCurrentTimestamp() / 1000;
+	
+	// Unix time or relative to now, if <= 0
+	int64_t from = req->args().getInt("from", -300);
+	int64_t to = req->args().getInt("to", 0);
+	int resolution = req->args().getInt("resolution", 0);
+	auto metrics = strSplit(",", req->args().getStr("metrics", ""));
+	
+	if (from <= 0)
+		from += now;
+	if (to <= 0)
+		to += now;
+	
+	if (from > to) {
+		replyError(req, "Invalid range");
+		return;
+	}
+	
+	int tier = -1;
+	if (resolution > 0) {
+		for (int i = 0; i < TimeSeries::TIERS; i++) {
+			if (TimeSeries::TIER_CONFIG[i].resolution == resolution)
+				tier = i;
 		}
+		
+		if (tier == -1) {
+			replyError(req, "Invalid resolution");
+			return;
+		}
+	} else {
+		tier = TimeSeries::findTier(to - from, MAX_SIGNAL_HISTORY_POINTS);
+		resolution = TimeSeries::TIER_CONFIG[tier].resolution;
+	}
+	
+	// Keep the end of the range
+	from = std::max(from / resolution, to / resolution - static_cast<int64_t>(MAX_SIGNAL_HISTORY_POINTS) + 1) * resolution;
+	size_t count = (to / resolution) - (from / resolution) + 1;
+	
+	Loop::post([=]() {
+		auto response = std::make_shared<BlobWriter>();
+		response->add("from", from);
+		response->add("resolution", resolution);
+		response->add("count", count);
+		
+		response->table("metrics", [&]() {
+			for (auto &metric: m_service->getSignalHistory()) {
+				if (metrics.size() > 0 && std::find(metrics.begin(), metrics.end(), metric.name) == metrics.end())
+					continue;
+				
+				response->array(metric.name, [&]() {
+					for (double value: metric.series.get(tier, from, count))
+						response->add(nullptr, value);
+				});
+			}
+		});
+		
 		reply(req, response);
-	}, 0);
+	});
 }
 
 int ModemServiceApi::apiGetDeferredResult(std::shared_ptr<UbusRequest> req) {
 	json response = {};
-	const auto &params = req->data();
-	std::string id = getStrArg(params, "id", "");
+	std::string id = req->args().getStr("id", "");
 	
 	auto it = m_deferred_results.find(id);
 	if (it != m_deferred_results.end()) {
@@ -453,21 +692,86 @@ int ModemServiceApi::apiGetDeferredResult(std::shared_ptr<UbusRequest> req) {
 	return 0;
 }
 
-void ModemServiceApi::reply(std::shared_ptr<UbusRequest> req, json result, int status) {
+void ModemServiceApi::reply(std::shared_ptr<UbusRequest> req, std::shared_ptr<BlobWriter> result, int status) {
+	if (!result)
+		result = std::make_shared<BlobWriter>();
+	
 	if (m_deferred_results.find(req->uniqKey()) != m_deferred_results.end()) {
+		// Rare case, result is fetched later with getDeferredResult
+		json result_json;
+		blobmsgToJson(result->head(), result_json);
 		m_deferred_results[req->uniqKey()].time = getCurrentTimestamp();
-		m_deferred_results[req->uniqKey()].result = result;
+		m_deferred_results[req->uniqKey()].result = result_json;
 		m_deferred_results[req->uniqKey()].status = status;
 	} else {
-		UbusLoop::setTimeout([=]() {
-			req->reply(result, status);
-		}, 0);
+		UbusLoop::post([=]() {
+			req->replyBlob(result->head(), status);
+		});
 	}
 }
 
+void ModemServiceApi::replyError(std::shared_ptr<UbusRequest> req, const std::string &error) {
+	reply(req, createError(error));
+}
+
+std::shared_ptr<BlobWriter> ModemServiceApi::createError(const std::string &error) {
+	auto response = std::make_shared<BlobWriter>();
+	response->add("error", error);
+	return response;
+}
+
+void ModemServiceApi::singleFlight(const std::string &key, std::shared_ptr<UbusRequest> req, const std::function<std::shared_ptr<BlobWriter>()> &callback) {
+	{
+		std::lock_guard lock(m_flights_mutex);
+		
+		// Same request is already queued, wait for its result
+		auto it = m_flights.find(key);
+		if (it != m_flights.end()) {
+			it->second.push_back(req);
+			m_coalesced[key]++;
+			return;
+		}
+		
+		m_flights[key].push_back(req);
+	}
+	
+	Loop::post([=]() {
+		auto result = callback();
+		
+		m_flights_mutex.lock();
+		auto requests = std::move(m_flights[key]);
+		m_flights.erase(key);
+		m_flights_mutex.unlock();
+		
+		for (auto &r: requests)
+			reply(r, result);
+	});
+}
+
+void ModemServiceApi::notify(const std::string &type, const std::function<void(BlobWriter *)> &callback) {
+	if (!m_has_subscribers)
+		return;
+	
+	auto event = std::make_shared<BlobWriter>();
+	callback(event.get());
+	
+	UbusLoop::post([=]() {
+		if (m_object)
+			m_object->notify(type, event->head());
+	});
+}
+
+void ModemServiceApi::notifySignal(const Modem::NetworkState &state) {
+	notify("signal", [&](BlobWriter *w) {
+		writeSignal(w, state.signal);
+		writeCell(w, state.cell);
+		w->add("tech", Modem::getEnumName(state.tech));
+	});
+}
+
 void ModemServiceApi::initApiRequest(std::shared_ptr<UbusRequest> req) {
 	req->defer();
-	if (getBoolArg(req->data(), "async", false)) {
+	if (req->args().getBool("async", false)) {
 		UbusLoop::setTimeout([this, req]() {
 			if (!req->done()) {
 				req->reply({
@@ -479,8 +783,20 @@ void ModemServiceApi::initApiRequest(std::shared_ptr<UbusRequest> req) {
 	}
 }
 
+bool ModemServiceApi::stop() {
+	m_has_subscribers = false;
+	return m_object ? m_object->detach() : false;
+}
+
 bool ModemServiceApi::start() {
-	return m_ubus->object("usbmodem." + m_service->iface())
+	// Restarted service in shared mode, methods already added
+	if (m_object)
+		return m_object->attach();
+	
+	auto &object = m_ubus->object("usbmodem." + m_service->iface());
+	m_object = &object;
+	
+	return object
 		.method("getDeferredResult", [this](auto req) {
 			return apiGetDeferredResult(req);
 		})
@@ -542,7 +858,12 @@ bool ModemServiceApi::start() {
 			apiReadSms(req);
 			return 0;
 		}, {
-			{"dir", UbusObject::STRING}
+			{"type", UbusObject::STRING},
+			{"offset", UbusObject::INT32},
+			{"limit", UbusObject::INT32},
+			{"cursor", UbusObject::STRING},
+			{"before", UbusObject::INT32},
+			{"headers", UbusObject::BOOL}
 		})
 		
 		.method("deleteSms", [this](auto req) {
@@ -553,6 +874,22 @@ bool ModemServiceApi::start() {
 			{"ids", UbusObject::ARRAY}
 		})
 		
+		.method("sendSms", [this](auto req) {
+			initApiRequest(req);
+			apiSendSms(req);
+			return 0;
+		}, {
+			{"number", UbusObject::STRING},
+			{"text", UbusObject::STRING},
+			{"status_report", UbusObject::BOOL}
+		})
+		
+		.method("getSmsQueue", [this](auto req) {
+			initApiRequest(req);
+			apiGetSmsQueue(req);
+			return 0;
+		})
+		
 		.method("cancelUssd", [this](auto req) {
 			initApiRequest(req);
 			apiCancelUssd(req);
@@ -577,5 +914,27 @@ bool ModemServiceApi::start() {
 			return 0;
 		})
 		
+		.method("getStats", [this](auto req) {
+			initApiRequest(req);
+			apiGetStats(req);
+			return 0;
+		})
+		
+		.method("getSignalHistory", [this](auto req) {
+			initApiRequest(req);
+			apiGetSignalHistory(req);
+			return 0;
+		}, {
+			{"from", UbusObject::INT32},
+			{"to", UbusObject::INT32},
+			{"resolution", UbusObject::INT32},
+			{"metrics", UbusObject::STRING}
+		})
+		
+		.onSubscribe([this](bool has_subscribers) {
+			LOGD("[%s] events %s\n", m_service->iface().c_str(), has_subscribers ? "subscribed" : "unsubscribed");
+			m_has_subscribers = has_subscribers;
+		})
+		
 		.attach();
 }
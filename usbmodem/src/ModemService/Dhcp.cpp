@@ -1,3 +1,5 @@
+#define LOG_CATEGORY LOG_CAT_NET
+
 #include "ModemService.h"
 
 #include <vector>
@@ -60,10 +60,16 @@ bool ModemService::runModem() {
 	
 	m_modem->on<Modem::EvNetworkChanged>([this](const auto &event) {
 		LOGD("[network] %s\n", Modem::getEnumName(event.status, true));
+		m_api->notify("network", [&](BlobWriter *w) {
+			w->add("registration", Modem::getEnumName(event.status));
+		});
 	});
 	
 	m_modem->on<Modem::EvTechChanged>([this](const auto &event) {
 		LOGD("[network] Tech: %s\n", Modem::getEnumName(event.tech, true));
+		m_api->notify("tech", [&](BlobWriter *w) {
+			w->add("tech", Modem::getEnumName(event.tech));
+		});
 	});
 	
 	m_modem->on<Modem::EvDataConnected>([this](const auto &event) {
@@ -93,7 +99,9 @@ bool ModemService::runModem() {
 		} else if (m_modem->getIfaceProto() == Modem::IFACE_DHCP) {
 			if (dhcp_delay > 0) {
 				LOGD("Wait %d ms for DHCP recovery...\n", dhcp_delay);
-				Loop::setTimeout([this]() {
+				cancelDhcpTimer();
+				m_dhcp_timer = Loop::setTimeout([this]() {
+					m_dhcp_timer = -1;
 					if (!startDhcp())
 						setError("USBMODEM_INTERNAL_ERROR");
 				}, dhcp_delay);
@@ -118,10 +126,20 @@ bool ModemService::runModem() {
 				event.ipv6.dns1.c_str(), event.ipv6.dns2.c_str()
 			);
 		}
+		
+		m_api->notify("data", [&](BlobWriter *w) {
+			w->add("state", "connected");
+			w->add("is_update", event.is_update);
+			w->add("ipv4", event.ipv4.ip);
+			w->add("ipv6", event.ipv6.ip);
+		});
 	});
 	
 	m_modem->on<Modem::EvDataConnecting>([this](const auto &event) {
 		LOGD("Connecting to internet...\n");
+		m_api->notify("data", [&](BlobWriter *w) {
+			w->add("state", "connecting");
+		});
 	});
 	
 	m_modem->on<Modem::EvDataDisconnected>([this](const auto &event) {
@@ -129,12 +147,17 @@ bool ModemService::runModem() {
 		int diff = m_last_disconnected - m_last_connected;
 		LOGD("Internet disconnected, last session %d ms\n", diff);
 		
+		m_api->notify("data", [&](BlobWriter *w) {
+			w->add("state", "disconnected");
+		});
+		
 		if (m_modem->getIfaceProto() == Modem::IFACE_STATIC) {
 			if (!m_netifd.updateIface(m_iface, m_net_dev, nullptr, nullptr)) {
 				LOGE("Can't set IP to interface '%s'\n", m_iface.c_str());
 				setError("USBMODEM_INTERNAL_ERROR");
 			}
 		} else if (m_modem->getIfaceProto() == Modem::IFACE_DHCP) {
+			cancelDhcpTimer();
 			if (!stopDhcp()) {
 				setError("USBMODEM_INTERNAL_ERROR");
 			}
@@ -143,6 +166,9 @@ bool ModemService::runModem() {
 	
 	m_modem->on<Modem::EvSimStateChanged>([this](const auto &event) {
 		LOGD("[sim] %s\n", Modem::getEnumName(event.state, true));
+		m_api->notify("sim", [&](BlobWriter *w) {
+			w->add("state", Modem::getEnumName(event.state));
+		});
 	});
 	
 	m_modem->on<Modem::EvIoBroken>([this](const auto &event) {
@@ -152,21 +178,28 @@ bool ModemService::runModem() {
 	
 	m_modem->on<Modem::EvSmsReady>([this](const auto &event) {
 		LOGD("[sms] SMS subsystem ready!\n");
-		Loop::setTimeout([this]() {
+		Loop::post([this]() {
 			loadSmsFromModem();
-		}, 0);
+		});
 	});
 	
 	m_modem->on<Modem::EvNewDecodedSms>([this](const auto &event) {
 		LOGD("[sms] received new sms! (decoded)\n");
-		
+		m_api->notify("sms", [&](BlobWriter *w) {
+			w->add("stored", false);
+		});
 	});
 	
 	m_modem->on<Modem::EvNewStoredSms>([this](const auto &event) {
 		LOGD("[sms] received new sms! (stored)\n");
-		Loop::setTimeout([this]() {
+		Loop::post([this]() {
 			loadSmsFromModem();
-		}, 0);
+			
+			// After loading, so readSms already returns new message
+			m_api->notify("sms", [&](BlobWriter *w) {
+				w->add("stored", true);
+			});
+		});
 	});
 	
 	if (!m_modem->open()) {
@@ -177,7 +210,15 @@ bool ModemService::runModem() {
 	return true;
 }
 
+void ModemService::cancelDhcpTimer() {
+	if (m_dhcp_timer != -1) {
+		Loop::clearTimeout(m_dhcp_timer);
+		m_dhcp_timer = -1;
+	}
+}
+
 void ModemService::finishModem() {
+	cancelDhcpTimer();
 	if (m_modem)
 		m_modem->close();
 }
@@ -0,0 +1,94 @@
+#define LOG_CATEGORY LOG_CAT_NET
+
+#include "ModemService.h"
+
+#include <cmath>
+
+// Same order as values in sampleSignal()
+static const struct {
+	const char *name;
+	double scale;
+	TimeSeries::Aggregate aggregate;
+} signal_metrics[] = {
+	{"rssi",	10,	TimeSeries::AGGREGATE_AVG},
+	{"rsrp",	10,	TimeSeries::AGGREGATE_AVG},
+	{"rsrq",	10,	TimeSeries::AGGREGATE_AVG},
+	{"sinr",	10,	TimeSeries::AGGREGATE_AVG},
+	{"rscp",	10,	TimeSeries::AGGREGATE_AVG},
+	{"ecio",	10,	TimeSeries::AGGREGATE_AVG},
+	{"reg",		1,	TimeSeries::AGGREGATE_LAST},
+	{"tech",	1,	TimeSeries::AGGREGATE_LAST},
+	{"cell_id",	1,	TimeSeries::AGGREGATE_LAST},
+};
+
+// NAN means "no value", so NAN == NAN
+static inline bool isValueChanged(float a, float b) {
+	return std::isnan(a) ? !std::isnan(b) : a != b;
+}
+
+static bool isSignalChanged(const Modem::NetworkState &a, const Modem::NetworkState &b) {
+	return isValueChanged(a.signal.rssi_dbm, b.signal.rssi_dbm) ||
+		isValueChanged(a.signal.bit_err_pct, b.signal.bit_err_pct) ||
+		isValueChanged(a.signal.rscp_dbm, b.signal.rscp_dbm) ||
+		isValueChanged(a.signal.ecio_db, b.signal.ecio_db) ||
+		isValueChanged(a.signal.sinr_db, b.signal.sinr_db) ||
+		isValueChanged(a.signal.rsrq_db, b.signal.rsrq_db) ||
+		isValueChanged(a.signal.rsrp_dbm, b.signal.rsrp_dbm) ||
+		isValueChanged(a.signal.div_rsrq_db, b.signal.div_rsrq_db) ||
+		isValueChanged(a.signal.div_rsrp_dbm, b.signal.div_rsrp_dbm) ||
+		isValueChanged(a.signal.main_rsrq_db, b.signal.main_rsrq_db) ||
+		isValueChanged(a.signal.main_rsrp_dbm, b.signal.main_rsrp_dbm) ||
+		a.cell.cell_id != b.cell.cell_id || a.cell.loc_id != b.cell.loc_id || a.tech != b.tech;
+}
+
+void ModemService::startSignalHistory() {
+	if (m_signal_history_timer != -1)
+		return;
+	
+	for (auto &metric: signal_metrics)
+		m_signal_history.push_back({metric.name, TimeSeries(metric.scale, metric.aggregate)});
+	
+	m_signal_history_timer = Loop::setInterval([this]() {
+		sampleSignal();
+	}, 1000);
+}
+
+void ModemService::sampleSignal() {
+	Modem::NetworkState state;
+	bool success = false;
+	
+	if (m_modem)
+		std::tie(success, state) = m_modem->getNetworkState();
+	
+	int64_t now = getCurrentTimestamp();
+	
+	// No modem - gap in the history
+	if (!success) {
+		for (auto &metric: m_signal_history)
+			metric.series.add(now, NAN);
+		return;
+	}
+	
+	double values[] = {
+		state.signal.rssi_dbm,
+		state.signal.rsrp_dbm,
+		state.signal.rsrq_db,
+		state.signal.sinr_db,
+		state.signal.rscp_dbm,
+		state.signal.ecio_db,
+		static_cast<double>(state.reg),
+		static_cast<double>(state.tech),
+		state.cell.cell_id ? static_cast<double>(state.cell.cell_id) : NAN,
+	};
+	static_assert(COUNT_OF(values) == COUNT_OF(signal_metrics));
+	
+	for (size_t i = 0; i < m_signal_history.size(); i++)
+		m_signal_history[i].series.add(now, values[i]);
+	
+	// Latest state is sent on the first sample after the interval
+	if (m_api->hasSubscribers() && now - m_signal_notify_time >= SIGNAL_NOTIFY_INTERVAL && isSignalChanged(state, m_signal_notified)) {
+		m_signal_notified = state;
+		m_signal_notify_time = now;
+		m_api->notifySignal(state);
+	}
+}
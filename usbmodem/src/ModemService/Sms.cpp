@@ -1,3 +1,5 @@
+#define LOG_CATEGORY LOG_CAT_SMS
+
 #include "ModemService.h"
 
 #include <vector>
@@ -48,6 +50,16 @@ void ModemService::loadSmsFromModem() {
 				if (!m_sms.load()) {
 					LOGE("[sms] Failed to load sms database.\n");
 				}
+				
+				// Messages from previous run, which were not sent
+				std::vector<int> interrupted;
+				m_sms.walkSmsList(SmsDb::SMS_OUTGOING, {}, 0, 0, [&](const SmsDb::Sms &sms) {
+					if ((sms.flags & SmsDb::SMS_IS_PENDING))
+						interrupted.push_back(sms.id);
+				});
+				
+				for (auto id: interrupted)
+					m_sms.setFlags(id, SmsDb::SMS_IS_FAILED, SmsDb::SMS_IS_PENDING);
 			}
 			
 			// Loading all messages to DB
@@ -67,3 +79,100 @@ void ModemService::loadSmsFromModem() {
 		break;
 	}
 }
+
+void ModemService::saveSms() {
+	if (m_sms_mode == SMS_MODE_DB && !m_sms.save())
+		LOGE("[sms] Failed to save sms database.\n");
+}
+
+std::tuple<bool, int, std::string> ModemService::queueSms(const std::string &number, const std::string &text, bool status_report) {
+	if (!m_modem || !m_sms.ready())
+		return {false, -1, "SMS subsystem is not ready."};
+	
+	auto [success, parts] = encodeSmsSubmit(number, text, m_sms_ref_id, status_report);
+	if (!success)
+		return {false, -1, "Can't encode message."};
+	
+	SmsDb::Sms sms;
+	sms.type = SmsDb::SMS_OUTGOING;
+	sms.flags = SmsDb::SMS_IS_PENDING;
+	sms.ref_id = parts.size() > 1 ? m_sms_ref_id++ : 0;
+	sms.addr = number;
+	sms.parts.resize(1);
+	sms.parts[0].text = text;
+	
+	int id = m_sms.insert(std::move(sms));
+	saveSms();
+	
+	LOGD("[sms] message #%d queued, %zu parts\n", id, parts.size());
+	
+	m_sms_queue.push_back({.id = id, .parts = std::move(parts)});
+	sendNextSms();
+	
+	return {true, id, ""};
+}
+
+void ModemService::sendNextSms() {
+	if (m_sms_sending || !m_sms_queue.size())
+		return;
+	
+	auto &job = m_sms_queue.front();
+	
+	// Next part or next message follows this one
+	bool more_messages = (job.part + 1 < job.parts.size() || m_sms_queue.size() > 1);
+	int64_t start = getCurrentTimestamp();
+	
+	m_sms_sending = true;
+	
+	bool queued = m_modem && m_modem->sendSms(job.parts[job.part], more_messages, [this, start](bool success, int mr, const std::string &error) {
+		m_sms_sending = false;
+		handleSmsPartSent(success, getCurrentTimestamp() - start, error);
+	});
+	
+	if (!queued) {
+		Loop::post([this]() {
+			m_sms_sending = false;
+			handleSmsPartSent(false, 0, "Can't send SMS.");
+		});
+	}
+}
+
+void ModemService::handleSmsPartSent(bool success, int64_t latency, const std::string &error) {
+	if (!m_sms_queue.size())
+		return;
+	
+	auto &job = m_sms_queue.front();
+	
+	if (success) {
+		m_sms_send_stats.parts++;
+		m_sms_send_stats.last_latency = latency;
+		m_sms_send_stats.max_latency = std::max(m_sms_send_stats.max_latency, latency);
+		m_sms_send_stats.total_latency += latency;
+		m_sms_sent_times.push_back(getCurrentTimestamp());
+		getSmsPartsPerMinute(); // drop old timestamps
+		
+		if (++job.part < job.parts.size()) {
+			sendNextSms();
+			return;
+		}
+		
+		LOGD("[sms] message #%d sent\n", job.id);
+		m_sms.setFlags(job.id, SmsDb::SMS_NO_FLAGS, SmsDb::SMS_IS_PENDING);
+		m_sms_send_stats.sent++;
+	} else {
+		LOGE("[sms] message #%d failed on part %zu/%zu: %s\n", job.id, job.part + 1, job.parts.size(), error.c_str());
+		m_sms.setFlags(job.id, SmsDb::SMS_IS_FAILED, SmsDb::SMS_IS_PENDING);
+		m_sms_send_stats.failed++;
+	}
+	
+	m_sms_queue.pop_front();
+	saveSms();
+	sendNextSms();
+}
+
+int ModemService::getSmsPartsPerMinute() {
+	int64_t now = getCurrentTimestamp();
+	while (m_sms_sent_times.size() > 0 && now - m_sms_sent_times.front() > 60 * 1000)
+		m_sms_sent_times.pop_front();
+	return m_sms_sent_times.size();
+}
@@ -3,7 +3,11 @@
 #include <signal.h>
 #include <pthread.h>
 #include <map>
+#include <mutex>
+#include <atomic>
+#include <vector>
 #include <string>
+#include <functional>
 
 #include <Core/Log.h>
 #include <Core/Loop.h>
@@ -18,7 +22,10 @@ class ModemService;
 
 class ModemServiceApi {
 	protected:
+		static constexpr size_t MAX_SIGNAL_HISTORY_POINTS = 720;
+		
 		Ubus *m_ubus = nullptr;
+		UbusObject *m_object = nullptr;
 		Modem *m_modem = nullptr;
 		ModemService *m_service = nullptr;
 		SmsDb *m_sms = nullptr;
@@ -30,29 +37,21 @@ class ModemServiceApi {
 		};
 		
 		std::map<std::string, DeferApiResult> m_deferred_results;
+		std::atomic<bool> m_has_subscribers = false;
+		
+		// Single-flight: identical requests wait for one modem operation
+		std::mutex m_flights_mutex;
+		std::map<std::string, std::vector<std::shared_ptr<UbusRequest>>> m_flights;
+		std::map<std::string, uint64_t> m_coalesced;
 		
-		void reply(std::shared_ptr<UbusRequest> req, json result, int status = 0);
+		void reply(std::shared_ptr<UbusRequest> req, std::shared_ptr<BlobWriter> result, int status = 0);
+		void replyError(std::shared_ptr<UbusRequest> req, const std::string &error);
 		void initApiRequest(std::shared_ptr<UbusRequest> req);
+		void singleFlight(const std::string &key, std::shared_ptr<UbusRequest> req, const std::function<std::shared_ptr<BlobWriter>()> &callback);
 		
-		inline std::string getStrArg(const json &params, std::string key, std::string default_value = "") {
-			if (!params.contains(key))
-				return default_value;
-			return params[key].is_string() ? params[key].get<std::string>() : default_value;
-		}
+		static std::shared_ptr<BlobWriter> createError(const std::string &error);
 		
-		inline int getIntArg(const json &params, std::string key, int default_value = 0) {
-			if (!params.contains(key))
-				return default_value;
-			if (params[key].is_string())
-				return strToInt(params[key].get<std::string>(), 10, 0);
-			return params[key].is_number() ? params[key].get<int>() : default_value;
-		}
-		
-		inline bool getBoolArg(const json &params, std::string key, bool default_value = false) {
-			if (!params.contains(key))
-				return default_value;
-			return params[key].is_boolean() ? params[key].get<bool>() : default_value;
-		}
+		static bool parseSmsCursor(const std::string &str, SmsDb::SmsCursor *cursor);
 		
 		// Modem API
 		void apiGetModemInfo(std::shared_ptr<UbusRequest> req);
@@ -63,11 +62,15 @@ class ModemServiceApi {
 		void apiCancelUssd(std::shared_ptr<UbusRequest> req);
 		void apiReadSms(std::shared_ptr<UbusRequest> req);
 		void apiDeleteSms(std::shared_ptr<UbusRequest> req);
+		void apiSendSms(std::shared_ptr<UbusRequest> req);
+		void apiGetSmsQueue(std::shared_ptr<UbusRequest> req);
 		void apiSearchOperators(std::shared_ptr<UbusRequest> req);
 		void apiSetOperator(std::shared_ptr<UbusRequest> req);
 		void apiGetNetworkSettings(std::shared_ptr<UbusRequest> req);
 		void apiSetNetworkSettings(std::shared_ptr<UbusRequest> req);
 		void apiGetNeighboringCell(std::shared_ptr<UbusRequest> req);
+		void apiGetStats(std::shared_ptr<UbusRequest> req);
+		void apiGetSignalHistory(std::shared_ptr<UbusRequest> req);
 		
 		// Internal API
 		int apiGetDeferredResult(std::shared_ptr<UbusRequest> req);
@@ -87,4 +90,13 @@ class ModemServiceApi {
 		}
 		
 		bool start();
+		bool stop();
+		
+		inline bool hasSubscribers() const {
+			return m_has_subscribers;
+		}
+		
+		// Can be called from any thread, event is built only when someone is subscribed
+		void notify(const std::string &type, const std::function<void(BlobWriter *)> &callback);
+		void notifySignal(const Modem::NetworkState &state);
 };
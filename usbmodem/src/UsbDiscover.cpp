@@ -2,6 +2,7 @@
 
 #include <cstdio>
 #include <cstring>
+#include <algorithm>
 #include <string>
 #include <vector>
 #include <fstream>
@@ -152,30 +153,29 @@ std::pair<bool, UsbDiscover::Dev> UsbDiscover::findDevice(const std::string &url
 		return {false, {}};
 	
 	for (auto &path: getUsbDevicesByUrl(parsed_url)) {
-		bool used = false;
 		auto [net_list, tty_list] = getUsbDevInterfaces(path);
-		
-		for (auto &tty: tty_list) {
-			if (isDeviceLocked("/dev/" + tty.name, allow_owner)) {
-				used = true;
-				break;
-			}
-		}
-		
-		for (auto &net: net_list) {
-			if (isDeviceLocked(net.name, allow_owner)) {
-				used = true;
-				break;
-			}
-		}
-		
-		if (!used)
-			return {true, {path, net_list, tty_list}};
+		Dev dev = {path, net_list, tty_list};
+		if (!isDeviceUsed(dev, allow_owner))
+			return {true, dev};
 	}
 	
 	return {false, {}};
 }
 
+bool UsbDiscover::isDeviceUsed(const Dev &dev, const std::string &allow_owner) {
+	for (auto &tty: dev.tty) {
+		if (isDeviceLocked("/dev/" + tty.name, allow_owner))
+			return true;
+	}
+	
+	for (auto &net: dev.net) {
+		if (isDeviceLocked(net.name, allow_owner))
+			return true;
+	}
+	
+	return false;
+}
+
 std::string UsbDiscover::getFromDevice(const Dev &dev, const std::string &path) {
 	if (strStartsWith(path, "tty")) {
 		int id = strToInt(path.substr(3), 10, -1);
@@ -219,11 +219,12 @@ const char *UsbDiscover::getEnumName(ModemNetworkType type) {
 }
 
 const UsbDiscover::ModemDescr *UsbDiscover::findModemDescr(uint16_t vid, uint16_t pid) {
-	for (auto &descr: m_modem_list) {
-		if (descr.vid == vid && descr.pid == pid)
-			return &descr;
-	}
-	return nullptr;
+	uint32_t id = (static_cast<uint32_t>(vid) << 16) | pid;
+	auto end = m_modem_list + m_modem_list_size;
+	auto it = std::lower_bound(m_modem_list, end, id, [](const ModemDescr &descr, uint32_t id) {
+		return descr.getId() < id;
+	});
+	return it != end && it->getId() == id ? it : nullptr;
 }
 
 std::pair<std::vector<UsbDiscover::DevItem>, std::vector<UsbDiscover::DevItem>> UsbDiscover::getUsbDevInterfaces(const std::string &path) {
@@ -314,13 +315,13 @@ void UsbDiscover::discoverModem(json &main_json, const std::string &path) {
 	if (descr && descr->hasNetDev())
 		url.params["net_count"] = std::to_string(net_list.size());
 	url.params["serial"] = serial;
-	url.params["name"] = descr ? descr->name : name;
+	url.params["name"] = descr ? descr->getName() : name;
 	
 	json usb_info = {
 		{"vid", vid},
 		{"pid", pid},
 		{"serial", serial},
-		{"name", descr ? descr->name : name},
+		{"name", descr ? descr->getName() : name},
 		{"url", mkUsbUrl(url)},
 		{"net", json::array()},
 		{"tty", json::array()},
@@ -353,6 +354,12 @@ void UsbDiscover::discoverModem(json &main_json, const std::string &path) {
 		
 		if (descr->hasNetDev())
 			usb_info["modem"]["net"] = "net0";
+		
+		if (descr->baudrate)
+			usb_info["modem"]["baudrate"] = descr->baudrate;
+		
+		if (*descr->getInitCommands())
+			usb_info["modem"]["init"] = descr->getInitCommands();
 	}
 	
 	main_json["usb"].push_back(usb_info);
@@ -394,7 +401,7 @@ void UsbDiscover::discoverConfig(json &main_json) {
 			{"vid", url.vid},
 			{"pid", url.pid},
 			{"serial", getMapValue(url.params, "serial", "")},
-			{"name", getMapValue(url.params, "name", (descr ? descr->name : "Unknown Modem"))},
+			{"name", getMapValue(url.params, "name", (descr ? descr->getName() : "Unknown Modem"))},
 			{"url", device_url},
 			{"net", json::array()},
 			{"tty", json::array()},
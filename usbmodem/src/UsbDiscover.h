@@ -25,11 +25,25 @@ class UsbDiscover {
 		struct ModemDescr {
 			uint16_t vid;
 			uint16_t pid;
-			std::string name;
 			ModemType type;
 			ModemNetworkType net;
 			uint8_t tty_control;
 			uint8_t tty_data;
+			uint32_t baudrate;		// preferred tty baudrate, 0 - default
+			uint16_t name;			// offset in m_modem_strings
+			uint16_t init;			// offset in m_modem_strings, custom AT commands separated by \n
+			
+			constexpr uint32_t getId() const {
+				return (static_cast<uint32_t>(vid) << 16) | pid;
+			}
+			
+			inline const char *getName() const {
+				return &m_modem_strings[name];
+			}
+			
+			inline const char *getInitCommands() const {
+				return &m_modem_strings[init];
+			}
 			
 			inline bool hasNetDev() const {
 				return (type == TYPE_ASR1802 || type == TYPE_NCM);
@@ -57,7 +71,10 @@ class UsbDiscover {
 		
 		static std::map<std::string, FILE *> m_locks;
 	protected:
-		static const std::vector<ModemDescr> m_modem_list;
+		// Generated by gen-modems-index.pl, sorted by vid:pid
+		static const char *const m_modem_strings;
+		static const ModemDescr *const m_modem_list;
+		static const size_t m_modem_list_size;
 	
 	public:
 		static int run(const std::string &type, int argc, char *argv[]);
@@ -72,6 +89,7 @@ class UsbDiscover {
 		static std::pair<bool, DevUrl> parseUsbUrl(const std::string &url);
 		
 		static std::pair<bool, Dev> findDevice(const std::string &url, const std::string &allow_owner);
+		static bool isDeviceUsed(const Dev &dev, const std::string &allow_owner);
 		static std::string getFromDevice(const Dev &dev, const std::string &path);
 		
 		/*
@@ -1,284 +1,513 @@
 #include "UsbDiscover.h"
 
 /* DO NOT EDIT! THIS FILE GENERATED BY gen-modems-index.pl */
-const std::vector<UsbDiscover::ModemDescr> UsbDiscover::m_modem_list = {
-	{0x0421,	0x03a7,	"Nokia C5-00 Mobile phone",									UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0},
-	{0x0421,	0x060d,	"Nokia CS-10",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0},
-	{0x0421,	0x060e,	"Nokia CS-10",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0},
-	{0x0421,	0x0612,	"Nokia CS-15/CS-18",										UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0},
-	{0x0421,	0x0619,	"Nokia CS-12",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0},
-	{0x0421,	0x061e,	"Nokia CS-11",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0},
-	{0x0421,	0x0623,	"Nokia CS-17",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0},
-	{0x0421,	0x0629,	"Nokia CS-18",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0},
-	{0x0421,	0x062d,	"Nokia CS-19",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0},
-	{0x0421,	0x062f,	"Nokia CS-19",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0},
-	{0x0421,	0x0638,	"Nokia 21M-02",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0},
-	{0x05c6,	0x0016,	"iBall 3.5G Connect",										UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	2},
-	{0x05c6,	0x0023,	"Leoxsys LN-72V",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0},
-	{0x05c6,	0x00a0,	"Axesstel MV241",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0},
-	{0x05c6,	0x6000,	"Siemens SG75",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0},
-	{0x05c6,	0x9000,	"Generic Qualcomm",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	2},
-	{0x07d1,	0x3e01,	"D-Link DWM-152",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x07d1,	0x3e02,	"D-Link DWM-156",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x07d1,	0x7e11,	"D-Link DWM-156",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	2},
-	{0x0af0,	0x6901,	"Option GI0201",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x0af0,	0x7201,	"Option GTM380",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x0af0,	0x9200,	"Option GTM671WFS",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	2},
-	{0x0b3c,	0xc003,	"Olivetti Olicard 145",										UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	4},
-	{0x0bdb,	0x1900,	"Ericsson F3507g",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	4,	1},
-	{0x0bdb,	0x1902,	"Ericsson F3507g",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	4,	1},
-	{0x0bdb,	0x190a,	"Ericsson F3307",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	4,	1},
-	{0x0bdb,	0x190d,	"Ericsson F5521gw",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	4,	1},
-	{0x0bdb,	0x1910,	"Ericsson F5521gw",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	4,	1},
-	{0x0c88,	0x17da,	"Kyocera KPC650",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0},
-	{0x0c88,	0x180a,	"Kyocera KPC680",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0},
-	{0x0f3d,	0x68aa,	"Sierra Wireless AC313U/320U/330U Direct IP",				UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	3},
-	{0x1004,	0x6124,	"LG L-05A",													UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	2},
-	{0x1004,	0x6141,	"LG LUU-2100TI",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	2},
-	{0x1004,	0x6157,	"LG LUU-2110TI",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	2},
-	{0x1004,	0x618f,	"LG L-02C",													UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	2},
-	{0x106c,	0x3711,	"PANTECH UM-150",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0},
-	{0x106c,	0x3714,	"PANTECH UM-175",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0},
-	{0x106c,	0x3715,	"PANTECH UM-175AL",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0},
-	{0x106c,	0x3716,	"PANTECH UM-190",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0},
-	{0x106c,	0x3717,	"PANTECH UM-185C/UM185E",									UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0},
-	{0x1199,	0x0017,	"Sierra EM5625",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	4},
-	{0x1199,	0x0018,	"Sierra MC5720",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	4},
-	{0x1199,	0x0019,	"Sierra AC595U",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	4},
-	{0x1199,	0x0020,	"Sierra MC5725",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	4},
-	{0x1199,	0x0021,	"Sierra AC597E",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	4},
-	{0x1199,	0x0022,	"Sierra EM5725",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	4},
-	{0x1199,	0x0023,	"Sierra AC597",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	4},
-	{0x1199,	0x0024,	"Sierra MC5727 CDMA",										UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	4},
-	{0x1199,	0x0025,	"Sierra AC598",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	4},
-	{0x1199,	0x0026,	"Sierra T11",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	4},
-	{0x1199,	0x0027,	"Sierra AC402",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	4},
-	{0x1199,	0x0028,	"Sierra MC5728",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	4},
-	{0x1199,	0x0112,	"Sierra CDMA 1xEVDO PC Card, AC580",						UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	4},
-	{0x1199,	0x0120,	"Sierra AC595U",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	4},
-	{0x1199,	0x0218,	"Sierra MC5720",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	4},
-	{0x1199,	0x0220,	"Sierra MC5725",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	4},
-	{0x1199,	0x0224,	"Sierra MC5727",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	4},
-	{0x1199,	0x0301,	"Sierra AC250U",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	4},
-	{0x1199,	0x6802,	"Sierra MC8755",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	2},
-	{0x1199,	0x6803,	"Sierra MC8765",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	2},
-	{0x1199,	0x6804,	"Sierra MC8755",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	2},
-	{0x1199,	0x6805,	"Sierra MC8765",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	2},
-	{0x1199,	0x6808,	"Sierra MC8755",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	2},
-	{0x1199,	0x6809,	"Sierra MC8755",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	2},
-	{0x1199,	0x6813,	"Sierra MC8775",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	2},
-	{0x1199,	0x6815,	"Sierra MC8775",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	2},
-	{0x1199,	0x6816,	"Sierra MC8775",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	2},
-	{0x1199,	0x6820,	"Sierra AC875",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	2},
-	{0x1199,	0x6821,	"Sierra AC875U",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0},
-	{0x1199,	0x6822,	"Sierra AC875E",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	4},
-	{0x1199,	0x6833,	"Sierra MC8781",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	4},
-	{0x1199,	0x6834,	"Sierra MC8780",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	4},
-	{0x1199,	0x6835,	"Sierra MC8781",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	4},
-	{0x1199,	0x6838,	"Sierra MC8780",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	4},
-	{0x1199,	0x6839,	"Sierra MC8781",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	4},
-	{0x1199,	0x683a,	"Sierra MC8785",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	4},
-	{0x1199,	0x683b,	"Sierra MC8785 Composite",									UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	4},
-	{0x1199,	0x6850,	"Sierra AC880",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0},
-	{0x1199,	0x6851,	"Sierra AC 881",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0},
-	{0x1199,	0x6852,	"Sierra AC880E",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0},
-	{0x1199,	0x6853,	"Sierra AC881E",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0},
-	{0x1199,	0x6855,	"Sierra AC880U",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0},
-	{0x1199,	0x6856,	"Sierra ATT USB Connect 881",								UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0},
-	{0x1199,	0x6859,	"Sierra AC885E",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0},
-	{0x1199,	0x685a,	"Sierra AC885E",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0},
-	{0x1199,	0x6880,	"Sierra C885",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	3},
-	{0x1199,	0x6890,	"Sierra C888",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	3},
-	{0x1199,	0x6891,	"Sierra C22 and C33",										UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	3},
-	{0x1199,	0x6892,	"Sierra Compass HSPA",										UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	3},
-	{0x1199,	0x6893,	"Sierra C889",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	3},
-	{0x1199,	0x68aa,	"Sierra AC320U/AC330U Direct IP",							UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	3},
-	{0x11f5,	0x0004,	"Siemens X75",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0},
-	{0x11f5,	0x1004,	"Siemens X75 (2nd COM)",									UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x1286,	0x4e3d,	"Marvell ASR1802",											UsbDiscover::TYPE_ASR1802,	UsbDiscover::NET_GSM,	1,	1},
-	{0x12d1,	0x1035,	"HUAWEI U8110",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0},
-	{0x12d1,	0x1406,	"HUAWEI/Option newer modems",								UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x12d1,	0x140b,	"HUAWEI/Option EC1260 Wireless Data Modem HSD USB Card",	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0},
-	{0x12d1,	0x1412,	"HUAWEI/Option EC168",										UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0},
-	{0x12d1,	0x141b,	"HUAWEI/Option newer modems",								UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x12d1,	0x1433,	"HUAWEI/Option E1756C",										UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0},
-	{0x12d1,	0x1436,	"HUAWEI/Option E1800",										UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0},
-	{0x12d1,	0x1444,	"HUAWEI/Option E352-R1",									UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0},
-	{0x12d1,	0x144e,	"Huawei K3806",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	2},
-	{0x12d1,	0x1464,	"Huawei K4505",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0},
-	{0x12d1,	0x1465,	"Huawei K3765",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0},
-	{0x12d1,	0x1491,	"Huawei R201",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0},
-	{0x12d1,	0x14a5,	"Huawei E173",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0},
-	{0x12d1,	0x14a8,	"Huawei E173",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0},
-	{0x12d1,	0x14ae,	"Huawei K3806",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	2},
-	{0x12d1,	0x14cb,	"Huawei K4510",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0},
-	{0x12d1,	0x14cf,	"Huawei K3772",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0},
-	{0x12d1,	0x1506,	"Huawei E367/E398",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0},
-	{0x12d1,	0x151d,	"Huawei E3131",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	0},
-	{0x12d1,	0x155e,	"Huawei E3372",												UsbDiscover::TYPE_NCM,		UsbDiscover::NET_GSM,	2,	2},
-	{0x12d1,	0x156c,	"Huawei E3276",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x12d1,	0x1589,	"Huawei E8278",												UsbDiscover::TYPE_NCM,		UsbDiscover::NET_GSM,	0,	0},
-	{0x12d1,	0x1c05,	"Huawei E173s",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0},
-	{0x12d1,	0x1c07,	"Huawei E188",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0},
-	{0x12d1,	0x1c08,	"Huawei E173s",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x12d1,	0x1c10,	"Huawei E173",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0},
-	{0x12d1,	0x1c12,	"Huawei E173",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0},
-	{0x12d1,	0x1c1e,	"Huawei E586",												UsbDiscover::TYPE_NCM,		UsbDiscover::NET_GSM,	0,	0},
-	{0x12d1,	0x1c1f,	"Huawei E587",												UsbDiscover::TYPE_NCM,		UsbDiscover::NET_GSM,	0,	0},
-	{0x12d1,	0x1c23,	"Huawei E173",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	2},
-	{0x1410,	0x1400,	"Novatel U730",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x1410,	0x1410,	"Novatel U740",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x1410,	0x1420,	"Novatel U870",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x1410,	0x1430,	"Novatel XU870",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x1410,	0x1450,	"Novatel X950D",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x1410,	0x2100,	"Novatel EV620",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x1410,	0x2110,	"Novatel ES720",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x1410,	0x2120,	"Novatel E725",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x1410,	0x2130,	"Novatel ES620",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x1410,	0x2400,	"Novatel EU730",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x1410,	0x2410,	"Novatel EU740",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x1410,	0x2420,	"Novatel EU870D",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x1410,	0x4100,	"Novatel MC727/U727",										UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x1410,	0x4400,	"Novatel Ovation MC930D/MC950D",							UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x1410,	0x6000,	"Novatel USB760",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x1410,	0x6001,	"Novatel USB760",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x1410,	0x6002,	"Novatel USB760 3G",										UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x1410,	0x6010,	"Novatel MC780",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x1410,	0x7001,	"Novatel MiFi 2372",										UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x1410,	0x7003,	"Novatel MiFi 2372",										UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x1410,	0x7030,	"Novatel USB998",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0},
-	{0x1410,	0x7031,	"Novatel USB679",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0},
-	{0x1410,	0x7041,	"Novatel MF3470",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0},
-	{0x1410,	0x7042,	"Novatel Ovation MC545/MC547",								UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0},
-	{0x1529,	0x3100,	"UBIQUAM U-100/105/200/300/520",							UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0},
-	{0x16d5,	0x6202,	"AnyData ADU-620UW",										UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0},
-	{0x16d5,	0x6501,	"AnyData ADU-300A",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x16d5,	0x6502,	"AnyData ADU-500A",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0},
-	{0x16d5,	0x6603,	"AnyData ADU-890WH",										UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0},
-	{0x16d5,	0x900d,	"AnyData ADU-890WH",										UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0},
-	{0x16d8,	0x5141,	"Cmotech CNU-510",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0},
-	{0x16d8,	0x5533,	"Cmotech CNU-550",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0},
-	{0x16d8,	0x5543,	"Cmotech CNU-550",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0},
-	{0x16d8,	0x5553,	"Cmotech CDU-550",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0},
-	{0x16d8,	0x6002,	"Franklin U300",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x16d8,	0x6006,	"Cmotech CGU-628",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0},
-	{0x16d8,	0x6522,	"Cmotech CDU-650",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0},
-	{0x16d8,	0x6523,	"Cmotech CCU-650U",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0},
-	{0x16d8,	0x6532,	"Cmotech CCU-650",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0},
-	{0x16d8,	0x6533,	"Cmotech CNM-650",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0},
-	{0x16d8,	0x6543,	"Cmotech CNU-650",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0},
-	{0x16d8,	0x680a,	"Cmotech CDU-680",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0},
-	{0x19d2,	0x0001,	"ONDA MT505UP/ZTE",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0},
-	{0x19d2,	0x0015,	"ONDA MT505UP/ZTE",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0},
-	{0x19d2,	0x0016,	"ONDA MF110/ZTE",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	2},
-	{0x19d2,	0x0018,	"ONDA MSA110UP/ZTE",										UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	2},
-	{0x19d2,	0x0022,	"ZTE K2525",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x19d2,	0x0024,	"ONDA MT503HSA",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0},
-	{0x19d2,	0x0033,	"ZTE MF636",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	4},
-	{0x19d2,	0x0037,	"ONDA MT505UP/ZTE",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	2},
-	{0x19d2,	0x0039,	"ZTE MF100",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	2},
-	{0x19d2,	0x0057,	"AIKO 83D",													UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	2},
-	{0x19d2,	0x0064,	"ZTE MF627",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	2},
-	{0x19d2,	0x0066,	"ZTE MF626",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	3},
-	{0x19d2,	0x0073,	"ZTE A580",													UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x19d2,	0x0079,	"ZTE A353",													UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	2},
-	{0x19d2,	0x0082,	"ZTE MF668/MF190",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	2},
-	{0x19d2,	0x0086,	"ZTE MF645",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	2},
-	{0x19d2,	0x0091,	"ZTE MF636",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	3},
-	{0x19d2,	0x0094,	"ZTE AC581",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	0},
-	{0x19d2,	0x0108,	"ONDA MT505UP/ZTE",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	3},
-	{0x19d2,	0x0116,	"ZTE MF651",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x19d2,	0x0117,	"ZTE MF112",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	2},
-	{0x19d2,	0x0128,	"ZTE MF651",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	3},
-	{0x19d2,	0x0142,	"ZTE MF665C",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0},
-	{0x19d2,	0x0143,	"ZTE MF190B",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0},
-	{0x19d2,	0x0152,	"ZTE AC583",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0},
-	{0x19d2,	0x0170,	"ZTE A371",													UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	1},
-	{0x19d2,	0x1003,	"ZTE K3805-Z",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x19d2,	0x1015,	"ZTE K3806-Z",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x19d2,	0x1172,	"ZTE K4510-Z",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0},
-	{0x19d2,	0x1173,	"ZTE K4510-Z",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0},
-	{0x19d2,	0x1177,	"ZTE K3770-Z",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0},
-	{0x19d2,	0x1181,	"ZTE K3772-Z",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0},
-	{0x19d2,	0x1203,	"ZTE MF691",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0},
-	{0x19d2,	0x1208,	"ZTE MF192",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0},
-	{0x19d2,	0x1211,	"ZTE MF195",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0},
-	{0x19d2,	0x1212,	"ZTE MF195",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0},
-	{0x19d2,	0x1217,	"ZTE MF192",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0},
-	{0x19d2,	0x1218,	"ZTE MF192",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0},
-	{0x19d2,	0x1220,	"ZTE MF192",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0},
-	{0x19d2,	0x1222,	"ZTE MF192",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0},
-	{0x19d2,	0x1512,	"ZTE MFxxx",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0},
-	{0x19d2,	0x1515,	"ZTE MF192",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0},
-	{0x19d2,	0x1518,	"ZTE MF192",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0},
-	{0x19d2,	0x1519,	"ZTE MF192",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0},
-	{0x19d2,	0x1522,	"ZTE MF652",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0},
-	{0x19d2,	0x1525,	"ZTE MF591",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0},
-	{0x19d2,	0x1527,	"ZTE MF196",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0},
-	{0x19d2,	0x1537,	"ZTE MF190J",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0},
-	{0x19d2,	0x1538,	"ZTE MF190J",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0},
-	{0x19d2,	0x1544,	"ZTE MF190J",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0},
-	{0x19d2,	0x2003,	"ZTE MF180",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	3},
-	{0x19d2,	0xffdd,	"ZTE AC682",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x19d2,	0xffe4,	"ZTE AC3781",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x19d2,	0xffe9,	"ZTE AC2738",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x19d2,	0xfff1,	"ZTE generic",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x19d2,	0xfffb,	"ZTE MG880",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x19d2,	0xfffc,	"ZTE MG880",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x19d2,	0xfffd,	"ZTE MG880",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x19d2,	0xfffe,	"ZTE AC8700",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x19d2,	0xffff,	"ZTE AC8710",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x1a8d,	0x1002,	"Bandrich C-100/C-120",										UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x1a8d,	0x1003,	"Bandrich C-100/C-120",										UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x1a8d,	0x1007,	"Bandrich C-270",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0},
-	{0x1a8d,	0x1009,	"Bandrich C-170/C-180",										UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0},
-	{0x1a8d,	0x100c,	"Bandrich C-320",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0},
-	{0x1a8d,	0x100d,	"Bandrich C-508",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0},
-	{0x1a8d,	0x2006,	"Bandrich C-33x",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	1},
-	{0x1bbb,	0x0000,	"Alcatel X060S/X070S/X080S/X200",							UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	2},
-	{0x1bbb,	0x0012,	"Alcatel X085C",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	2},
-	{0x1bbb,	0x0017,	"Alcatel X220L",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	4,	4},
-	{0x1bbb,	0x0052,	"Alcatel X220L",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	4,	4},
-	{0x1bbb,	0x00b7,	"Alcatel X600",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	4},
-	{0x1bbb,	0x00ca,	"Alcatel X080C",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0},
-	{0x1c9e,	0x6060,	"Alcatel X020 & X030",										UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0},
-	{0x1c9e,	0x6061,	"Alcatel X020 & X030",										UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0},
-	{0x1c9e,	0x9000,	"4G Systems XS Stick W14",									UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0},
-	{0x1c9e,	0x9603,	"4G Systems XS Stick W14",									UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	2},
-	{0x1c9e,	0x9605,	"4G Systems XS Stick W14",									UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	3},
-	{0x1c9e,	0x9607,	"4G Systems XS Stick W14",									UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	3},
-	{0x1c9e,	0x9801,	"4G Systems XS Stick W21",									UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	1},
-	{0x1c9e,	0x9900,	"Softbank C02LC",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	2},
-	{0x1e0e,	0x9000,	"PROLink PHS100, Hyundai MB-810, A-Link 3GU",				UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	2},
-	{0x1e0e,	0x9100,	"PROLink PHS300, A-Link 3GU",								UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	2},
-	{0x1e0e,	0x9200,	"PROLink PHS100, Hyundai MB-810, A-Link 3GU",				UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	2},
-	{0x1e0e,	0xce16,	"D-Link DWM-162-U5, Micromax MMX 300c",						UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x1e0e,	0xcefe,	"D-Link DWM-162-U5, Micromax MMX 300c",						UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	2},
-	{0x1e2d,	0x0053,	"Cinterion PH8",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	3},
-	{0x1e2d,	0x005b,	"Cinterion ELS61",											UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x2001,	0x7d00,	"D-Link DWM-156 A6",										UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x2001,	0x7d01,	"D-Link DWM-156 A7",										UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x2001,	0x7d02,	"D-Link DWM-156 A7",										UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x2001,	0x7d03,	"D-Link DWM-156 A7",										UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x201e,	0x10f8,	"Haier CE81b",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_CDMA,	1,	3},
-	{0x211f,	0x6801,	"Celot K-3000/CT-650/CT-680",								UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0},
-	{0x413c,	0x8114,	"Dell 5700",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x413c,	0x8115,	"Dell 5500",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x413c,	0x8116,	"Dell 5505",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x413c,	0x8117,	"Dell 5700",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x413c,	0x8118,	"Dell 5510",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x413c,	0x8128,	"Dell 5700",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x413c,	0x8129,	"Dell 5700",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x413c,	0x8133,	"Dell 5720",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x413c,	0x8134,	"Dell 5720",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x413c,	0x8135,	"Dell 5720",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x413c,	0x8136,	"Dell 5520",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x413c,	0x8137,	"Dell 5520",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x413c,	0x8138,	"Dell 5520",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x413c,	0x8147,	"Dell 5530",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	1},
-	{0x413c,	0x8180,	"Dell 5730",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x413c,	0x8181,	"Dell 5730",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x413c,	0x8182,	"Dell 5730",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0x413c,	0x819b,	"Dell 5804",												UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0},
-	{0,			0,		"",															UsbDiscover::TYPE_UNKNOWN,	UsbDiscover::NET_GSM,	0,	0},
+static constexpr char modem_strings[] =
+	"\0"
+	"Nokia C5-00 Mobile phone\0"
+	"Nokia CS-10\0"
+	"Nokia CS-15/CS-18\0"
+	"Nokia CS-12\0"
+	"Nokia CS-11\0"
+	"Nokia CS-17\0"
+	"Nokia CS-18\0"
+	"Nokia CS-19\0"
+	"Nokia 21M-02\0"
+	"iBall 3.5G Connect\0"
+	"Leoxsys LN-72V\0"
+	"Axesstel MV241\0"
+	"Siemens SG75\0"
+	"Generic Qualcomm\0"
+	"D-Link DWM-152\0"
+	"D-Link DWM-156\0"
+	"Option GI0201\0"
+	"Option GTM380\0"
+	"Option GTM671WFS\0"
+	"Olivetti Olicard 145\0"
+	"Ericsson F3507g\0"
+	"Ericsson F3307\0"
+	"Ericsson F5521gw\0"
+	"Kyocera KPC650\0"
+	"Kyocera KPC680\0"
+	"Sierra Wireless AC313U/320U/330U Direct IP\0"
+	"LG L-05A\0"
+	"LG LUU-2100TI\0"
+	"LG LUU-2110TI\0"
+	"LG L-02C\0"
+	"PANTECH UM-150\0"
+	"PANTECH UM-175\0"
+	"PANTECH UM-175AL\0"
+	"PANTECH UM-190\0"
+	"PANTECH UM-185C/UM185E\0"
+	"Sierra EM5625\0"
+	"Sierra MC5720\0"
+	"Sierra AC595U\0"
+	"Sierra MC5725\0"
+	"Sierra AC597E\0"
+	"Sierra EM5725\0"
+	"Sierra AC597\0"
+	"Sierra MC5727 CDMA\0"
+	"Sierra AC598\0"
+	"Sierra T11\0"
+	"Sierra AC402\0"
+	"Sierra MC5728\0"
+	"Sierra CDMA 1xEVDO PC Card, AC580\0"
+	"Sierra MC5727\0"
+	"Sierra AC250U\0"
+	"Sierra MC8755\0"
+	"Sierra MC8765\0"
+	"Sierra MC8775\0"
+	"Sierra AC875\0"
+	"Sierra AC875U\0"
+	"Sierra AC875E\0"
+	"Sierra MC8781\0"
+	"Sierra MC8780\0"
+	"Sierra MC8785\0"
+	"Sierra MC8785 Composite\0"
+	"Sierra AC880\0"
+	"Sierra AC 881\0"
+	"Sierra AC880E\0"
+	"Sierra AC881E\0"
+	"Sierra AC880U\0"
+	"Sierra ATT USB Connect 881\0"
+	"Sierra AC885E\0"
+	"Sierra C885\0"
+	"Sierra C888\0"
+	"Sierra C22 and C33\0"
+	"Sierra Compass HSPA\0"
+	"Sierra C889\0"
+	"Sierra AC320U/AC330U Direct IP\0"
+	"Siemens X75\0"
+	"Siemens X75 (2nd COM)\0"
+	"Marvell ASR1802\0"
+	"HUAWEI U8110\0"
+	"HUAWEI/Option newer modems\0"
+	"HUAWEI/Option EC1260 Wireless Data Modem HSD USB Card\0"
+	"HUAWEI/Option EC168\0"
+	"HUAWEI/Option E1756C\0"
+	"HUAWEI/Option E1800\0"
+	"HUAWEI/Option E352-R1\0"
+	"Huawei K3806\0"
+	"Huawei K4505\0"
+	"Huawei K3765\0"
+	"Huawei R201\0"
+	"Huawei E173\0"
+	"Huawei K4510\0"
+	"Huawei K3772\0"
+	"Huawei E367/E398\0"
+	"Huawei E3131\0"
+	"Huawei E3372\0"
+	"Huawei E3276\0"
+	"Huawei E8278\0"
+	"Huawei E173s\0"
+	"Huawei E188\0"
+	"Huawei E586\0"
+	"Huawei E587\0"
+	"Novatel U730\0"
+	"Novatel U740\0"
+	"Novatel U870\0"
+	"Novatel XU870\0"
+	"Novatel X950D\0"
+	"Novatel EV620\0"
+	"Novatel ES720\0"
+	"Novatel E725\0"
+	"Novatel ES620\0"
+	"Novatel EU730\0"
+	"Novatel EU740\0"
+	"Novatel EU870D\0"
+	"Novatel MC727/U727\0"
+	"Novatel Ovation MC930D/MC950D\0"
+	"Novatel USB760\0"
+	"Novatel USB760 3G\0"
+	"Novatel MC780\0"
+	"Novatel MiFi 2372\0"
+	"Novatel USB998\0"
+	"Novatel USB679\0"
+	"Novatel MF3470\0"
+	"Novatel Ovation MC545/MC547\0"
+	"UBIQUAM U-100/105/200/300/520\0"
+	"AnyData ADU-620UW\0"
+	"AnyData ADU-300A\0"
+	"AnyData ADU-500A\0"
+	"AnyData ADU-890WH\0"
+	"Cmotech CNU-510\0"
+	"Cmotech CNU-550\0"
+	"Cmotech CDU-550\0"
+	"Franklin U300\0"
+	"Cmotech CGU-628\0"
+	"Cmotech CDU-650\0"
+	"Cmotech CCU-650U\0"
+	"Cmotech CCU-650\0"
+	"Cmotech CNM-650\0"
+	"Cmotech CNU-650\0"
+	"Cmotech CDU-680\0"
+	"ONDA MT505UP/ZTE\0"
+	"ONDA MF110/ZTE\0"
+	"ONDA MSA110UP/ZTE\0"
+	"ZTE K2525\0"
+	"ONDA MT503HSA\0"
+	"ZTE MF636\0"
+	"ZTE MF100\0"
+	"AIKO 83D\0"
+	"ZTE MF627\0"
+	"ZTE MF626\0"
+	"ZTE A580\0"
+	"ZTE A353\0"
+	"ZTE MF668/MF190\0"
+	"ZTE MF645\0"
+	"ZTE AC581\0"
+	"ZTE MF651\0"
+	"ZTE MF112\0"
+	"ZTE MF665C\0"
+	"ZTE MF190B\0"
+	"ZTE AC583\0"
+	"ZTE A371\0"
+	"ZTE K3805-Z\0"
+	"ZTE K3806-Z\0"
+	"ZTE K4510-Z\0"
+	"ZTE K3770-Z\0"
+	"ZTE K3772-Z\0"
+	"ZTE MF691\0"
+	"ZTE MF192\0"
+	"ZTE MF195\0"
+	"ZTE MFxxx\0"
+	"ZTE MF652\0"
+	"ZTE MF591\0"
+	"ZTE MF196\0"
+	"ZTE MF190J\0"
+	"ZTE MF180\0"
+	"ZTE AC682\0"
+	"ZTE AC3781\0"
+	"ZTE AC2738\0"
+	"ZTE generic\0"
+	"ZTE MG880\0"
+	"ZTE AC8700\0"
+	"ZTE AC8710\0"
+	"Bandrich C-100/C-120\0"
+	"Bandrich C-270\0"
+	"Bandrich C-170/C-180\0"
+	"Bandrich C-320\0"
+	"Bandrich C-508\0"
+	"Bandrich C-33x\0"
+	"Alcatel X060S/X070S/X080S/X200\0"
+	"Alcatel X085C\0"
+	"Alcatel X220L\0"
+	"Alcatel X600\0"
+	"Alcatel X080C\0"
+	"Alcatel X020 & X030\0"
+	"4G Systems XS Stick W14\0"
+	"4G Systems XS Stick W21\0"
+	"Softbank C02LC\0"
+	"PROLink PHS100, Hyundai MB-810, A-Link 3GU\0"
+	"PROLink PHS300, A-Link 3GU\0"
+	"D-Link DWM-162-U5, Micromax MMX 300c\0"
+	"Cinterion PH8\0"
+	"Cinterion ELS61\0"
+	"D-Link DWM-156 A6\0"
+	"D-Link DWM-156 A7\0"
+	"Haier CE81b\0"
+	"Celot K-3000/CT-650/CT-680\0"
+	"Dell 5700\0"
+	"Dell 5500\0"
+	"Dell 5505\0"
+	"Dell 5510\0"
+	"Dell 5720\0"
+	"Dell 5520\0"
+	"Dell 5530\0"
+	"Dell 5730\0"
+	"Dell 5804\0";
+
+static constexpr UsbDiscover::ModemDescr modem_list[] = {
+	{0x0421,	0x03a7,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0,	0,	1,		0},
+	{0x0421,	0x060d,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0,	0,	26,		0},
+	{0x0421,	0x060e,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0,	0,	26,		0},
+	{0x0421,	0x0612,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0,	0,	38,		0},
+	{0x0421,	0x0619,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0,	0,	56,		0},
+	{0x0421,	0x061e,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0,	0,	68,		0},
+	{0x0421,	0x0623,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0,	0,	80,		0},
+	{0x0421,	0x0629,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0,	0,	92,		0},
+	{0x0421,	0x062d,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0,	0,	104,	0},
+	{0x0421,	0x062f,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0,	0,	104,	0},
+	{0x0421,	0x0638,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0,	0,	116,	0},
+	{0x05c6,	0x0016,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	2,	0,	129,	0},
+	{0x05c6,	0x0023,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0,	0,	148,	0},
+	{0x05c6,	0x00a0,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0,	0,	163,	0},
+	{0x05c6,	0x6000,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0,	0,	178,	0},
+	{0x05c6,	0x9000,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	2,	0,	191,	0},
+	{0x07d1,	0x3e01,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	208,	0},
+	{0x07d1,	0x3e02,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	223,	0},
+	{0x07d1,	0x7e11,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	2,	0,	223,	0},
+	{0x0af0,	0x6901,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	238,	0},
+	{0x0af0,	0x7201,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	252,	0},
+	{0x0af0,	0x9200,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	2,	0,	266,	0},
+	{0x0b3c,	0xc003,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	4,	0,	283,	0},
+	{0x0bdb,	0x1900,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	4,	1,	0,	304,	0},
+	{0x0bdb,	0x1902,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	4,	1,	0,	304,	0},
+	{0x0bdb,	0x190a,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	4,	1,	0,	320,	0},
+	{0x0bdb,	0x190d,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	4,	1,	0,	335,	0},
+	{0x0bdb,	0x1910,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	4,	1,	0,	335,	0},
+	{0x0c88,	0x17da,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0,	0,	352,	0},
+	{0x0c88,	0x180a,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0,	0,	367,	0},
+	{0x0f3d,	0x68aa,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	3,	0,	382,	0},
+	{0x1004,	0x6124,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	2,	0,	425,	0},
+	{0x1004,	0x6141,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	2,	0,	434,	0},
+	{0x1004,	0x6157,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	2,	0,	448,	0},
+	{0x1004,	0x618f,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	2,	0,	462,	0},
+	{0x106c,	0x3711,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0,	0,	471,	0},
+	{0x106c,	0x3714,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0,	0,	486,	0},
+	{0x106c,	0x3715,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0,	0,	501,	0},
+	{0x106c,	0x3716,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0,	0,	518,	0},
+	{0x106c,	0x3717,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0,	0,	533,	0},
+	{0x1199,	0x0017,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	4,	0,	556,	0},
+	{0x1199,	0x0018,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	4,	0,	570,	0},
+	{0x1199,	0x0019,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	4,	0,	584,	0},
+	{0x1199,	0x0020,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	4,	0,	598,	0},
+	{0x1199,	0x0021,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	4,	0,	612,	0},
+	{0x1199,	0x0022,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	4,	0,	626,	0},
+	{0x1199,	0x0023,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	4,	0,	640,	0},
+	{0x1199,	0x0024,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	4,	0,	653,	0},
+	{0x1199,	0x0025,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	4,	0,	672,	0},
+	{0x1199,	0x0026,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	4,	0,	685,	0},
+	{0x1199,	0x0027,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	4,	0,	696,	0},
+	{0x1199,	0x0028,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	4,	0,	709,	0},
+	{0x1199,	0x0112,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	4,	0,	723,	0},
+	{0x1199,	0x0120,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	4,	0,	584,	0},
+	{0x1199,	0x0218,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	4,	0,	570,	0},
+	{0x1199,	0x0220,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	4,	0,	598,	0},
+	{0x1199,	0x0224,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	4,	0,	757,	0},
+	{0x1199,	0x0301,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	4,	0,	771,	0},
+	{0x1199,	0x6802,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	2,	0,	785,	0},
+	{0x1199,	0x6803,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	2,	0,	799,	0},
+	{0x1199,	0x6804,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	2,	0,	785,	0},
+	{0x1199,	0x6805,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	2,	0,	799,	0},
+	{0x1199,	0x6808,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	2,	0,	785,	0},
+	{0x1199,	0x6809,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	2,	0,	785,	0},
+	{0x1199,	0x6813,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	2,	0,	813,	0},
+	{0x1199,	0x6815,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	2,	0,	813,	0},
+	{0x1199,	0x6816,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	2,	0,	813,	0},
+	{0x1199,	0x6820,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	2,	0,	827,	0},
+	{0x1199,	0x6821,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0,	0,	840,	0},
+	{0x1199,	0x6822,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	4,	0,	854,	0},
+	{0x1199,	0x6833,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	4,	0,	868,	0},
+	{0x1199,	0x6834,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	4,	0,	882,	0},
+	{0x1199,	0x6835,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	4,	0,	868,	0},
+	{0x1199,	0x6838,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	4,	0,	882,	0},
+	{0x1199,	0x6839,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	4,	0,	868,	0},
+	{0x1199,	0x683a,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	4,	0,	896,	0},
+	{0x1199,	0x683b,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	4,	0,	910,	0},
+	{0x1199,	0x6850,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0,	0,	934,	0},
+	{0x1199,	0x6851,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0,	0,	947,	0},
+	{0x1199,	0x6852,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0,	0,	961,	0},
+	{0x1199,	0x6853,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0,	0,	975,	0},
+	{0x1199,	0x6855,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0,	0,	989,	0},
+	{0x1199,	0x6856,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0,	0,	1003,	0},
+	{0x1199,	0x6859,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0,	0,	1030,	0},
+	{0x1199,	0x685a,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0,	0,	1030,	0},
+	{0x1199,	0x6880,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	3,	0,	1044,	0},
+	{0x1199,	0x6890,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	3,	0,	1056,	0},
+	{0x1199,	0x6891,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	3,	0,	1068,	0},
+	{0x1199,	0x6892,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	3,	0,	1087,	0},
+	{0x1199,	0x6893,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	3,	0,	1107,	0},
+	{0x1199,	0x68aa,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	3,	0,	1119,	0},
+	{0x11f5,	0x0004,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0,	0,	1150,	0},
+	{0x11f5,	0x1004,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	1162,	0},
+	{0x1286,	0x4e3d,	UsbDiscover::TYPE_ASR1802,	UsbDiscover::NET_GSM,	1,	1,	0,	1184,	0},
+	{0x12d1,	0x1035,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0,	0,	1200,	0},
+	{0x12d1,	0x1406,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	1213,	0},
+	{0x12d1,	0x140b,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0,	0,	1240,	0},
+	{0x12d1,	0x1412,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0,	0,	1294,	0},
+	{0x12d1,	0x141b,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	1213,	0},
+	{0x12d1,	0x1433,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0,	0,	1314,	0},
+	{0x12d1,	0x1436,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0,	0,	1335,	0},
+	{0x12d1,	0x1444,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0,	0,	1355,	0},
+	{0x12d1,	0x144e,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	2,	0,	1377,	0},
+	{0x12d1,	0x1464,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0,	0,	1390,	0},
+	{0x12d1,	0x1465,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0,	0,	1403,	0},
+	{0x12d1,	0x1491,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0,	0,	1416,	0},
+	{0x12d1,	0x14a5,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0,	0,	1428,	0},
+	{0x12d1,	0x14a8,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0,	0,	1428,	0},
+	{0x12d1,	0x14ae,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	2,	0,	1377,	0},
+	{0x12d1,	0x14cb,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0,	0,	1440,	0},
+	{0x12d1,	0x14cf,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0,	0,	1453,	0},
+	{0x12d1,	0x1506,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0,	0,	1466,	0},
+	{0x12d1,	0x151d,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	0,	0,	1483,	0},
+	{0x12d1,	0x155e,	UsbDiscover::TYPE_NCM,		UsbDiscover::NET_GSM,	2,	2,	0,	1496,	0},
+	{0x12d1,	0x156c,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	1509,	0},
+	{0x12d1,	0x1589,	UsbDiscover::TYPE_NCM,		UsbDiscover::NET_GSM,	0,	0,	0,	1522,	0},
+	{0x12d1,	0x1c05,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0,	0,	1535,	0},
+	{0x12d1,	0x1c07,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0,	0,	1548,	0},
+	{0x12d1,	0x1c08,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	1535,	0},
+	{0x12d1,	0x1c10,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0,	0,	1428,	0},
+	{0x12d1,	0x1c12,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0,	0,	1428,	0},
+	{0x12d1,	0x1c1e,	UsbDiscover::TYPE_NCM,		UsbDiscover::NET_GSM,	0,	0,	0,	1560,	0},
+	{0x12d1,	0x1c1f,	UsbDiscover::TYPE_NCM,		UsbDiscover::NET_GSM,	0,	0,	0,	1572,	0},
+	{0x12d1,	0x1c23,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	2,	0,	1428,	0},
+	{0x1410,	0x1400,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	1584,	0},
+	{0x1410,	0x1410,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	1597,	0},
+	{0x1410,	0x1420,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	1610,	0},
+	{0x1410,	0x1430,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	1623,	0},
+	{0x1410,	0x1450,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	1637,	0},
+	{0x1410,	0x2100,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	1651,	0},
+	{0x1410,	0x2110,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	1665,	0},
+	{0x1410,	0x2120,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	1679,	0},
+	{0x1410,	0x2130,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	1692,	0},
+	{0x1410,	0x2400,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	1706,	0},
+	{0x1410,	0x2410,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	1720,	0},
+	{0x1410,	0x2420,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	1734,	0},
+	{0x1410,	0x4100,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	1749,	0},
+	{0x1410,	0x4400,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	1768,	0},
+	{0x1410,	0x6000,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	1798,	0},
+	{0x1410,	0x6001,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	1798,	0},
+	{0x1410,	0x6002,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	1813,	0},
+	{0x1410,	0x6010,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	1831,	0},
+	{0x1410,	0x7001,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	1845,	0},
+	{0x1410,	0x7003,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	1845,	0},
+	{0x1410,	0x7030,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0,	0,	1863,	0},
+	{0x1410,	0x7031,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0,	0,	1878,	0},
+	{0x1410,	0x7041,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0,	0,	1893,	0},
+	{0x1410,	0x7042,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0,	0,	1908,	0},
+	{0x1529,	0x3100,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0,	0,	1936,	0},
+	{0x16d5,	0x6202,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0,	0,	1966,	0},
+	{0x16d5,	0x6501,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	1984,	0},
+	{0x16d5,	0x6502,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0,	0,	2001,	0},
+	{0x16d5,	0x6603,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0,	0,	2018,	0},
+	{0x16d5,	0x900d,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0,	0,	2018,	0},
+	{0x16d8,	0x5141,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0,	0,	2036,	0},
+	{0x16d8,	0x5533,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0,	0,	2052,	0},
+	{0x16d8,	0x5543,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0,	0,	2052,	0},
+	{0x16d8,	0x5553,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0,	0,	2068,	0},
+	{0x16d8,	0x6002,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	2084,	0},
+	{0x16d8,	0x6006,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0,	0,	2098,	0},
+	{0x16d8,	0x6522,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0,	0,	2114,	0},
+	{0x16d8,	0x6523,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0,	0,	2130,	0},
+	{0x16d8,	0x6532,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0,	0,	2147,	0},
+	{0x16d8,	0x6533,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0,	0,	2163,	0},
+	{0x16d8,	0x6543,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0,	0,	2179,	0},
+	{0x16d8,	0x680a,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0,	0,	2195,	0},
+	{0x19d2,	0x0001,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0,	0,	2211,	0},
+	{0x19d2,	0x0015,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0,	0,	2211,	0},
+	{0x19d2,	0x0016,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	2,	0,	2228,	0},
+	{0x19d2,	0x0018,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	2,	0,	2243,	0},
+	{0x19d2,	0x0022,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	2261,	0},
+	{0x19d2,	0x0024,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0,	0,	2271,	0},
+	{0x19d2,	0x0033,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	4,	0,	2285,	0},
+	{0x19d2,	0x0037,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	2,	0,	2211,	0},
+	{0x19d2,	0x0039,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	2,	0,	2295,	0},
+	{0x19d2,	0x0057,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	2,	0,	2305,	0},
+	{0x19d2,	0x0064,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	2,	0,	2314,	0},
+	{0x19d2,	0x0066,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	3,	0,	2324,	0},
+	{0x19d2,	0x0073,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	2334,	0},
+	{0x19d2,	0x0079,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	2,	0,	2343,	0},
+	{0x19d2,	0x0082,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	2,	0,	2352,	0},
+	{0x19d2,	0x0086,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	2,	0,	2368,	0},
+	{0x19d2,	0x0091,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	3,	0,	2285,	0},
+	{0x19d2,	0x0094,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	3,	0,	0,	2378,	0},
+	{0x19d2,	0x0108,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	3,	0,	2211,	0},
+	{0x19d2,	0x0116,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	2388,	0},
+	{0x19d2,	0x0117,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	2,	0,	2398,	0},
+	{0x19d2,	0x0128,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	3,	0,	2388,	0},
+	{0x19d2,	0x0142,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0,	0,	2408,	0},
+	{0x19d2,	0x0143,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0,	0,	2419,	0},
+	{0x19d2,	0x0152,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0,	0,	2430,	0},
+	{0x19d2,	0x0170,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	1,	0,	2440,	0},
+	{0x19d2,	0x1003,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	2449,	0},
+	{0x19d2,	0x1015,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	2461,	0},
+	{0x19d2,	0x1172,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0,	0,	2473,	0},
+	{0x19d2,	0x1173,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0,	0,	2473,	0},
+	{0x19d2,	0x1177,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0,	0,	2485,	0},
+	{0x19d2,	0x1181,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0,	0,	2497,	0},
+	{0x19d2,	0x1203,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0,	0,	2509,	0},
+	{0x19d2,	0x1208,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0,	0,	2519,	0},
+	{0x19d2,	0x1211,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0,	0,	2529,	0},
+	{0x19d2,	0x1212,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0,	0,	2529,	0},
+	{0x19d2,	0x1217,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0,	0,	2519,	0},
+	{0x19d2,	0x1218,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0,	0,	2519,	0},
+	{0x19d2,	0x1220,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0,	0,	2519,	0},
+	{0x19d2,	0x1222,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0,	0,	2519,	0},
+	{0x19d2,	0x1512,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0,	0,	2539,	0},
+	{0x19d2,	0x1515,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0,	0,	2519,	0},
+	{0x19d2,	0x1518,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0,	0,	2519,	0},
+	{0x19d2,	0x1519,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0,	0,	2519,	0},
+	{0x19d2,	0x1522,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0,	0,	2549,	0},
+	{0x19d2,	0x1525,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0,	0,	2559,	0},
+	{0x19d2,	0x1527,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0,	0,	2569,	0},
+	{0x19d2,	0x1537,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0,	0,	2579,	0},
+	{0x19d2,	0x1538,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0,	0,	2579,	0},
+	{0x19d2,	0x1544,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0,	0,	2579,	0},
+	{0x19d2,	0x2003,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	3,	0,	2590,	0},
+	{0x19d2,	0xffdd,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	2600,	0},
+	{0x19d2,	0xffe4,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	2610,	0},
+	{0x19d2,	0xffe9,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	2621,	0},
+	{0x19d2,	0xfff1,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	2632,	0},
+	{0x19d2,	0xfffb,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	2644,	0},
+	{0x19d2,	0xfffc,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	2644,	0},
+	{0x19d2,	0xfffd,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	2644,	0},
+	{0x19d2,	0xfffe,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	2654,	0},
+	{0x19d2,	0xffff,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	2665,	0},
+	{0x1a8d,	0x1002,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	2676,	0},
+	{0x1a8d,	0x1003,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	2676,	0},
+	{0x1a8d,	0x1007,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0,	0,	2697,	0},
+	{0x1a8d,	0x1009,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0,	0,	2712,	0},
+	{0x1a8d,	0x100c,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0,	0,	2733,	0},
+	{0x1a8d,	0x100d,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0,	0,	2748,	0},
+	{0x1a8d,	0x2006,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	1,	0,	2763,	0},
+	{0x1bbb,	0x0000,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	2,	0,	2778,	0},
+	{0x1bbb,	0x0012,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	2,	0,	2809,	0},
+	{0x1bbb,	0x0017,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	4,	4,	0,	2823,	0},
+	{0x1bbb,	0x0052,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	4,	4,	0,	2823,	0},
+	{0x1bbb,	0x00b7,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	4,	0,	2837,	0},
+	{0x1bbb,	0x00ca,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0,	0,	2850,	0},
+	{0x1c9e,	0x6060,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0,	0,	2864,	0},
+	{0x1c9e,	0x6061,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0,	0,	2864,	0},
+	{0x1c9e,	0x9000,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	0,	0,	2884,	0},
+	{0x1c9e,	0x9603,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	2,	0,	2884,	0},
+	{0x1c9e,	0x9605,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	3,	0,	2884,	0},
+	{0x1c9e,	0x9607,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	3,	0,	2884,	0},
+	{0x1c9e,	0x9801,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	1,	0,	2908,	0},
+	{0x1c9e,	0x9900,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	2,	0,	2932,	0},
+	{0x1e0e,	0x9000,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	2,	0,	2947,	0},
+	{0x1e0e,	0x9100,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	2,	0,	2990,	0},
+	{0x1e0e,	0x9200,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	2,	0,	2947,	0},
+	{0x1e0e,	0xce16,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	3017,	0},
+	{0x1e0e,	0xcefe,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	2,	0,	3017,	0},
+	{0x1e2d,	0x0053,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	3,	0,	3054,	0},
+	{0x1e2d,	0x005b,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	3068,	0},
+	{0x2001,	0x7d00,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	3084,	0},
+	{0x2001,	0x7d01,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	3102,	0},
+	{0x2001,	0x7d02,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	3102,	0},
+	{0x2001,	0x7d03,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	3102,	0},
+	{0x201e,	0x10f8,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_CDMA,	1,	3,	0,	3120,	0},
+	{0x211f,	0x6801,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	2,	0,	0,	3132,	0},
+	{0x413c,	0x8114,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	3159,	0},
+	{0x413c,	0x8115,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	3169,	0},
+	{0x413c,	0x8116,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	3179,	0},
+	{0x413c,	0x8117,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	3159,	0},
+	{0x413c,	0x8118,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	3189,	0},
+	{0x413c,	0x8128,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	3159,	0},
+	{0x413c,	0x8129,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	3159,	0},
+	{0x413c,	0x8133,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	3199,	0},
+	{0x413c,	0x8134,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	3199,	0},
+	{0x413c,	0x8135,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	3199,	0},
+	{0x413c,	0x8136,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	3209,	0},
+	{0x413c,	0x8137,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	3209,	0},
+	{0x413c,	0x8138,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	3209,	0},
+	{0x413c,	0x8147,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	0,	1,	0,	3219,	0},
+	{0x413c,	0x8180,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	3229,	0},
+	{0x413c,	0x8181,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	3229,	0},
+	{0x413c,	0x8182,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	3229,	0},
+	{0x413c,	0x819b,	UsbDiscover::TYPE_PPP,		UsbDiscover::NET_GSM,	1,	0,	0,	3239,	0},
 };
+
+template <size_t N>
+static constexpr bool isModemListSorted(const UsbDiscover::ModemDescr (&list)[N]) {
+	for (size_t i = 1; i < N; i++) {
+		if (list[i - 1].getId() >= list[i].getId())
+			return false;
+	}
+	return true;
+}
+
+static_assert(isModemListSorted(modem_list), "modem_list must be sorted by vid:pid");
+
+const char *const UsbDiscover::m_modem_strings = modem_strings;
+const UsbDiscover::ModemDescr *const UsbDiscover::m_modem_list = modem_list;
+const size_t UsbDiscover::m_modem_list_size = sizeof(modem_list) / sizeof(modem_list[0]);
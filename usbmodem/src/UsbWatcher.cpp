@@ -0,0 +1,446 @@
+#include "UsbWatcher.h"
+
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <string_view>
+
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/eventfd.h>
+#include <linux/netlink.h>
+
+#include <Core/Uci.h>
+#include <Core/Log.h>
+#include <Core/Utils.h>
+#include <Core/UbusLoop.h>
+
+// Used from signal handler
+static int reload_fd = -1;
+
+static inline uint32_t getUsbId(uint16_t vid, uint16_t pid) {
+	return (static_cast<uint32_t>(vid) << 16) | pid;
+}
+
+UsbWatcher::UsbWatcher() {
+	m_uevent_fd.watcher = this;
+	m_reload_fd.watcher = this;
+}
+
+UsbWatcher::~UsbWatcher() {
+	closeUevent();
+	closeReload();
+}
+
+bool UsbWatcher::openUevent() {
+	m_sock = socket(AF_NETLINK, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, NETLINK_KOBJECT_UEVENT);
+	if (m_sock < 0) {
+		LOGE("socket(NETLINK_KOBJECT_UEVENT) failed: %s\n", strerror(errno));
+		return false;
+	}
+	
+	// Hub reset produces burst of events
+	int rcvbuf = UEVENT_RCVBUF;
+	if (setsockopt(m_sock, SOL_SOCKET, SO_RCVBUFFORCE, &rcvbuf, sizeof(rcvbuf)) != 0)
+		setsockopt(m_sock, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+	
+	struct sockaddr_nl addr = {};
+	addr.nl_family = AF_NETLINK;
+	addr.nl_groups = 1; // kernel events
+	
+	if (bind(m_sock, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) != 0) {
+		LOGE("bind(NETLINK_KOBJECT_UEVENT) failed: %s\n", strerror(errno));
+		closeUevent();
+		return false;
+	}
+	
+	m_uevent_fd.ufd.fd = m_sock;
+	m_uevent_fd.ufd.cb = +[](struct uloop_fd *ufd, unsigned int events) {
+		reinterpret_cast<UeventFd *>(ufd)->watcher->readUevents();
+	};
+	
+	if (uloop_fd_add(&m_uevent_fd.ufd, ULOOP_READ) < 0) {
+		LOGE("uloop_fd_add failed\n");
+		closeUevent();
+		return false;
+	}
+	
+	return true;
+}
+
+void UsbWatcher::closeUevent() {
+	if (m_sock >= 0) {
+		if (m_uevent_fd.ufd.registered)
+			uloop_fd_delete(&m_uevent_fd.ufd);
+		close(m_sock);
+		m_sock = -1;
+	}
+}
+
+bool UsbWatcher::openReload() {
+	reload_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+	if (reload_fd < 0) {
+		LOGE("eventfd() failed: %s\n", strerror(errno));
+		return false;
+	}
+	
+	m_reload_fd.ufd.fd = reload_fd;
+	m_reload_fd.ufd.cb = +[](struct uloop_fd *ufd, unsigned int events) {
+		reinterpret_cast<UeventFd *>(ufd)->watcher->reload();
+	};
+	
+	if (uloop_fd_add(&m_reload_fd.ufd, ULOOP_READ) < 0) {
+		LOGE("uloop_fd_add failed\n");
+		closeReload();
+		return false;
+	}
+	
+	// Only async-signal-safe write() here
+	std::signal(SIGHUP, +[](int sig) {
+		uint64_t value = 1;
+		int saved_errno = errno;
+		ssize_t ret = write(reload_fd, &value, sizeof(value));
+		(void) ret;
+		errno = saved_errno;
+	});
+	
+	return true;
+}
+
+void UsbWatcher::closeReload() {
+	if (reload_fd >= 0) {
+		std::signal(SIGHUP, SIG_DFL);
+		if (m_reload_fd.ufd.registered)
+			uloop_fd_delete(&m_reload_fd.ufd);
+		close(reload_fd);
+		reload_fd = -1;
+	}
+}
+
+void UsbWatcher::reload() {
+	uint64_t value;
+	while (read(reload_fd, &value, sizeof(value)) < 0 && errno == EINTR);
+	
+	LOGD("Reloading config\n");
+	loadConfig();
+	for (auto &iface: m_ifaces)
+		updateIface(iface);
+}
+
+void UsbWatcher::readUevents() {
+	char buf[8192];
+	
+	while (true) {
+		struct sockaddr_nl addr = {};
+		socklen_t addr_len = sizeof(addr);
+		
+		ssize_t len = recvfrom(m_sock, buf, sizeof(buf), 0, reinterpret_cast<struct sockaddr *>(&addr), &addr_len);
+		if (len < 0) {
+			if (errno == EINTR)
+				continue;
+			
+			// Kernel dropped some events, index is not valid anymore
+			if (errno == ENOBUFS) {
+				LOGE("uevent queue overflow, full rescan is needed\n");
+				m_need_rescan = true;
+				scheduleUpdate();
+				continue;
+			}
+			
+			if (errno != EAGAIN && errno != EWOULDBLOCK)
+				LOGE("recvfrom(NETLINK_KOBJECT_UEVENT) failed: %s\n", strerror(errno));
+			break;
+		}
+		
+		// Accept events only from kernel
+		if (addr.nl_pid != 0)
+			continue;
+		
+		Uevent event;
+		if (parseUevent(buf, len, &event))
+			handleUevent(event);
+	}
+}
+
+bool UsbWatcher::parseUevent(const char *buf, size_t len, Uevent *event) {
+	// Format: action@devpath\0KEY=VALUE\0KEY=VALUE\0...
+	size_t header_len = strnlen(buf, len);
+	if (!memchr(buf, '@', header_len))
+		return false;
+	
+	const char *end = buf + len;
+	const char *p = buf + header_len + 1;
+	while (p < end) {
+		std::string_view pair(p, strnlen(p, end - p));
+		p += pair.size() + 1;
+		
+		auto sep = pair.find('=');
+		if (sep == std::string_view::npos)
+			continue;
+		
+		auto key = pair.substr(0, sep);
+		auto value = pair.substr(sep + 1);
+		
+		if (key == "ACTION") {
+			event->action = value;
+		} else if (key == "DEVPATH") {
+			event->devpath = value;
+		} else if (key == "SUBSYSTEM") {
+			event->subsystem = value;
+		} else if (key == "DEVTYPE") {
+			event->devtype = value;
+		}
+	}
+	
+	return event->action.size() > 0 && event->devpath.size() > 0;
+}
+
+void UsbWatcher::handleUevent(const Uevent &event) {
+	if (event.subsystem == "usb" && event.devtype == "usb_device") {
+		std::string path = "/sys" + event.devpath;
+		
+		if (event.action == "remove") {
+			auto it = m_devices.find(path);
+			if (it != m_devices.end()) {
+				m_affected_ids.insert(getUsbId(it->second.vid, it->second.pid));
+				m_devices.erase(it);
+			}
+			m_dirty_devices.erase(path);
+		} else {
+			m_dirty_devices.insert(path);
+		}
+		
+		scheduleUpdate();
+	} else if (event.subsystem == "usb" || event.subsystem == "tty" || event.subsystem == "net") {
+		// Interfaces bind/unbind, tty and net nodes
+		if (event.subsystem != "usb")
+			m_check_custom = true;
+		
+		auto parent = findParentDevice("/sys" + event.devpath);
+		if (parent.size())
+			m_dirty_devices.insert(parent);
+		
+		scheduleUpdate();
+	}
+}
+
+std::string UsbWatcher::findParentDevice(const std::string &path) const {
+	std::string dir = path;
+	while (dir.size() > strlen("/sys/devices")) {
+		if (m_devices.find(dir) != m_devices.end() || m_dirty_devices.find(dir) != m_dirty_devices.end())
+			return dir;
+		
+		if (isFile(dir + "/idVendor"))
+			return dir;
+		
+		auto pos = dir.rfind('/');
+		if (pos == std::string::npos)
+			break;
+		dir.resize(pos);
+	}
+	return "";
+}
+
+void UsbWatcher::scheduleUpdate() {
+	if (m_debounce_timer != -1)
+		return;
+	
+	m_debounce_timer = UbusLoop::setTimeout([this]() {
+		m_debounce_timer = -1;
+		processUpdates();
+	}, UEVENT_DEBOUNCE);
+}
+
+void UsbWatcher::processUpdates() {
+	if (m_need_rescan) {
+		m_need_rescan = false;
+		m_check_custom = false;
+		m_dirty_devices.clear();
+		m_affected_ids.clear();
+		
+		rescan();
+		
+		for (auto &iface: m_ifaces)
+			updateIface(iface);
+		return;
+	}
+	
+	for (auto &path: m_dirty_devices) {
+		auto it = m_devices.find(path);
+		if (it != m_devices.end())
+			m_affected_ids.insert(getUsbId(it->second.vid, it->second.pid));
+		
+		if (indexDevice(path)) {
+			auto &indexed = m_devices[path];
+			m_affected_ids.insert(getUsbId(indexed.vid, indexed.pid));
+		} else {
+			m_devices.erase(path);
+		}
+	}
+	
+	for (auto &iface: m_ifaces) {
+		bool affected = iface.is_usb ?
+			m_affected_ids.find(getUsbId(iface.url.vid, iface.url.pid)) != m_affected_ids.end() :
+			m_check_custom;
+		
+		if (affected)
+			updateIface(iface);
+	}
+	
+	m_dirty_devices.clear();
+	m_affected_ids.clear();
+	m_check_custom = false;
+}
+
+bool UsbWatcher::indexDevice(const std::string &path) {
+	if (!isFile(path + "/idVendor") || !isFile(path + "/idProduct"))
+		return false;
+	
+	IndexedDev indexed;
+	indexed.vid = strToInt(trim(tryReadFile(path + "/idVendor")), 16);
+	indexed.pid = strToInt(trim(tryReadFile(path + "/idProduct")), 16);
+	indexed.serial = trim(tryReadFile(path + "/serial"));
+	
+	auto [net_list, tty_list] = UsbDiscover::getUsbDevInterfaces(path);
+	indexed.dev = {path, net_list, tty_list};
+	
+	m_devices[path] = indexed;
+	
+	return true;
+}
+
+void UsbWatcher::rescan() {
+	m_devices.clear();
+	for (auto &path: readDir("/sys/bus/usb/devices"))
+		indexDevice(getRealPath(path));
+}
+
+void UsbWatcher::loadConfig() {
+	m_ifaces.clear();
+	
+	for (auto &section: Uci::loadSections("network", "interface")) {
+		if (getMapValue(section.options, "proto", "") != "usbmodem")
+			continue;
+		
+		IfaceConfig iface;
+		iface.name = section.name;
+		iface.type = UsbDiscover::getModemTypeFromString(getMapValue(section.options, "modem_type", ""));
+		iface.control_device = getMapValue(section.options, "control_device", "");
+		iface.ppp_device = getMapValue(section.options, "ppp_device", "");
+		iface.net_device = getMapValue(section.options, "net_device", "");
+		
+		auto device = getMapValue(section.options, "device", "");
+		if (device != "" && device != "tty" && device != "custom") {
+			auto [valid, url] = UsbDiscover::parseUsbUrl(device);
+			if (!valid)
+				iface.type = UsbDiscover::TYPE_UNKNOWN;
+			
+			iface.is_usb = true;
+			iface.url = url;
+		}
+		
+		m_ifaces.push_back(iface);
+	}
+}
+
+bool UsbWatcher::checkIface(const IfaceConfig &iface) const {
+	if (iface.type == UsbDiscover::TYPE_UNKNOWN)
+		return false;
+	
+	std::string control_tty, ppp_tty, net_dev;
+	
+	if (iface.is_usb) {
+		// Same as UsbDiscover::findDevice, but using index
+		const UsbDiscover::Dev *found = nullptr;
+		for (auto &it: m_devices) {
+			auto &indexed = it.second;
+			
+			if (indexed.vid != iface.url.vid || indexed.pid != iface.url.pid)
+				continue;
+			
+			if (hasMapKey(iface.url.params, "serial") && iface.url.params.at("serial") != indexed.serial)
+				continue;
+			
+			if (UsbDiscover::isDeviceUsed(indexed.dev, iface.name))
+				continue;
+			
+			found = &indexed.dev;
+			break;
+		}
+		
+		if (!found)
+			return false;
+		
+		control_tty = UsbDiscover::getFromDevice(*found, iface.control_device);
+		ppp_tty = UsbDiscover::getFromDevice(*found, iface.ppp_device);
+		net_dev = UsbDiscover::getFromDevice(*found, iface.net_device);
+	} else {
+		control_tty = iface.control_device;
+		ppp_tty = iface.ppp_device;
+		net_dev = iface.net_device;
+	}
+	
+	if (UsbDiscover::hasControlDev(iface.type) && (!control_tty.size() || !isFileExists(control_tty)))
+		return false;
+	
+	if (UsbDiscover::hasPppDev(iface.type) && (!ppp_tty.size() || !isFileExists(ppp_tty)))
+		return false;
+	
+	if (UsbDiscover::hasNetDev(iface.type) && (!net_dev.size() || !isFileExists("/sys/class/net/" + net_dev)))
+		return false;
+	
+	return true;
+}
+
+void UsbWatcher::updateIface(IfaceConfig &iface) {
+	int avail = checkIface(iface) ? 1 : 0;
+	if (iface.avail == avail)
+		return;
+	
+	iface.avail = avail;
+	LOGD("-> %s: %s\n", iface.name.c_str(), avail ? "Available" : "Not available");
+	m_netifd.protoSetAvail(iface.name, avail != 0);
+}
+
+int UsbWatcher::start() {
+	UbusLoop::instance()->init();
+	
+	if (!m_ubus.open()) {
+		LOGE("Can't init ubus...\n");
+		return 1;
+	}
+	
+	m_netifd.setUbus(&m_ubus);
+	
+	// Subscribe before initial scan, so no events are lost
+	if (!openUevent())
+		return 1;
+	
+	auto handler = [](int sig) {
+		LOGD("Received signal: %d\n", sig);
+		UbusLoop::instance()->stop();
+	};
+	setSignalHandler(SIGINT, handler);
+	setSignalHandler(SIGTERM, handler);
+	
+	// Reload config
+	if (!openReload())
+		return 1;
+	
+	loadConfig();
+	rescan();
+	
+	for (auto &iface: m_ifaces)
+		updateIface(iface);
+	
+	UbusLoop::instance()->run();
+	
+	closeUevent();
+	
+	return 0;
+}
+
+int UsbWatcher::run(const std::string &type, int argc, char *argv[]) {
+	UsbWatcher watcher;
+	return watcher.start();
+}
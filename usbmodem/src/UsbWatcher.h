@@ -0,0 +1,103 @@
+#pragma once
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include <libubox/uloop.h>
+};
+
+#include <Core/Ubus.h>
+#include <Core/Netifd.h>
+
+#include "UsbDiscover.h"
+
+/*
+ * Resident hotplug service
+ * Listens kernel uevents and keeps index of plugged USB devices,
+ * so on hotplug only affected interfaces are rechecked.
+ * */
+class UsbWatcher {
+	public:
+		struct Uevent {
+			std::string action;
+			std::string devpath;
+			std::string subsystem;
+			std::string devtype;
+		};
+		
+		struct IndexedDev {
+			uint16_t vid = 0;
+			uint16_t pid = 0;
+			std::string serial;
+			UsbDiscover::Dev dev;
+		};
+		
+		struct IfaceConfig {
+			std::string name;
+			UsbDiscover::ModemType type = UsbDiscover::TYPE_UNKNOWN;
+			bool is_usb = false;
+			UsbDiscover::DevUrl url;
+			std::string control_device;
+			std::string ppp_device;
+			std::string net_device;
+			int avail = -1;
+		};
+		
+		static constexpr int UEVENT_DEBOUNCE = 300;
+		static constexpr int UEVENT_RCVBUF = 1024 * 1024;
+	protected:
+		Ubus m_ubus;
+		Netifd m_netifd;
+		
+		struct UeventFd {
+			uloop_fd ufd = {};
+			UsbWatcher *watcher = nullptr;
+		};
+		
+		int m_sock = -1;
+		UeventFd m_uevent_fd = {};
+		
+		// SIGHUP handler only writes to eventfd, config is reloaded on the loop
+		UeventFd m_reload_fd = {};
+		
+		// Key is sysfs path of usb_device
+		std::map<std::string, IndexedDev> m_devices;
+		std::vector<IfaceConfig> m_ifaces;
+		
+		// Pending changes, processed after UEVENT_DEBOUNCE
+		std::set<std::string> m_dirty_devices;
+		std::set<uint32_t> m_affected_ids;
+		bool m_check_custom = false;
+		bool m_need_rescan = false;
+		int64_t m_debounce_timer = -1;
+		
+		bool openUevent();
+		void closeUevent();
+		void readUevents();
+		static bool parseUevent(const char *buf, size_t len, Uevent *event);
+		void handleUevent(const Uevent &event);
+		bool openReload();
+		void closeReload();
+		void reload();
+		void scheduleUpdate();
+		void processUpdates();
+		
+		void loadConfig();
+		void rescan();
+		bool indexDevice(const std::string &path);
+		std::string findParentDevice(const std::string &path) const;
+		
+		bool checkIface(const IfaceConfig &iface) const;
+		void updateIface(IfaceConfig &iface);
+	
+	public:
+		UsbWatcher();
+		~UsbWatcher();
+		
+		int start();
+		
+		static int run(const std::string &type, int argc, char *argv[]);
+};
@@ -19,6 +19,7 @@
 #include "Modem/Asr1802.h"
 #include "ModemService.h"
 #include "UsbDiscover.h"
+#include "UsbWatcher.h"
 
 static int test(int argc, char *argv[]) {
 	LOGD("test??? %s\n", urldecode("xuj%3F%3F%3Fpizda+jgurda").c_str());
@@ -30,18 +31,27 @@ int main(int argc, char *argv[]) {
 		if (strcmp(argv[1], "discover") == 0 || strcmp(argv[1], "discover-json") == 0)
 			return UsbDiscover::run(argv[1], argc - 2, argv + 2);
 		
-		if (strcmp(argv[1], "daemon") == 0 || strcmp(argv[1], "check") == 0)
+		if (strcmp(argv[1], "daemon") == 0 || strcmp(argv[1], "multi") == 0 || strcmp(argv[1], "check") == 0)
 			return ModemService::run(argv[1], argc - 2, argv + 2);
 		
+		if (strcmp(argv[1], "hotplug") == 0)
+			return UsbWatcher::run(argv[1], argc - 2, argv + 2);
+		
+		if (strcmp(argv[1], "at-trace") == 0 && argc == 3)
+			return Log::printTrace(argv[2]);
+		
 		if (strcmp(argv[1], "test") == 0)
 			return test(argc - 2, argv + 2);
 	}
 	
 	fprintf(stderr, "usage: usbmodem <action>\n");
 	fprintf(stderr, "  usbmodem daemon <iface>    - start modem daemon\n");
+	fprintf(stderr, "  usbmodem multi [iface...]  - start one daemon for many interfaces\n");
 	fprintf(stderr, "  usbmodem discover          - show available modems\n");
 	fprintf(stderr, "  usbmodem discover-json     - show available modems (json)\n");
 	fprintf(stderr, "  usbmodem check             - recheck available interfaces\n");
+	fprintf(stderr, "  usbmodem hotplug           - watch usb hotplug and update available interfaces\n");
+	fprintf(stderr, "  usbmodem at-trace <file>   - print AT trace file\n");
 	
 	return -1;
 }